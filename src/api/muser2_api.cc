@@ -48,6 +48,14 @@ void muser2::set_cpu_time_limit(double limit)
   _pimpl->set_cpu_time_limit(limit);
 }
 
+/** Sets wall-clock time limit for test_sat() and compute_gmus() (seconds,
+ * 0 = no limit).
+ */
+void muser2::set_wc_time_limit(double limit)
+{
+  _pimpl->set_wc_time_limit(limit);
+}
+
 /** Sets the limit on the number of iteration, where an "iteration" is
  * typically an iteration of the main loop of the algo. (0 = no limit).
  */
@@ -85,12 +93,21 @@ muser2::gid muser2::add_clause(const muser2::lit* first,
   return (muser2::gid)_pimpl->add_clause(first, last, gid);
 }
 
+/** Loads the group-set from a binary file. Forwards to muser2_impl. */
+bool muser2::load_groupset(const char* fname) { return _pimpl->load_groupset(fname); }
+
+/** Saves the group-set into a binary file. Forwards to muser2_impl. */
+bool muser2::save_groupset(const char* fname) { return _pimpl->save_groupset(fname); }
+
 /** Tests the current group-set for satisfiability. */
 int muser2::test_sat(void) { return _pimpl->test_sat(); }
 
 /** Compute a group-MUS of the current group-set. Forwards to muser2_impl. */
 int muser2::compute_gmus(void) { return _pimpl->compute_gmus(); }
 
+/** Stops test_sat() or compute_gmus() running in another thread. */
+void muser2::interrupt(void) { _pimpl->interrupt(); }
+
 /** Returns a reference to the vector of group-IDs included in the group MUS */
 const vector<muser2::gid>& muser2::gmus_gids(void) const { return _pimpl->gmus_gids(); }
 
@@ -158,6 +175,13 @@ void muser2_set_cpu_time_limit(muser2_t h, double limit)
   pm(h)->set_cpu_time_limit(limit);
 }
 
+/** Sets wall-clock time limit for test_sat/compute_gmus (seconds, 0 = no
+ * limit). */
+void muser2_set_wc_time_limit(muser2_t h, double limit)
+{
+  pm(h)->set_wc_time_limit(limit);
+}
+
 /** Sets the limit on the number of iteration, where an "iteration" is
  * typically an iteration of the main loop of the algo. (0 = no limit).
  */
@@ -198,6 +222,18 @@ muser2_gid muser2_add_clause(muser2_t h, muser2_lit* first, muser2_lit* last, mu
   }
 }
 
+/** Loads the group-set from a binary file. */
+int muser2_load_groupset(muser2_t h, const char* fname)
+{
+  try { return pm(h)->load_groupset(fname) ? 0 : -1; } catch (...) { return -1; }
+}
+
+/** Saves the group-set into a binary file. */
+int muser2_save_groupset(muser2_t h, const char* fname)
+{
+  try { return pm(h)->save_groupset(fname) ? 0 : -1; } catch (...) { return -1; }
+}
+
 /** Tests the current group-set for satisfiability. */
 int muser2_test_sat(muser2_t h)
 {
@@ -210,6 +246,12 @@ int muser2_compute_gmus(muser2_t h)
   try { return pm(h)->compute_gmus(); } catch (...) { return -1; }
 }
 
+/** Stops test_sat/compute_gmus running in another thread. */
+void muser2_interrupt(muser2_t h)
+{
+  pm(h)->interrupt();
+}
+
 
 /** Returns pointers to the first and the last elements of the array that contains 
  * the the group-IDs included in the group MUS previously computed by 
@@ -70,6 +70,11 @@ extern "C" {
    */
   void muser2_set_cpu_time_limit(muser2_t h, double limit);
 
+  /** Sets wall-clock time limit for muser2_test_sat() and
+   * muser2_compute_gmus() (seconds, 0 = no limit).
+   */
+  void muser2_set_wc_time_limit(muser2_t h, double limit);
+
   /** Sets the limit on the number of iteration, where an "iteration" is
    * typically an iteration of the main loop of the algo. (0 = no limit).
    */
@@ -109,6 +114,20 @@ extern "C" {
    */
   muser2_gid muser2_add_clause(muser2_t h, muser2_lit* first, muser2_lit* last, muser2_gid gid);
 
+  /** Loads the group-set from a binary file written by muser2_save_groupset() 
+   * (or by muser2 -wbin); must be called on an empty group-set, i.e. right 
+   * after muser2_init_all().
+   *
+   * @return 0 on success, -1 on error (e.g. invalid file)
+   */
+  int muser2_load_groupset(muser2_t h, const char* fname);
+
+  /** Saves the current group-set into a file in the binary format.
+   *
+   * @return 0 on success, -1 on error
+   */
+  int muser2_save_groupset(muser2_t h, const char* fname);
+
   // Functionality
 
   /** Tests the current group-set for satisfiability.
@@ -123,6 +142,12 @@ extern "C" {
    */
   int muser2_compute_gmus(muser2_t h);
 
+  /** Asks muser2_test_sat() or muser2_compute_gmus() running in another
+   * thread to stop as soon as it can; they then return as if out of time.
+   * The request stays in effect until the next muser2_init_run().
+   */
+  void muser2_interrupt(muser2_t h);
+
   /** Returns pointers to the first and the last elements of the array that
    * contains the the group-IDs included in the group MUS previously computed 
    * by muser2_compute_gmus(). first and/or last may be given NULL, in which
@@ -60,6 +60,11 @@ public:         // Configuration
    */
   void set_cpu_time_limit(double limit);
 
+  /** Sets wall-clock time limit for test_sat() and compute_gmus() (seconds,
+   * 0 = no limit); the SAT calls in flight are stopped when it runs out.
+   */
+  void set_wc_time_limit(double limit);
+
   /** Sets the limit on the number of iteration, where an "iteration" is
    * typically an iteration of the main loop of the algo. (0 = no limit).
    */
@@ -99,6 +104,22 @@ public:         // Addition of clauses and groups
    */
   gid add_clause(const lit* first, const lit* last, gid gid);
 
+  /** Loads the group-set from a binary file written by save_groupset() (or
+   * by muser2 -wbin). The file is mapped into memory and used in place, so
+   * this is much faster than adding the clauses one by one. The group-set 
+   * must be empty, i.e. this should be called right after init_all().
+   *
+   * @return true on success, false if the file is not a valid binary 
+   * group-set.
+   */
+  bool load_groupset(const char* fname);
+
+  /** Saves the current group-set into a file in the binary format.
+   *
+   * @return true on success.
+   */
+  bool save_groupset(const char* fname);
+
   // TODO: add "normal" C++ versions of add_clause()
 
 public:         // Functionality
@@ -121,6 +142,13 @@ public:         // Functionality
    */
   const std::vector<gid>& gmus_gids(void) const;
 
+  /** Asks test_sat() or compute_gmus() running in another thread to stop as
+   * soon as it can (including the SAT call in flight); they then return as
+   * if out of time. The request stays in effect until the next init_run().
+   * No signals are involved.
+   */
+  void interrupt(void);
+
 private:
 
   class muser2_impl;
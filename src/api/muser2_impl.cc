@@ -11,6 +11,7 @@
 \*----------------------------------------------------------------------------*/
 
 #include "muser2_impl.hh"
+#include <fstream>
 #include <iterator>
 
 using namespace std;
@@ -75,6 +76,7 @@ void muser2::muser2_impl::init_run(void)
   _imgr.reg_ids(_pgset->max_var()); // FIXME: this will break in incremental mode !
   _gmus_gids.clear();
   _init_gsize = _pgset->gsize() - _pgset->has_g0();
+  config.stop().clear();
 }
 
 /** Clears up all data-structures used for the run */
@@ -90,6 +92,7 @@ void muser2::muser2_impl::reset_run(void)
 unsigned muser2::muser2_impl::test_sat(void)
 {
   DBG(cout << "= muser2::test_sat, checking for satisfiability ..." << endl;);
+  config.stop().set_deadline(_wc_limit);
   SATChecker schecker(_imgr, config);
   CheckUnsat cu(*_pmd);
   if (schecker.process(cu) && cu.completed())
@@ -103,6 +106,7 @@ unsigned muser2::muser2_impl::test_sat(void)
 int muser2::muser2_impl::compute_gmus(void)
 {
   DBG(cout << "= muser2::compute_gmus, computing ..." << endl;);
+  config.stop().set_deadline(_wc_limit);
   MUSExtractor mex(_imgr, config);
   mex.set_cpu_time_limit(_cpu_limit);
   mex.set_iter_limit(_iter_limit);
@@ -111,7 +115,7 @@ int muser2::muser2_impl::compute_gmus(void)
     for_each(_pgset->gbegin(), _pgset->gend(), [&](GID gid) {
         if (gid && !_pmd->r(gid)) { _gmus_gids.push_back(gid); }
       });
-    bool approx = (_pmd->nec_gids().size() - _pmd->nec(0)) != _gmus_gids.size();
+    bool approx = (_pmd->num_necessary() - _pmd->nec(0)) != _gmus_gids.size();
     if (_verb >= 1) {
       cout_pref << "muser2 finished in " << mex.cpu_time() << " sec."
                 << " init_size: " << _init_gsize
@@ -154,4 +158,21 @@ muser2::gid muser2::muser2_impl::add_clause(const int* first, const int* last, m
   return (muser2::gid)cl->get_grp_id();
 }
 
+/** Loads the group-set from a binary file
+ */
+bool muser2::muser2_impl::load_groupset(const char* fname)
+{
+  DBG(cout << "= muser2::load_groupset: " << fname << endl;);
+  return _pgset->load_binary(fname);
+}
+
+/** Saves the group-set into a binary file
+ */
+bool muser2::muser2_impl::save_groupset(const char* fname)
+{
+  DBG(cout << "= muser2::save_groupset: " << fname << endl;);
+  ofstream out(fname, ios::binary);
+  return out && _pgset->write_binary(out);
+}
+
 /*----------------------------------------------------------------------------*/
@@ -65,6 +65,11 @@ public:         // Functionality
    * computed MUS. The content is valid until the next init_run() call.
    */
   std::vector<gid>& gmus_gids(void) { return _gmus_gids; }
+
+  /** Asks test_sat() or compute_gmus() running in another thread to stop;
+   * stays in effect until the next init_run().
+   */
+  void interrupt(void) { config.stop().raise(); }
   
 public:         // Configuration
 
@@ -80,6 +85,11 @@ public:         // Configuration
    */
   void set_cpu_time_limit(double limit) { _cpu_limit = limit; }
 
+  /** Sets wall-clock time limit for test_sat() and compute_gmus() (seconds,
+   * 0 = no limit).
+   */
+  void set_wc_time_limit(double limit) { _wc_limit = limit; }
+
   /** Sets the limit on the number of iteration, where an "iteration" is
    * typically an iteration of the main loop of the algo. (0 = no limit).
    */
@@ -115,6 +125,22 @@ public:         // Addition of clauses and groups
    */
   gid add_clause(const int* first, const int* last, gid gid);
 
+  /** Loads the group-set from a binary file written by save_groupset() (or
+   * by muser2 -wbin). The file is mapped into memory and used in place, so
+   * this is much faster than adding the clauses one by one. The group-set 
+   * must be empty, i.e. this should be called right after init_all().
+   *
+   * @return true on success, false if the file is not a valid binary 
+   * group-set.
+   */
+  bool load_groupset(const char* fname);
+
+  /** Saves the current group-set into a file in the binary format.
+   *
+   * @return true on success.
+   */
+  bool save_groupset(const char* fname);
+
 private:        // Main datastructures ...
 
   ToolConfig config;                    // configuration data
@@ -137,6 +163,8 @@ private:        // Configuration
 
   double _cpu_limit = 0;                // CPU time limit (soft) for extraction
 
+  double _wc_limit = 0;                 // wall-clock time limit for a call
+
   unsigned _iter_limit = 0;             // iteration limit
 
   unsigned _order = 0;                  // minimization order
@@ -30,12 +30,21 @@
 //jpms:ec
 
 typedef vector<LINT> LitVector;
-typedef vector<LINT>::iterator Literator;
-typedef vector<LINT>::reverse_iterator RLiterator;
-typedef vector<LINT>::const_iterator CLiterator;
+typedef LINT* Literator;
+typedef std::reverse_iterator<LINT*> RLiterator;
+typedef const LINT* CLiterator;
 typedef ULINT GID;      // group id
 const GID gid_Undef = (GID)-1L;
 
+// A read-only view of a sequence of literals (e.g. the literals of a
+// clause); used as a key when looking up clauses by their literals.
+struct LitSpan {
+  const LINT* lits;
+  ULINT size;
+  LitSpan(const LINT* l, ULINT sz) : lits(l), size(sz) {}
+  LitSpan(const vector<LINT>& lv) : lits(lv.data()), size(lv.size()) {}
+};
+
 //jpms:bc
 /*----------------------------------------------------------------------------*\
  * Class: BasicClause
@@ -48,44 +57,64 @@ class BasicClause {
   friend class ClauseRegistry;
   friend class BasicClauseSet;
   friend class BasicGroupSet;
+  friend class ClauseArena;
 protected:
 
   BasicClause(const vector<LINT>& lits) 
-    : clits(lits), weight(0), id(ClauseIdManager::Instance()->new_id()), 
-      grp_id(gid_Undef)
-    , _aend(clits.end()), _asize(clits.size()), _abstr(calculate_abstr())
+    : clits(lits.empty() ? NULL : new LINT[lits.size()]), nlits(lits.size()),
+      weight(0), id(ClauseIdManager::Instance()->new_id()), grp_id(gid_Undef)
+    , _aend(clits + nlits), _asize(nlits)
   {
     assert(adjacent_find(lits.begin(),lits.end(),AbsLitGreater())==lits.end());
+    copy(lits.begin(), lits.end(), clits);
+    _abstr = calculate_abstr();
     //sort_lits();
     NDBG(cout << "Creating clause: [" << *this << "]" << endl;);
   }
 
-  virtual ~BasicClause(void) { clits.clear(); }
+  // the literals live in external storage (e.g. a LitPool) that
+  // outlives the clause; they are expected to be sorted and duplicate-free.
+  BasicClause(LINT* lits, ULINT size) 
+    : clits(lits), nlits(size), weight(0), 
+      id(ClauseIdManager::Instance()->new_id()), grp_id(gid_Undef)
+    , _aend(clits + nlits), _asize(nlits), _abstr(calculate_abstr())
+  {
+    assert(adjacent_find(clits, clits + nlits, AbsLitGreater()) == clits + nlits);
+    _flags.ext_lits = 1;
+  }
+
+  virtual ~BasicClause(void) { release_lits(); }
 
 public:
 
-  ULINT size() const { return clits.size(); }
+  ULINT size() const { return nlits; }
 
-  Literator begin() { return clits.begin(); }
-  CLiterator begin() const { return clits.begin(); }
+  Literator begin() { return clits; }
+  CLiterator begin() const { return clits; }
 
-  Literator end() { return clits.end(); }
-  CLiterator end() const { return clits.end(); }
+  Literator end() { return clits + nlits; }
+  CLiterator end() const { return clits + nlits; }
 
-  const vector<LINT>& cl_lits() const { return clits; }
+  LitSpan cl_lits() const { return LitSpan(clits, nlits); }
 
   ULINT get_min_lit() { return size() ? abs(clits[0]) : 0; }
 
-  ULINT get_max_lit() { return size() ? abs(clits[clits.size()-1]) : 0; }
+  ULINT get_max_lit() { return size() ? abs(clits[nlits-1]) : 0; }
 
-  bool is_tautology(void) { return adjacent_find(clits.begin(), clits.end(), LitNegated()) != clits.end(); }
+  bool is_tautology(void) { return adjacent_find(begin(), end(), LitNegated()) != end(); }
 
 protected:
 
   void add_lit(LINT lit) {
-    clits.push_back(lit);    // Currently sorts; it is simpler to insert & shift
-    assert(clits.size() > 0);
-    if (abs(lit) < abs(clits[clits.size()-1])) {
+    LINT* nclits = new LINT[nlits + 1];    // Currently sorts; it is simpler to insert & shift
+    copy(begin(), end(), nclits);
+    nclits[nlits] = lit;
+    release_lits();
+    clits = nclits;
+    _flags.ext_lits = 0;
+    ++nlits;
+    restore();
+    if (nlits > 1 && abs(lit) < abs(clits[nlits-2])) {
       sort_lits();    // alternatively: 
       /*  => Seems to be less efficient
 	  Literator pos2 = clits.end();
@@ -102,15 +131,34 @@ protected:
   }
 
   void del_lit(LINT lit) {
-    for (Literator pos = clits.begin(); pos != clits.end(); ++pos) {
-      if (*pos == lit) { *pos = clits.back(); break; }
+    own_lits();
+    for (Literator pos = begin(); pos != end(); ++pos) {
+      if (*pos == lit) { *pos = clits[nlits-1]; break; }
     }
-    clits.pop_back();    // Currently sorts; it is simpler to insert & shift
+    --nlits;    // Currently sorts; it is simpler to insert & shift
+    restore();
     //sort_lits();  // alternatively: 
     //update_internal_data((unsigned)lit);   // hash XOR removes bits due to lit
   }
 
-  vector<LINT>& cl_lits() { return clits; }
+  /* Moves the literals into external storage 'nlits_mem' (at least size() 
+   * literals long), which then has to outlive the clause. */
+  void relocate_lits(LINT* nlits_mem) {
+    ULINT aoffs = _aend - clits;
+    copy(begin(), end(), nlits_mem);
+    release_lits();
+    clits = nlits_mem;
+    _aend = clits + aoffs;
+    _flags.ext_lits = 1;
+  }
+
+  /* Frees the literals, if they are owned by the clause */
+  void release_lits(void) {
+    if (!_flags.ext_lits)
+      delete[] clits;
+    clits = NULL;
+    _flags.ro_lits = 0;
+  }
 
   //ULINT clhash() { return hashval; }
 
@@ -151,8 +199,8 @@ public:    // Output functions
   }
 
   friend ostream & operator << (ostream& outs, const BasicClause& cl) {
-    CLiterator lpos = cl.clits.begin();
-    CLiterator lend = cl.clits.end();
+    CLiterator lpos = cl.begin();
+    CLiterator lend = cl.end();
     for (; lpos != lend; ++lpos) {
       outs << *lpos << " ";
     }
@@ -163,11 +211,12 @@ public:    // Output functions
 protected:
 
   void sort_lits() {
+    own_lits();
     //cout << "Lits A: ";
     //copy(clits.begin(), clits.end(), ostream_iterator<int>(cout, " "));
     //cout << endl;
     //if (!is_sorted(clits.begin(), clits.end(), AbsLitLess())) { }
-    sort(clits.begin(), clits.end(), AbsLitLess());
+    sort(begin(), end(), AbsLitLess());
     //cout << "Lits B: ";
     //copy(clits.begin(), clits.end(), ostream_iterator<int>(cout, " "));
     //cout << endl;
@@ -176,7 +225,7 @@ protected:
   ULINT compute_hash() {    // Not being used: see below new hash functions
     exit(0);
     register ULINT hashv = 0;
-    for(vector<LINT>::iterator pos = clits.begin(); pos != clits.end(); ++pos) {
+    for(Literator pos = begin(); pos != end(); ++pos) {
       hashv ^= (*pos>0) ? *pos : -*pos;
     }
     return hashv;
@@ -186,7 +235,9 @@ protected:
 
 protected:
 
-  vector<LINT> clits;
+  LINT* clits;   // owned, unless _flags.ext_lits is set
+
+  ULINT nlits;
 
   //ULINT hashval;
 
@@ -213,26 +264,47 @@ public:
   bool unsorted(void) const { return _flags.unsorted; }
   // sorts active literals and marks the clause not un-sorted
   void sort_alits(void) { 
-    sort(clits.begin(), _aend, AbsLitLess()); 
+    own_lits();
+    sort(clits, _aend, AbsLitLess()); 
     _flags.unsorted = 0;
   }
 
+  /** Read-only literals: the external literals of the clause might be in a
+   * read-only mapping of a file; own_lits() copies them into the clause, and
+   * must be called before changing the literals in place */
+  void mark_ro_lits(void) { assert(_flags.ext_lits); _flags.ro_lits = 1; }
+  bool ro_lits(void) const { return _flags.ro_lits; }
+  void own_lits(void) {
+    if (_flags.ro_lits) {
+      ULINT aoffs = _aend - clits;
+      LINT* nclits = new LINT[nlits];
+      copy(begin(), end(), nclits);
+      clits = nclits;
+      _aend = clits + aoffs;
+      _flags.ext_lits = 0;
+      _flags.ro_lits = 0;
+    }
+  }
+
+  /** True if the clause object is owned by a ClauseArena */
+  bool pooled(void) const { return _flags.pooled; }
+
   /** Iterators over active literals -- i.e. those that are non-false.
    */
   ULINT asize(void) const { return _asize; }
-  Literator abegin(void) { return clits.begin(); }
-  CLiterator abegin(void) const { return clits.begin(); }
+  Literator abegin(void) { return clits; }
+  CLiterator abegin(void) const { return clits; }
   Literator aend(void) { return _aend; }
   CLiterator aend(void) const { return _aend; }
 
   /** Direct access to literals */
-  vector<LINT>& lits(void) { return clits; }
+  LINT* lits(void) { return clits; }
 
   /** Shrinks active size by 1 */
   void shrink(void) { _asize--; _aend--; update_abstr(); }
 
   /** Restores active size to the original size */
-  void restore(void) { _asize = size(); _aend = clits.end(); update_abstr(); }
+  void restore(void) { _asize = size(); _aend = end(); update_abstr(); }
 
   /** Returns iterator to a literal of variable v in the active part
    * or the clause, or aend() if not found. 
@@ -315,17 +387,20 @@ protected:
   struct flags {
     unsigned removed   : 1;     // 1 when the clause is removed
     unsigned unsorted  : 1;     // 1 when the clause might be un-sorted
-    unsigned unused    : 30; 
-    flags(void) { removed = 0; unsorted = 0; }
+    unsigned ext_lits  : 1;     // 1 when the literals are not owned by the clause
+    unsigned pooled    : 1;     // 1 when the clause lives in a ClauseArena
+    unsigned ro_lits   : 1;     // 1 when the (external) literals are read-only
+    unsigned unused    : 27; 
+    flags(void) { removed = 0; unsorted = 0; ext_lits = 0; pooled = 0; ro_lits = 0; }
   } _flags;
   
   // all falsified literals will be moved to the end of the clause; note that
   // since all literals are sorted, the remaining literals will also be sorted;
   // thus, all we need to do is to keep track of the "real" end of the clause.
 
-  Literator _aend;       // initially lits.end()
+  Literator _aend;       // initially end()
   
-  size_t _asize;         // initially lits.size()
+  size_t _asize;         // initially size()
 
   ULINT _abstr;          // abstraction
 
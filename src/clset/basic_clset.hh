@@ -64,6 +64,9 @@ public:
     clvect.clear();
   }
 
+  /* Buffer for the literals of a clause being parsed (see parsers) */
+  struct LitBuffer : public vector<LINT> { LitBuffer(BasicClauseSet&) {} };
+
   BasicClause* create_clause(LINT nlits, const LINT lits[]) {
     BasicClause* ncl = clreg.create_clause(nlits, lits);
     return insert_clause(ncl);
@@ -190,7 +193,7 @@ public:
 
   XLINT get_num_grp() { return top_weight; }
 
-  vector<LINT>& get_cl_lits(BasicClause* cl) { return cl->cl_lits(); }
+  LitSpan get_cl_lits(BasicClause* cl) { return cl->cl_lits(); }
 
   void cl_lits(BasicClause* cl, IntVector& lvect) {
     Literator lpos = cl->begin(); Literator lend = cl->end();
@@ -0,0 +1,221 @@
+/*----------------------------------------------------------------------------*\
+ * File:        cl_arena.hh
+ *
+ * Description: Arena storage for clauses: LitPool hands out contiguous blocks
+ *              of literals, ClauseArena hands out BasicClause objects; both
+ *              allocate in large chunks and release everything at once.
+ *
+ * Author:      agent
+ *
+ * Notes:
+ *      1. IMPORTANT: this implementation is NOT multi-thread safe.
+ *      2. Nothing is freed individually -- the storage lives as long as the
+ *         arena itself (typically, as long as the owning BasicGroupSet).
+ *      3. The chunk sizes grow geometrically, so that small group-sets (e.g.
+ *         the temporary ones created during refinement) stay small.
+ *
+ *                                                    Copyright (c) 2026, agent
+\*----------------------------------------------------------------------------*/
+
+#ifndef _CL_ARENA_HH
+#define _CL_ARENA_HH
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+#include <sys/mman.h>
+#include "basic_clause.hh"
+
+/*----------------------------------------------------------------------------*\
+ * Class:  LitPool
+ *
+ * Purpose: A bump-pointer allocator of literal blocks.
+\*----------------------------------------------------------------------------*/
+
+class LitPool {
+
+public:
+
+  LitPool(void) {}
+
+  ~LitPool(void) { _unmap(); }
+
+  /* Returns a block of n consecutive literals */
+  LINT* alloc(ULINT n) {
+    assert(_npend == 0);
+    if (_left < n)
+      _grow(n);
+    LINT* res = _next;
+    _next += n;
+    _left -= n;
+    _used += n;
+    return res;
+  }
+
+  // Pending block: literals can be appended one at a time (e.g. by a parser)
+  // and then either committed into a block, or discarded. The pending block
+  // may move as it grows, so pending() is only valid until the next append.
+
+  /* Appends a literal to the pending block */
+  void append(LINT lit) {
+    if (_npend == _left)
+      _grow(2 * _npend + 1);
+    _next[_npend++] = lit;
+  }
+
+  /* The pending literals */
+  LINT* pending(void) { return _next; }
+
+  /* Number of pending literals */
+  ULINT npending(void) const { return _npend; }
+
+  /* Drops all pending literals beyond the first n */
+  void shrink_pending(ULINT n) { assert(n <= _npend); _npend = n; }
+
+  /* Turns the pending literals into a block, and returns it */
+  LINT* commit(void) {
+    ULINT n = _npend;
+    _npend = 0;
+    return alloc(n);
+  }
+
+  /* Drops the pending literals */
+  void discard(void) { _npend = 0; }
+
+  /* Takes over a memory-mapped region, whose literals are used in place by
+   * some clauses (e.g. a binary group-set file); it is unmapped on clear()
+   */
+  void adopt_mapping(void* addr, size_t len) { _maps.emplace_back(addr, len); }
+
+  /* Number of literals handed out */
+  size_t size(void) const { return _used; }
+
+  /* Number of literals allocated */
+  size_t capacity(void) const { return _capacity; }
+
+  /* Releases all literals */
+  void clear(void) {
+    _chunks.clear();
+    _unmap();
+    _next = 0;
+    _left = _used = _capacity = 0;
+    _npend = 0;
+    _chunk_size = min_chunk;
+  }
+
+private:
+
+  void _grow(ULINT n) {
+    size_t sz = std::max((size_t)n, _chunk_size);
+    _chunks.emplace_back(new LINT[sz]);
+    if (_npend) // carry over the pending block
+      std::copy(_next, _next + _npend, _chunks.back().get());
+    _next = _chunks.back().get();
+    _left = sz;
+    _capacity += sz;
+    if (_chunk_size < max_chunk)
+      _chunk_size <<= 1;
+  }
+
+  void _unmap(void) {
+    for (auto& m : _maps)
+      munmap(m.first, m.second);
+    _maps.clear();
+  }
+
+  static const size_t min_chunk = 1 << 10;
+  static const size_t max_chunk = 1 << 22;
+
+  std::vector<std::unique_ptr<LINT[]> > _chunks;  // storage
+
+  LINT* _next = 0;                  // next free literal in the last chunk
+
+  size_t _left = 0;                 // free literals in the last chunk
+
+  size_t _used = 0;                 // literals handed out
+
+  size_t _capacity = 0;             // literals allocated
+
+  size_t _chunk_size = min_chunk;   // size of the next chunk
+
+  ULINT _npend = 0;                 // pending literals (at _next)
+
+  std::vector<std::pair<void*, size_t> > _maps; // adopted mappings
+
+};
+
+/*----------------------------------------------------------------------------*\
+ * Class:  ClauseArena
+ *
+ * Purpose: A bump-pointer allocator of BasicClause objects whose literals
+ *          live in external storage (e.g. a LitPool).
+ *
+ * Notes:
+ *      1. The clauses are destroyed together with the arena (or on clear()),
+ *         and are marked pooled() so that nobody else deletes them.
+\*----------------------------------------------------------------------------*/
+
+class ClauseArena {
+
+public:
+
+  ClauseArena(void) {}
+
+  ~ClauseArena(void) { clear(); }
+
+  /* Creates a new clause on top of the literals lits[0..size-1] */
+  BasicClause* make_clause(LINT* lits, ULINT size) {
+    if (_chunks.empty() || _chunks.back().used == _chunks.back().size)
+      _grow();
+    chunk& c = _chunks.back();
+    BasicClause* cl = new (c.mem + c.used) BasicClause(lits, size);
+    cl->_flags.pooled = 1;
+    c.used++;
+    return cl;
+  }
+
+  /* Destroys all clauses */
+  void clear(void) {
+    for (chunk& c : _chunks) {
+      for (size_t i = 0; i < c.used; ++i)
+        c.mem[i].~BasicClause();
+      ::operator delete(c.mem);
+    }
+    _chunks.clear();
+    _chunk_size = min_chunk;
+  }
+
+private:
+
+  struct chunk {
+    BasicClause* mem;   // raw storage for 'size' clauses
+    size_t size;
+    size_t used;        // constructed so far
+  };
+
+  void _grow(void) {
+    void* mem = ::operator new(_chunk_size * sizeof(BasicClause));
+    _chunks.push_back(chunk{ static_cast<BasicClause*>(mem), _chunk_size, 0 });
+    if (_chunk_size < max_chunk)
+      _chunk_size <<= 1;
+  }
+
+  static const size_t min_chunk = 1 << 6;
+  static const size_t max_chunk = 1 << 16;
+
+  std::vector<chunk> _chunks;       // storage
+
+  size_t _chunk_size = min_chunk;   // size of the next chunk
+
+  // no copying
+  ClauseArena(const ClauseArena&);
+  ClauseArena& operator=(const ClauseArena&);
+
+};
+
+#endif /* _CL_ARENA_HH */
+
+/*----------------------------------------------------------------------------*/
@@ -153,8 +153,8 @@ class LitVectEqual {
 public:
   bool operator()(vector<LINT>* lv1, vector<LINT>* lv2) const {
     if (lv1->size() != lv2->size()) { return false; }
-    Literator pos1 = lv1->begin();  // Vectors assumed to be sorted
-    Literator pos2 = lv2->begin();
+    vector<LINT>::iterator pos1 = lv1->begin();  // Vectors assumed to be sorted
+    vector<LINT>::iterator pos2 = lv2->begin();
     for(; pos1 != lv1->end(); ++pos1, ++pos2) {  // vectors w/ the same size
       if (*pos1 != *pos2) { return false; }
     }
@@ -168,6 +168,27 @@ public:
   }
 };
 
+// Same as LitVectHash/LitVectEqual, but on spans of literals, so that
+// the literals do not have to be kept in vectors
+
+class LitSpanHash {
+public:
+  std::size_t operator()(const LitSpan& ls) const {
+    std::size_t hashv = 0;
+    for(const LINT* pos = ls.lits; pos != ls.lits + ls.size; ++pos) {
+      hashv = (hashv << HPSHIFT) ^ ((*pos>0) ? *pos : -*pos);
+    }
+    return hashv;
+  }
+};
+
+class LitSpanEqual {
+public:
+  bool operator()(const LitSpan& ls1, const LitSpan& ls2) const {
+    return (ls1.size == ls2.size) && equal(ls1.lits, ls1.lits + ls1.size, ls2.lits);
+  }
+};
+
 #endif /* _CL_FUNCTORS_H */
 
 /*----------------------------------------------------------------------------*/
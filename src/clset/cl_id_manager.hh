@@ -7,10 +7,12 @@
 
 #pragma once
 
+#include <atomic>
 #include "globals.hh"
 
 /* Manager for clause IDs. 
- * Note: not MT-safe 
+ * Note: Instance() is not MT-safe (the instance is created during parsing), 
+ * but new_id() is -- the workers in multi-threaded mode create clauses.
  */
 class ClauseIdManager
 {
@@ -22,9 +24,9 @@ public:
     return instance;
   }
 
-  ULINT new_id(void) { return _id++; }
+  ULINT new_id(void) { return _id.fetch_add(1, std::memory_order_relaxed); }
 
-  ULINT id(void) { return _id; }
+  ULINT id(void) { return _id.load(std::memory_order_relaxed); }
 
 protected:
 
@@ -32,7 +34,7 @@ protected:
 
 private:
 
-  ULINT _id;
+  std::atomic<ULINT> _id;
 
   static ClauseIdManager * instance;
 
@@ -116,10 +116,9 @@ public: // open up the interface so that clauses can be created directly
 
   void register_clause(BasicClause* ncl) {
 #ifdef CLRG_CACHE_LITS
-    // Map from lit vect to cl
-    vector<LINT>& lits = ncl->cl_lits();
-    assert(v2p_map.find(&lits) == v2p_map.end());
-    v2p_map.insert(make_pair(&lits, ncl));
+    // Map from lits to cl
+    assert(v2p_map.find(ncl->cl_lits()) == v2p_map.end());
+    v2p_map.insert(make_pair(ncl->cl_lits(), ncl));
 #endif
     // Map from cl to ref cnt
     LINT nclref = 0;
@@ -129,13 +128,11 @@ public: // open up the interface so that clauses can be created directly
   void add_literal(BasicClause* cl, LINT nlit) {
 #ifdef CLRG_CACHE_LITS
     CHK(ULINT mapsz = v2p_map.size(););
-    vector<LINT>& clits = cl->cl_lits();
-    v2p_map.erase(&clits);
+    v2p_map.erase(cl->cl_lits());
 #endif
     cl->add_lit(nlit);
 #ifdef CLRG_CACHE_LITS
-    vector<LINT>& nclits = cl->cl_lits();
-    v2p_map.insert(make_pair(&nclits, cl));
+    v2p_map.insert(make_pair(cl->cl_lits(), cl));
     CHK(assert(mapsz == v2p_map.size()));
 #endif
   }
@@ -143,9 +140,8 @@ public: // open up the interface so that clauses can be created directly
   void erase_clause(BasicClause* cl) {
     NDBG(cout << "Erasing clause: " << *cl << endl;);
 #ifdef CLRG_CACHE_LITS
-    vector<LINT>& clits = cl->cl_lits();
-    assert(v2p_map.find(&clits) != v2p_map.end());
-    v2p_map.erase(&clits);
+    assert(v2p_map.find(cl->cl_lits()) != v2p_map.end());
+    v2p_map.erase(cl->cl_lits());
 #else
     c2n_map.erase(cl); // this should probably be done regardless of CLRG_CACHE_LITS
 #endif
@@ -155,8 +151,7 @@ public: // open up the interface so that clauses can be created directly
   BasicClause* lookup_vect(vector<LINT>& clits) {
 #ifdef CLRG_CACHE_LITS
     assert(is_sorted(clits.begin(), clits.end(), AbsLitLess()));
-    iv2cl_iterator ippos = v2p_map.find(&clits);
-    return (ippos != v2p_map.end()) ? ippos->second : NULL;
+    return lookup_lits(LitSpan(clits));
 #else
     return NULL;
 #endif
@@ -164,14 +159,35 @@ public: // open up the interface so that clauses can be created directly
 
   BasicClause* lookup_vect(LINT num, const LINT ivect[]) {
 #ifdef CLRG_CACHE_LITS
-    vector<LINT> clits(ivect, ivect+num);
-    iv2cl_iterator ippos = v2p_map.find(&clits);
+    return lookup_lits(LitSpan(ivect, num));
+#else
+    return NULL;
+#endif
+  }
+
+  BasicClause* lookup_lits(const LitSpan& lits) {
+#ifdef CLRG_CACHE_LITS
+    ls2cl_iterator ippos = v2p_map.find(lits);
     return (ippos != v2p_map.end()) ? ippos->second : NULL;
 #else
     return NULL;
 #endif
   }
 
+  /* Reserves space for n clauses */
+  void reserve(size_t n) {
+#ifdef CLRG_CACHE_LITS
+    v2p_map.resize(n);
+#endif
+    c2n_map.resize(n);
+  }
+
+  /* Forgets all registered clauses (the clauses themselves are not touched) */
+  void clear(void) {
+    v2p_map.clear();
+    c2n_map.clear();
+  }
+
 protected:
 
   // Remove duplicate literals
@@ -193,7 +209,7 @@ protected:
 
 protected:
 
-  IVec2ClMap v2p_map;
+  LitSpan2ClMap v2p_map;
 
   Clause2IntMap c2n_map;
 
@@ -48,11 +48,40 @@ typedef hash_map<BasicClause*,LINT,ClPtrHash,ClPtrEqual> Clause2IntMap;
 typedef hash_map<IntVector*,BasicClause*,LitVectHash,LitVectEqual> IVec2ClMap;
 typedef IVec2ClMap::iterator iv2cl_iterator;
 
+typedef hash_map<LitSpan,BasicClause*,LitSpanHash,LitSpanEqual> LitSpan2ClMap;
+typedef LitSpan2ClMap::iterator ls2cl_iterator;
+
 typedef vector<BasicClause*> BasicClauseVector;
 typedef BasicClauseVector::iterator ClVectIterator;
 typedef BasicClauseVector::iterator cvec_iterator;
 typedef BasicClauseVector::const_iterator cvec_citerator;
 
+// A read-only view of a contiguous sequence of clause pointers (e.g.
+// the clauses of a group); implicitly constructible from BasicClauseVector.
+class ClauseRange {
+public:
+  typedef BasicClause* const* const_iterator;
+  typedef const_iterator iterator;
+  typedef BasicClause* value_type;
+
+  ClauseRange(void) : _begin(NULL), _end(NULL) {}
+  ClauseRange(const_iterator b, const_iterator e) : _begin(b), _end(e) {}
+  ClauseRange(const BasicClauseVector& clv) 
+    : _begin(clv.data()), _end(clv.data() + clv.size()) {}
+
+  const_iterator begin(void) const { return _begin; }
+  const_iterator end(void) const { return _end; }
+  size_t size(void) const { return _end - _begin; }
+  bool empty(void) const { return _begin == _end; }
+  BasicClause* operator[](size_t i) const { return _begin[i]; }
+  BasicClause* front(void) const { return *_begin; }
+
+private:
+  const_iterator _begin;
+  const_iterator _end;
+};
+typedef ClauseRange::const_iterator crange_iterator;
+
 typedef slist<BasicClause*> BasicClauseSList;
 
 typedef list<BasicClause*> BasicClauseList;
@@ -137,7 +137,7 @@ Solver::Solver() :
 
     // Resource constraints:
     //
-        , conflict_budget(-1), propagation_budget(-1), asynch_interrupt(false), incremental(
+        , conflict_budget(-1), propagation_budget(-1), asynch_interrupt(false), term_cb(NULL), term_state(NULL), incremental(
         opt_incremental), nbVarsInitialFormula(INT32_MAX) {
   MYFLAG = 0;
   // Initialize only first time. Useful for incremental solving, useless otherwise
@@ -1423,6 +1423,22 @@ void Solver::relocAll(ClauseAllocator& to) {
     ca.reloc(clauses[i], to);
 }
 
+void Solver::copyLearnts(vec<Lit>& out, int max_size) const {
+  int top = (trail_lim.size() == 0) ? trail.size() : trail_lim[0];
+  for (int i = 0; i < top; i++) {
+    out.push(trail[i]);
+    out.push(lit_Undef);
+  }
+  for (int i = 0; i < learnts.size(); i++) {
+    const Clause& c = ca[learnts[i]];
+    if (c.mark() || c.size() > max_size)
+      continue;
+    for (int j = 0; j < c.size(); j++)
+      out.push(c[j]);
+    out.push(lit_Undef);
+  }
+}
+
 void Solver::garbageCollect() {
   // Initialize the next region to a size corresponding to the estimated utilization degree. This
   // is not precise but should avoid some unnecessary reallocations for the new region:
@@ -103,6 +103,7 @@ public:
   void    budgetOff();
   void    interrupt();          // Trigger a (potentially asynchronous) interruption of the solver.
   void    clearInterrupt();     // Clear interrupt indicator flag.
+  void    setTermCallback(void* state, int (*cb)(void*)); // Stop the search when cb(state) returns non-0 (NULL = none).
 
   // Memory managment:
   //
@@ -220,6 +221,8 @@ public:
   int64_t             conflict_budget;    // -1 means no budget.
   int64_t             propagation_budget; // -1 means no budget.
   bool                asynch_interrupt;
+  int               (*term_cb)(void*);  // termination callback (NULL = none), see setTermCallback()
+  void*               term_state;
 
   // Main internal methods:
   //
@@ -603,11 +606,13 @@ public:
  inline void     Solver::setPropBudget(int64_t x){ propagation_budget = propagations + x; }
  inline void     Solver::interrupt(){ asynch_interrupt = true; }
  inline void     Solver::clearInterrupt(){ asynch_interrupt = false; }
+ inline void     Solver::setTermCallback(void* state, int (*cb)(void*)){ term_state = state; term_cb = cb; }
  inline void     Solver::budgetOff(){ conflict_budget = propagation_budget = -1; }
  inline bool     Solver::withinBudget() const {
    return !asynch_interrupt &&
      (conflict_budget    < 0 || conflicts < (uint64_t)conflict_budget) &&
-     (propagation_budget < 0 || propagations < (uint64_t)propagation_budget); }
+     (propagation_budget < 0 || propagations < (uint64_t)propagation_budget) &&
+     (term_cb == NULL || !term_cb(term_state)); }
 
  // FIXME: after the introduction of asynchronous interrruptions the solve-versions that return a
  // pure bool do not give a safe interface. Either interrupts must be possible to turn off here, or
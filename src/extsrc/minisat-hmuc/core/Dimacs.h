@@ -77,7 +77,7 @@ static void parse_DIMACS_main(B& in, CMinimalCore& core) {
                 continue;
             }
 
-            Clause::SetUid(cnt-1);
+            S.SetUid(cnt-1);
             S.addClause_(lits, true);
             if (!S.okay())
             {
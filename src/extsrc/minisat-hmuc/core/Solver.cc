@@ -54,8 +54,6 @@ static BoolOption    opt_glucose           (_cat, "glucose", "If to use glucose
 //=================================================================================================
 // Constructor/Destructor:
 
-uint32_t Clause::icUid = 0;
-
 Solver::Solver() :
 
     // Parameters (user settable):
@@ -83,6 +81,7 @@ Solver::Solver() :
   , learntsize_adjust_start_confl (100)
   , learntsize_adjust_inc         (1.5)
   , use_glucose      (opt_glucose)
+  , bind_as_orig     (opt_bind_as_orig)
 
     // Statistics: (formerly in 'SolverStats')
     //
@@ -105,6 +104,8 @@ Solver::Solver() :
   , conflict_budget    (-1)
   , propagation_budget (-1)
   , asynch_interrupt   (false)
+  , term_cb            (NULL)
+  , term_state         (NULL)
 {
     vecConfl.push(0);
 }
@@ -564,7 +565,7 @@ CRef Solver::propagate()
                         add_tmp.clear();
                         add_tmp.push(first);
                         CRef newCr = ca.alloc(add_tmp, false, true);
-                        Clause::DecreaseUid();
+                        ca.DecreaseUid();
                         ca[newCr].uid() = c.uid();
                         c.mark(2);
                         removeClause(cr);
@@ -1164,33 +1165,29 @@ void Solver::relocAll(ClauseAllocator& to)
             ca.reloc(vardata[v].reason, to);
     }
     
-    // All learnt:
+    // All learnt, original and ic units (the clauses removed by RemoveClauses()
+    // are still in there, and should be dropped, not relocated):
     //
-    for (int i = 0; i < learnts.size(); i++) 
-    {
-        ca.reloc(learnts[i], to);
-        Clause& c = to[learnts[i]];
-        if (c.ic())
-           resol.UpdateInd(c.uid(), learnts[i]);
-    }
+    relocClauses(learnts, to);
+    relocClauses(clauses, to);
+    relocClauses(icUnitClauses, to);
+}
 
-    // All original:
-    //
-    for (int i = 0; i < clauses.size(); i++)
+void Solver::relocClauses(vec<CRef>& cs, ClauseAllocator& to)
+{
+    int i, j;
+    for (i = j = 0; i < cs.size(); i++)
     {
-        ca.reloc(clauses[i], to);
-        Clause& c = to[clauses[i]];
+        if (ca[cs[i]].mark() == 1)
+            continue;
+        cs[j] = cs[i];
+        ca.reloc(cs[j], to);
+        Clause& c = to[cs[j]];
         if (c.ic())
-            resol.UpdateInd(c.uid(), clauses[i]);
-    }
-
-    for (int i = 0; i < icUnitClauses.size(); i++)
-    {
-        ca.reloc(icUnitClauses[i], to);
-        Clause& c = to[icUnitClauses[i]];
-        assert(c.ic());
-        resol.UpdateInd(c.uid(), icUnitClauses[i]);
+            resol.UpdateInd(c.uid(), cs[j]);
+        j++;
     }
+    cs.shrink(i - j);
 }
 
 void Solver::garbageCollect()
@@ -1295,6 +1292,10 @@ void Solver::UnbindClauses(vec<uint32_t>& cone)
         CRef cr = resol.GetInd(cone[i]);
         if (cr != CRef_Undef)
         {
+            // already unbound through another ic
+            icUnbound.growTo(cone[i] + 1, 0);
+            if (icUnbound[cone[i]]++ > 0)
+                continue;
             Clause& c = ca[cr];
             if (c.size() > 1)
             {
@@ -1326,7 +1327,7 @@ void Solver::UnbindClauses(vec<uint32_t>& cone)
 
 void Solver::BindClauses(vec<uint32_t>& cone)
 {
-    if (opt_bind_as_orig == 2)
+    if (bind_as_orig == 2)
     {
         resol.GetAllIcUids(setGood, cone);
     }
@@ -1342,10 +1343,10 @@ void Solver::BindClauses(vec<uint32_t>& cone)
         if (cr != CRef_Undef)
         {
             Clause& c = ca[cr];
-            c.mark(0);
-            if ((opt_bind_as_orig == 1 && resol.GetParentsNumber(uid) == 0) ||
-                (opt_bind_as_orig == 2 && setGood.has(uid)))
+            if ((bind_as_orig == 1 && resol.GetParentsNumber(uid) == 0) ||
+                (bind_as_orig == 2 && setGood.has(uid)))
             {
+                c.mark(0);
                 removeClause(cr);
                 analyze_stack.clear();
 
@@ -1386,6 +1387,13 @@ void Solver::BindClauses(vec<uint32_t>& cone)
             }
             else
             {
+                // bound already, or still unbound through another ic
+                if (uid >= (uint32_t)icUnbound.size() || icUnbound[uid] == 0 ||
+                    --icUnbound[uid] > 0)
+                {
+                    continue;
+                }
+                c.mark(0);
                 if (c.size() > 1)
                 {
                     attachClause(cr);
@@ -104,6 +104,7 @@ public:
     void    budgetOff();
     void    interrupt();          // Trigger a (potentially asynchronous) interruption of the solver.
     void    clearInterrupt();     // Clear interrupt indicator flag.
+    void    setTermCallback(void* state, int (*cb)(void*)); // Stop the search when cb(state) returns non-0 (NULL = none).
 
     // Memory management:
     //
@@ -140,6 +141,7 @@ public:
     double    learntsize_adjust_inc;
 
     bool      use_glucose;        // Whether to use glucose deletion strategy
+    int       bind_as_orig;       // Bind ic clauses as originals (0=no, 1=only original, 2=all cone).
 
     // Statistics: (read-only member variable)
     //
@@ -151,6 +153,9 @@ public:
     void ResetOk();
     void UpdateFalsifiedClause(uint32_t uid);
 
+    uint32_t GetLastUid() const { return ca.GetLastUid(); } // uid of the last ic clause
+    void     SetUid(uint32_t uid) { ca.SetUid(uid); }        // uid of the next ic clause
+
     void printClause(FILE* f, Clause& c);
 
     template<class T>
@@ -165,6 +170,7 @@ protected:
     void CreateUnsatCore(CRef ref);
     CResolutionGraph resol; 
     vec<CRef> icUnitClauses;
+    vec<int> icUnbound;             // per uid: the number of unbound ics the clause is derived from
     vec<uint32_t> icParents;
     vec<Map<Lit, CRef>::Pair> icImpl;
     Set<uint32_t> setGood;
@@ -238,6 +244,8 @@ protected:
     int64_t             conflict_budget;    // -1 means no budget.
     int64_t             propagation_budget; // -1 means no budget.
     bool                asynch_interrupt;
+    int               (*term_cb)(void*);  // termination callback (NULL = none), see setTermCallback()
+    void*               term_state;
 
     // Main internal methods:
     //
@@ -274,6 +282,7 @@ protected:
     bool     satisfied        (const Clause& c) const; // Returns TRUE if a clause is satisfied in the current state.
 
     void     relocAll         (ClauseAllocator& to);
+    void     relocClauses     (vec<CRef>& cs, ClauseAllocator& to);
 
     // Misc:
     //
@@ -378,11 +387,13 @@ inline void     Solver::setConfBudget(int64_t x){ conflict_budget    = conflicts
 inline void     Solver::setPropBudget(int64_t x){ propagation_budget = propagations + x; }
 inline void     Solver::interrupt(){ asynch_interrupt = true; }
 inline void     Solver::clearInterrupt(){ asynch_interrupt = false; }
+inline void     Solver::setTermCallback(void* state, int (*cb)(void*)){ term_state = state; term_cb = cb; }
 inline void     Solver::budgetOff(){ conflict_budget = propagation_budget = -1; }
 inline bool     Solver::withinBudget() const {
     return !asynch_interrupt &&
            (conflict_budget    < 0 || conflicts < (uint64_t)conflict_budget) &&
-           (propagation_budget < 0 || propagations < (uint64_t)propagation_budget); }
+           (propagation_budget < 0 || propagations < (uint64_t)propagation_budget) &&
+           (term_cb == NULL || !term_cb(term_state)); }
 
 // FIXME: after the introduction of asynchronous interruptions the solve-versions that return a
 // pure bool do not give a safe interface. Either interrupts must be possible to turn off here, or
@@ -129,12 +129,11 @@ class Clause {
         unsigned size      : 26; }                            header;
     union { Lit lit; float act; uint32_t abs; CRef rel; uint32_t uid; } data[0];
 
-    static uint32_t icUid;
     friend class ClauseAllocator;
 
     // NOTE: This constructor cannot be used directly (doesn't allocate enough memory).
     template<class V>
-    Clause(const V& ps, bool use_extra, bool learnt, bool ic) {
+    Clause(const V& ps, bool use_extra, bool learnt, bool ic, uint32_t uid) {
         header.mark      = 0;
         header.learnt    = learnt;
         header.ic      = ic;
@@ -153,14 +152,11 @@ class Clause {
 
         if (ic)
         {
-            data[header.size + (int)header.has_extra].uid = icUid++;
+            data[header.size + (int)header.has_extra].uid = uid;
         }
     }
 
 public:
-    static uint32_t GetLastUid() { return icUid-1; }
-    static void DecreaseUid() { --icUid; }
-    static uint32_t SetUid(uint32_t newUid) { return icUid = newUid; }
 
     void calcAbstraction() {
         assert(header.has_extra);
@@ -215,29 +211,44 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
 {
     static int clauseWord32Size(int size, bool has_extra, bool ic){
         return (sizeof(Clause) + (sizeof(Lit) * (size + (int)has_extra + (int)ic))) / sizeof(uint32_t); }
- public:
-    bool extra_clause_field;
-
-    ClauseAllocator(uint32_t start_cap) : RegionAllocator<uint32_t>(start_cap), extra_clause_field(false){}
-    ClauseAllocator() : extra_clause_field(false){}
 
-    void moveTo(ClauseAllocator& to){
-        to.extra_clause_field = extra_clause_field;
-        RegionAllocator<uint32_t>::moveTo(to); }
+    uint32_t icUid; // Next uid of an ic clause. Per allocator (i.e. per solver), so that each
+                    // solver has its own dense uid space, whichever thread calls it.
 
     template<class Lits>
-    CRef alloc(const Lits& ps, bool learnt = false, bool ic = false)
+    CRef allocUid(const Lits& ps, bool learnt, bool ic, uint32_t uid)
     {
         assert(sizeof(Lit)      == sizeof(uint32_t));
         assert(sizeof(float)    == sizeof(uint32_t));
         bool has_extra = learnt | extra_clause_field;
 
         CRef cid = RegionAllocator<uint32_t>::alloc(clauseWord32Size(ps.size(), has_extra, ic));
-        new (lea(cid)) Clause(ps, has_extra, learnt, ic);
+        new (lea(cid)) Clause(ps, has_extra, learnt, ic, uid);
 
         return cid;
     }
 
+ public:
+    bool extra_clause_field;
+
+    ClauseAllocator(uint32_t start_cap) : RegionAllocator<uint32_t>(start_cap), icUid(0), extra_clause_field(false){}
+    ClauseAllocator() : icUid(0), extra_clause_field(false){}
+
+    // NOTE: the uid counter stays with 'to' (see 'Solver::garbageCollect()').
+    void moveTo(ClauseAllocator& to){
+        to.extra_clause_field = extra_clause_field;
+        RegionAllocator<uint32_t>::moveTo(to); }
+
+    uint32_t GetLastUid() const { return icUid-1; }
+    void DecreaseUid() { --icUid; }
+    uint32_t SetUid(uint32_t newUid) { return icUid = newUid; }
+
+    template<class Lits>
+    CRef alloc(const Lits& ps, bool learnt = false, bool ic = false)
+    {
+        return allocUid(ps, learnt, ic, ic ? icUid++ : 0);
+    }
+
     // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
     Clause&       operator[](Ref r)       { return (Clause&)RegionAllocator<uint32_t>::operator[](r); }
     const Clause& operator[](Ref r) const { return (Clause&)RegionAllocator<uint32_t>::operator[](r); }
@@ -257,7 +268,7 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
 
         if (c.reloced()) { cr = c.relocation(); return; }
         
-        cr = to.alloc(c, c.learnt(), c.ic());
+        cr = to.allocUid(c, c.learnt(), c.ic(), c.ic() ? c.uid() : 0); // keeps the uid
         c.relocate(cr);
         
         // Copy extra data-fields: 
@@ -267,12 +278,6 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
             to[cr].activity() = c.activity();
         else if (to[cr].has_extra()) 
             to[cr].calcAbstraction();
-        if (to[cr].ic()) 
-        {
-            // we don't want to increase uid here
-            Clause::icUid--;
-            to[cr].uid() = c.uid();
-        }
     }
 };
 
@@ -96,6 +96,8 @@ Solver::Solver() :
   , conflict_budget    (-1)
   , propagation_budget (-1)
   , asynch_interrupt   (false)
+  , term_cb            (NULL)
+  , term_state         (NULL)
 {}
 
 
@@ -610,6 +610,10 @@ struct PicoSAT
   unsigned long long lsimplify;
   unsigned long long propagations;
   unsigned long long lpropagations;
+  struct {
+    void * state;
+    int (*function) (void *);
+  } interrupt;			/* (as in picosat 960+) */
   unsigned fixed;		/* top level assignments */
 #ifndef NFL
   unsigned failedlits;
@@ -6096,6 +6100,10 @@ SATISFIED:
       if (ps->propagations >= ps->lpropagations)/* propagation limit reached ? */
 	return PICOSAT_UNKNOWN;
 
+      if (ps->interrupt.function &&		/* external interrupt ? */
+	  ps->interrupt.function (ps->interrupt.state))
+	return PICOSAT_UNKNOWN;
+
 #ifndef NADC
       if (!ps->adodisabled && ps->adoconflicts >= ps->adoconflictlimit)
 	{
@@ -8023,6 +8031,15 @@ picosat_set_propagation_limit (PS * ps, unsigned long long l)
   ps->lpropagations = l;
 }
 
+void
+picosat_set_interrupt (PS * ps,
+		       void * external_state,
+		       int (*interrupted)(void * external_state))
+{
+  ps->interrupt.state = external_state;
+  ps->interrupt.function = interrupted;
+}
+
 unsigned long long
 picosat_propagations (PS * ps)
 {
@@ -416,6 +416,15 @@ int picosat_sat (PicoSAT *, int decision_limit);
  */
 void picosat_set_propagation_limit (PicoSAT *, unsigned long long limit);
 
+/* Set a function that is called every now and then by 'picosat_sat'; if it
+ * returns a non zero value, 'picosat_sat' stops and returns
+ * 'PICOSAT_UNKNOWN' (back-ported from PicoSAT 960).  A zero function
+ * removes the interrupt.
+ */
+void picosat_set_interrupt (PicoSAT *,
+                            void * external_state,
+                            int (*interrupted)(void * external_state));
+
 /* Return last result of calling 'picosat_sat' or '0' if not called.
  */
 int picosat_res (PicoSAT *);
@@ -23,6 +23,12 @@
 \*----------------------------------------------------------------------------*/
 //jpms:ec
 
+#include <cstring>
+#include <stdint.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #define CHUNK_LIMIT 1048576
 #define SMALL_CHUNK_LIMIT 1024
 
@@ -30,15 +36,16 @@ class StreamBuffer {
 protected:
   gzFile  in;
   char    *buf; //buf[CHUNK_LIMIT];
+  int     cap;  // capacity of buf
   int     pos;
   int     size;
 
   void assureLookahead() {
     if (pos >= size) {
       pos  = 0;
-      size = gzread(in, buf, sizeof(buf)); } }
+      size = gzread(in, buf, cap); } }
 
-  virtual void resize_buffer() { buf = new char[CHUNK_LIMIT]; }
+  virtual void resize_buffer() { buf = new char[cap = CHUNK_LIMIT]; }
 
 public:
   StreamBuffer(gzFile i) : in(i), pos(0), size(0) {
@@ -53,7 +60,7 @@ public:
 
 class SmallStreamBuffer : public StreamBuffer {
 protected:
-  virtual void resize_buffer() { buf = new char[SMALL_CHUNK_LIMIT]; }
+  virtual void resize_buffer() { buf = new char[cap = SMALL_CHUNK_LIMIT]; }
 
 public:
   SmallStreamBuffer(gzFile i) : StreamBuffer(i) { }
@@ -62,10 +69,153 @@ public:
 };
 
 
+
+/*----------------------------------------------------------------------------*\
+ * Class:  MappedBuffer
+ *
+ * Purpose: Read-only memory-mapped view of an (uncompressed) input file, with
+ *          the same interface as StreamBuffer; FMTUtils provides faster
+ *          overloads of the scanning routines for it.
+ *
+ * Notes:
+ *      1. ok() is false if the file cannot be mapped (e.g. a pipe, or an empty
+ *         file) or if it looks gzip-compressed -- the callers should then use
+ *         StreamBuffer instead.
+\*----------------------------------------------------------------------------*/
+
+class MappedBuffer {
+protected:
+  const char *beg;
+  const char *cur;
+  const char *end;
+  size_t      len;  // mapped length (0 for views)
+
+public:
+  MappedBuffer(const char* fname) : beg(NULL), cur(NULL), end(NULL), len(0) {
+    int fd = open(fname, O_RDONLY);
+    if (fd < 0)
+      return;
+    struct stat st;
+    if ((fstat(fd, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size > 0)) {
+      void* mem = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mem != MAP_FAILED) {
+        len = st.st_size;
+        beg = cur = static_cast<const char*>(mem);
+        end = beg + len;
+        madvise(mem, len, MADV_SEQUENTIAL);
+      }
+    }
+    close(fd);
+    // gzip magic -- leave it to zlib
+    if ((len >= 2) && ((unsigned char)beg[0] == 0x1f)
+        && ((unsigned char)beg[1] == 0x8b)) {
+      munmap((void*)beg, len);
+      beg = cur = end = NULL;
+      len = 0;
+    }
+  }
+
+  // a view of the range [b, e) of some other buffer
+  MappedBuffer(const char* b, const char* e) : beg(b), cur(b), end(e), len(0) {}
+
+  ~MappedBuffer() { if (len) munmap((void*)beg, len); }
+
+  bool ok(void) const { return beg != NULL; }
+
+  int  operator *  () { return (cur >= end) ? EOF : *cur; }
+  void operator ++ () { cur++; }
+
+  // direct access, for the fast scanners
+  const char*& pos(void) { return cur; }
+  const char* limit(void) const { return end; }
+  const char* base(void) const { return beg; }
+
+private:
+  MappedBuffer(const MappedBuffer&);
+  MappedBuffer& operator=(const MappedBuffer&);
+};
+
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 namespace FMTUtils {
 
+// Overloads for MappedBuffer: these work on raw pointers, and parseInt()
+// converts up to 8 digits at a time (SWAR) when the input is long enough.
+
+static inline void skipWhitespace(MappedBuffer& in) {
+  const char*& p = in.pos();
+  const char* e = in.limit();
+  while ((p < e) && ((*p >= 9 && *p <= 13) || *p == 32))
+    ++p; }
+
+static inline void skipLine(MappedBuffer& in) {
+  const char*& p = in.pos();
+  const char* e = in.limit();
+  while ((p < e) && (*p != '\n') && (*p != '\r'))
+    ++p;
+  if (p < e) ++p; }
+
+/* Returns the number of leading decimal digits in the 8 bytes of w (loaded
+ * in little-endian order); non-ASCII bytes never count as digits.
+ */
+static inline unsigned swarDigitCount(uint64_t w) {
+  const uint64_t hi = 0xF0F0F0F0F0F0F0F0ULL;
+  uint64_t t = (w & hi) | (((w + 0x0606060606060606ULL) & hi) >> 4);
+  uint64_t nd = t ^ 0x3333333333333333ULL;  // non-zero bytes are non-digits
+  return (nd == 0) ? 8 : (__builtin_ctzll(nd) >> 3); }
+
+/* Converts the first n (1..8) digits of w (loaded in little-endian order) */
+static inline uint64_t swarDigitValue(uint64_t w, unsigned n) {
+  w = (w - 0x3030303030303030ULL) << (8 * (8 - n));  // leading zeros
+  w = (w * 10 + (w >> 8)) & 0x00FF00FF00FF00FFULL;
+  w = (w * 100 + (w >> 16)) & 0x0000FFFF0000FFFFULL;
+  return (w * 10000 + (w >> 32)) & 0x00000000FFFFFFFFULL; }
+
+static inline uint64_t scanDigits(MappedBuffer& in) {
+  const char*& p = in.pos();
+  const char* e = in.limit();
+  if ((p >= e) || (*p < '0' || *p > '9')) {
+    fprintf(stderr, "PARSE ERROR! Unexpected char: %c\n", (p < e) ? *p : ' ');
+    exit(3); }
+  static const uint64_t pow10[9] = { 1, 10, 100, 1000, 10000, 100000, 1000000,
+                                     10000000, 100000000 };
+  uint64_t val = 0;
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+  while (e - p >= 8) {
+    uint64_t w;
+    memcpy(&w, p, 8);
+    unsigned n = swarDigitCount(w);
+    if (n == 0)
+      return val;
+    val = val * pow10[n] + swarDigitValue(w, n);
+    p += n;
+    if (n < 8)
+      return val;
+  }
+#endif
+  while ((p < e) && (*p >= '0' && *p <= '9'))
+    val = val*10 + (*p++ - '0');
+  return val; }
+
+static inline LINT parseInt(MappedBuffer& in) {
+  skipWhitespace(in);
+  bool neg = false;
+  if      (*in == '-') neg = true, ++in;
+  else if (*in == '+') ++in;
+  LINT val = (LINT)scanDigits(in);
+  return neg ? -val : val; }
+
+static inline XLINT parseLongInt(MappedBuffer& in) {
+  skipWhitespace(in);
+  bool neg = false;
+  if      (*in == '-') neg = true, ++in;
+  else if (*in == '+') ++in;
+  XLINT val = (XLINT)scanDigits(in);
+  return neg ? -val : val; }
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 template<class B>
 static void skipWhitespace(B& in) {
     while ((*in >= 9 && *in <= 13) || *in == 32)
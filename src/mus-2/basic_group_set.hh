@@ -32,17 +32,28 @@
  * 5. The implementation has been changed over from map-based to vector-based,
  * so some of the naming conventions are kept consisent with maps.
  *
- * 6. The clause pointers are dublicated -- one copy is in the vector of clauses
- * accessed via BasicGroupSet::begin() and BasicGroupSet::end() methods, while
- * the other copy is in the vector of clauses access through 
- * BasicClauseSet::gclauses() and gset_iterator::gclauses() method. This, of
- * course, is a waste, however this is done to make the class backward compatible
- * with MUSer2 code I developed so far. Hopefully, at some point this will be
- * re-written (or not, but implemented property in "competition" versions).
+ * 6. The clause pointers are stored once: the vector of clauses accessed via 
+ * BasicGroupSet::begin() and BasicGroupSet::end() is kept grouped by GID, and
+ * the clauses of a group (BasicGroupSet::gclauses(), gset_iterator::gclauses())
+ * are a ClauseRange into it, located via a vector of offsets indexed by GID. 
+ * When clauses arrive in the order of non-decreasing GIDs (e.g. CNFs) the 
+ * layout is extended in place; otherwise it is rebuilt (stable counting sort)
+ * on the next access to the groups. Note that rebuilding re-orders the vector 
+ * of clauses, and invalidates previously obtained ranges.
  *
  * 7. The group-set has its own copy of ClauseRegistry -- i.e. not the static
  * one.
  *
+ * 8. The clauses created by the group-set (create_clause()) are allocated in 
+ * its ClauseArena, and their literals in its LitPool; the literals of the 
+ * clauses made elsewhere are moved into the LitPool by add_clause(). All
+ * clauses in the group-set are destroyed together with it.
+ *
+ * 9. The group-set can be saved in a binary format (write_binary()) and
+ * loaded back (load_binary()) by mapping the file into memory; the literals
+ * of the loaded clauses stay in the mapping, and the clauses are registered
+ * in the ClauseRegistry only when the registry is first needed.
+ *
  * Revision:    $Id$.
  *
  *                       Copyright (c) 2009-2011, Anton Belov,Joao Marques-Silva
@@ -52,6 +63,8 @@
 #ifndef _BASIC_GROUP_SET_H
 #define _BASIC_GROUP_SET_H 1
 
+#include <algorithm>
+#include <cstring>
 #include <ext/hash_map>       // Location of STL hash extensions
 #include <iostream>
 #include <iterator>
@@ -60,12 +73,17 @@
 #include <set>
 #include <stdexcept>
 #include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "globals.hh"
 #include "basic_clause.hh"
 #include "cl_functors.hh"
 #include "cl_types.hh"
 #include "cl_registry.hh"
+#include "cl_arena.hh"
 #include "mus_config.hh"
 #include "occs_list.hh"
 
@@ -144,6 +162,121 @@ typedef std::list<GID> GIDList;
 typedef GIDList::iterator GIDListIterator;
 typedef GIDList::const_iterator GIDListCIterator;
 
+/** Set of GIDs for the sets that are built and consumed on every SAT call 
+ * (group cores, unnecessary groups): a bitset for membership tests, plus a 
+ * list of members for iteration. Iteration is in the increasing order of
+ * GIDs, as for GIDSet; the list is sorted lazily, on the first iteration 
+ * after an out-of-order insert. clear() only resets the bits of the members,
+ * so a set that is reused is never re-allocated. Very large GIDs (above 
+ * max_dense) are kept in a hash set instead of the bitset.
+ *
+ * Note: begin() may sort the list, so it should not be called concurrently
+ * on the same set from several threads (count() and size() are fine).
+ */
+class DenseGIDSet {
+public:
+  typedef GID value_type;
+  typedef GIDVector::const_iterator const_iterator;
+  typedef const_iterator iterator;                // the members are read-only
+
+  /* Makes room for the GIDs up to max_gid in the bitset */
+  void reserve(GID max_gid) {
+    if (max_gid < max_dense && (max_gid >> 6) >= _bits.size())
+      _bits.resize((max_gid >> 6) + 1, 0);
+  }
+
+  size_t count(GID gid) const {
+    if (gid >= max_dense)
+      return _sparse.count(gid);
+    return ((gid >> 6) < _bits.size()) && ((_bits[gid >> 6] >> (gid & 63)) & 1);
+  }
+
+  std::pair<const_iterator, bool> insert(GID gid) {
+    if (gid >= max_dense) {
+      if (!_sparse.insert(gid).second)
+        return std::make_pair(_gids.cend(), false);
+    } else {
+      reserve(gid);
+      uint64_t& w = _bits[gid >> 6];
+      uint64_t m = (uint64_t)1 << (gid & 63);
+      if (w & m)
+        return std::make_pair(_gids.cend(), false);
+      w |= m;
+    }
+    if (!_gids.empty() && (gid < _gids.back()))
+      _sorted = false;
+    _gids.push_back(gid);
+    return std::make_pair(_gids.cend() - 1, true);
+  }
+
+  /* For std::inserter(); the hint is ignored */
+  const_iterator insert(const_iterator, GID gid) { return insert(gid).first; }
+
+  size_t erase(GID gid) {
+    if (!count(gid))
+      return 0;
+    if (gid >= max_dense)
+      _sparse.erase(gid);
+    else
+      _bits[gid >> 6] &= ~((uint64_t)1 << (gid & 63));
+    _gids.erase(std::find(_gids.begin(), _gids.end(), gid));
+    return 1;
+  }
+
+  /* Returns end() if gid is not in the set; prefer count() */
+  const_iterator find(GID gid) const {
+    if (!count(gid))
+      return end();
+    return std::lower_bound(begin(), end(), gid);
+  }
+
+  const_iterator begin(void) const { _sort(); return _gids.begin(); }
+
+  const_iterator end(void) const { return _gids.end(); }
+
+  size_t size(void) const { return _gids.size(); }
+
+  bool empty(void) const { return _gids.empty(); }
+
+  void clear(void) {
+    for (GID gid : _gids)
+      if (gid < max_dense)
+        _bits[gid >> 6] = 0;
+    _sparse.clear();
+    _gids.clear();
+    _sorted = true;
+  }
+
+  void swap(DenseGIDSet& other) {
+    _bits.swap(other._bits); _sparse.swap(other._sparse); 
+    _gids.swap(other._gids); std::swap(_sorted, other._sorted);
+  }
+
+private:
+
+  void _sort(void) const {
+    if (!_sorted) { std::sort(_gids.begin(), _gids.end()); _sorted = true; }
+  }
+
+  static const GID max_dense = 1 << 26;   // 8MB of bits, at most
+
+  std::vector<uint64_t> _bits;            // membership of GIDs < max_dense
+
+  GIDHSet _sparse;                        // membership of GIDs >= max_dense
+
+  mutable GIDVector _gids;                // the members
+
+  mutable bool _sorted = true;            // true if _gids is sorted
+
+};
+// output
+inline std::ostream& operator<<(std::ostream& out, const DenseGIDSet& gs) {
+  out << "{ "; 
+  copy(gs.begin(), gs.end(), ostream_iterator<ULINT>(out, " "));
+  out << "}";
+  return out;
+}
+
 /** Vector of variables */
 typedef std::vector<ULINT> VarVector;
 
@@ -167,13 +300,13 @@ class BasicGroupSet {
 
 protected:      // Some internal types
 
-  // info for groups of clauses
+  // info for groups of clauses (the clauses themselves are in _clvec)
   struct GroupInfo {
-    BasicClauseVector content;   // all clauses for this group
     ULINT a_count;               // the number of active clauses in the group
-    GroupInfo(void) : a_count(0) {}
+    bool used;                   // true if the group exists
+    GroupInfo(void) : a_count(0), used(false) {}
   };
-  typedef std::vector<GroupInfo*> GIDMap;   // where everything is; index = gid
+  typedef std::vector<GroupInfo> GIDMap;    // index = gid
 
   // info for groups of variables
   struct VGroupInfo {
@@ -185,11 +318,11 @@ protected:      // Some internal types
 
   /* Iterator over a group map, i.e. vector of pointers indexed by GID that 
    * contains NULL pointer for empty groups, and otherwise a structure that
-   * has two fields: content and a_count (e.g. GIDMap or VGIDMap). The iterator
-   * skips empty groups; this is packaged as a template and used for example for
-   * groups of clauses and groups of variables. Template parameters:
-   *   GM -- the map class (GIDMap or VGIDMap)
-   *   Cont -- the type that represents group's content (e.g. vector of clauses)
+   * has two fields: content and a_count (e.g. VGIDMap). The iterator skips 
+   * empty groups; this is packaged as a template and used for groups of 
+   * variables. Template parameters:
+   *   GM -- the map class (e.g. VGIDMap)
+   *   Cont -- the type that represents group's content (e.g. vector of vars)
    * TODO: make a const iterator as well
    */
   template <class GM, class Cont>
@@ -248,17 +381,61 @@ protected:      // Some internal types
     GM_iter _end;       // the end (for range checks)
   };
 
+  /* Iterator over the non-empty groups of clauses; the interface is the same
+   * as that of gmap_iter_tmpl.
+   */
+  class gset_iter
+    : public std::iterator<std::bidirectional_iterator_tag, GID> {
+  public:
+    // lifecycle
+    gset_iter(BasicGroupSet& gs, GID gid) : _gs(&gs), _gid(gid) {
+      // advance to the first non-empty group
+      while ((_gid < _gs->_gmap.size()) && !_gs->_gmap[_gid].used) ++_gid;
+    }
+    // relational
+    bool operator==(const gset_iter& o) const { return _gid == o._gid; }
+    bool operator!=(const gset_iter& o) const { return _gid != o._gid; }
+    // movement forward (no post-increment)
+    gset_iter& operator++(void) {
+      if (_gid >= _gs->_gmap.size()) throw std::out_of_range("gset_iter::operator++(): "
+                                                           "attempt to incerment end()");
+      while ((++_gid < _gs->_gmap.size()) && !_gs->_gmap[_gid].used);
+      return *this; 
+    }
+    // movement back (no post-decrement)
+    gset_iter& operator--(void) {   
+      if (_gid == 0) throw std::out_of_range("gset_iter::operator--(): "
+                                             "attempt to decrerment begin()");
+      while ((--_gid != 0) && !_gs->_gmap[_gid].used);
+      return *this;
+    }
+    // pointed group ID
+    GID operator*(void) const { 
+      if (_gid >= _gs->_gmap.size()) throw std::out_of_range("gset_iter::operator*(): "
+                                                           "attempt to dereference end()");
+      return _gid;
+    }
+    // the clauses of the group
+    ClauseRange gclauses(void) { return _gs->gclauses(**this); }
+    // reference to the size of active (i.e. non-removed) content
+    ULINT& a_count(void) { return _gs->a_count(**this); }
+
+  private:
+    BasicGroupSet* _gs; // the group-set
+    GID _gid;           // current group
+  };
+
 
 public:         // Lifecycle
 
   /* Default contructor - does not try to optimize, no occs_list */
   BasicGroupSet(void) 
-    : _gmap((size_t)1, NULL) {}
+    : _gmap((size_t)1), _goffs((size_t)1, 0) {}
 
   /* Looks into configuration settings, and sets various optimization parameters
    * based on the configuration */
   BasicGroupSet(ToolConfig& config) 
-    : _gmap((size_t)1, NULL) {
+    : _gmap((size_t)1), _goffs((size_t)1, 0) {
     // mode: CNF or GCNF
     _mode = (config.get_grp_mode() ? 2 : 1);
     // occs list is needed for BCP, BCE and for model rotation
@@ -275,24 +452,28 @@ public:         // Lifecycle
   }    
 
   virtual ~BasicGroupSet(void) {
-    // free the clause vectors - clauses themselves are taken care of by the
-    // clause manager
-    for (GIDMap::iterator pgi = _gmap.begin(); pgi != _gmap.end(); ++pgi)
-      if (*pgi != NULL)
-        delete *pgi;
+    // free the clauses that did not come from the arena (the arena takes care
+    // of its own)
+    _destroy_clauses();
     if (_poccs_list != NULL)
       delete _poccs_list;
   }
 
   /* Allows to clear the group-set; preserves the mode, whether or not to
-   * store units; and whether or not to make vgmap 
+   * store units; and whether or not to make vgmap. Note that all clauses
+   * are destroyed.
    */
   void clear(void) {
+    _destroy_clauses();
+    _clreg.clear();
+    _reg_deferred = false;
+    _carena.clear();
+    _lpool.clear();
     _clvec.clear();
-    for (GIDMap::iterator pgi = _gmap.begin(); pgi != _gmap.end(); ++pgi)
-      if (*pgi != NULL)
-        delete *pgi;
-    _gmap.clear();
+    _gmap.assign((size_t)1, GroupInfo());
+    _goffs.assign((size_t)1, 0);
+    _nlaid = 0;
+    _layout_ok = true;
     _max_gid = 0;
     _max_var = 0;
     _max_id = 0;
@@ -369,14 +550,16 @@ public:    // Creation and addition of clauses (note that create_clause is used
    * groupset
    */
   bool exists_clause(BasicClause* cl) { 
-    return _clreg.lookup_vect(cl->cl_lits()) != NULL;
+    _sync_registry();
+    return _clreg.lookup_lits(cl->cl_lits()) != NULL;
   }
 
   /* Returns a pointer to the clause with the same literals or NULL if not
    * there
    */
   BasicClause* lookup_clause(BasicClause* cl) { 
-    return _clreg.lookup_vect(cl->cl_lits());
+    _sync_registry();
+    return _clreg.lookup_lits(cl->cl_lits());
   }
 
   /* Adds a clause to the group set. If the clause with the same literals
@@ -390,10 +573,320 @@ public:    // Creation and addition of clauses (note that create_clause is used
   BasicClause* add_clause(BasicClause* cl) {
     assert(cl->get_grp_id() == gid_Undef);
     assert(!cl->unsorted());
-    BasicClause* res = _clreg.lookup_vect(cl->cl_lits());
+    _sync_registry();
+    BasicClause* res = _clreg.lookup_lits(cl->cl_lits());
     if (res != NULL) // already there
       return res;
-    // new clause
+    // new clause: move its literals into the pool
+    if (!cl->pooled() && cl->size())
+      cl->relocate_lits(_lpool.alloc(cl->size()));
+    _register_clause(cl);
+    return cl;
+  }
+
+  /* Creates and inserts a new clause into group set; when clid != 0, the
+   * clause id will be set to be clid. If an identical clause has already 
+   * been added its returned instead, clid is always ignored in this case.
+   * Note that the vector of literals 'clits' gets sorted and cleaned-up as a
+   * side effect.
+   */
+  BasicClause* create_clause(vector<LINT>& clits, LINT clid = 0) {
+    sort(clits.begin(), clits.end(), AbsLitLess());
+    _clreg.remove_duplicates(clits);
+    _sync_registry();
+    BasicClause* res = _clreg.lookup_lits(LitSpan(clits));
+    if (res != NULL) // already there
+      return res;
+    LINT* lits = _lpool.alloc(clits.size());
+    copy(clits.begin(), clits.end(), lits);
+    BasicClause *cl = _carena.make_clause(lits, clits.size());
+    cl->mark_sorted();
+    if (clid != 0)
+      cl->set_id(clid);
+    _register_clause(cl);
+    return cl;
+  }
+
+  /* Staging buffer for the literals of a clause that is being read in; the
+   * literals go straight into the LitPool of the group-set, so that 
+   * create_clause() can make a clause out of them without copying. Only one
+   * buffer per group-set should be in use at a time, and nothing else may
+   * be created in the group-set while the buffer is not empty.
+   */
+  class LitBuffer {
+  public:
+    LitBuffer(BasicGroupSet& gs) : _lpool(gs._lpool) {}
+    ~LitBuffer(void) { _lpool.discard(); }
+    void clear(void) { _lpool.discard(); }
+    void push_back(LINT lit) { _lpool.append(lit); }
+    size_t size(void) const { return _lpool.npending(); }
+    bool empty(void) const { return size() == 0; }
+    LINT& back(void) { return _lpool.pending()[size() - 1]; }
+    void resize(size_t n) { _lpool.shrink_pending(n); } // shrink only
+    LINT* begin(void) { return _lpool.pending(); }
+    LINT* end(void) { return begin() + size(); }
+  private:
+    LitPool& _lpool;
+  };
+
+  /* Same as above, but takes the literals from a LitBuffer, which is cleared
+   * as a side effect.
+   */
+  BasicClause* create_clause(LitBuffer& lbuf, LINT clid = 0) {
+    sort(lbuf.begin(), lbuf.end(), AbsLitLess());
+    lbuf.resize(unique(lbuf.begin(), lbuf.end()) - lbuf.begin());
+    ULINT size = lbuf.size();
+    _sync_registry();
+    BasicClause* res = _clreg.lookup_lits(LitSpan(lbuf.begin(), size));
+    if (res != NULL) { // already there
+      lbuf.clear();
+      return res;
+    }
+    BasicClause *cl = _carena.make_clause(_lpool.commit(), size);
+    cl->mark_sorted();
+    if (clid != 0)
+      cl->set_id(clid);
+    _register_clause(cl);
+    return cl;
+  }
+
+  /* Sets the group id, and inserts the clause into group map; the clause is
+   * expected to be in the group set already (i.e. returned by add_clause() or
+   * create_clause()).
+   * TODO: should we allow same clause in the different group ? 
+   */
+  void set_cl_grp_id(BasicClause* ncl, GID gid) {
+    // if the clause already has gid, assume that we've already added it
+    if (ncl->get_grp_id() == gid_Undef) {
+      ncl->set_grp_id(gid);
+      if (_max_gid < gid) {
+        _max_gid = gid;
+        _gmap.resize(gid+1);
+      }
+      GroupInfo& gi = _gmap.at(gid);
+      if (!gi.used) { // new group
+        gi.used = true;
+        _gsize++;
+      }
+      gi.a_count++;
+      // extend the layout in place, if the clause is the first one outside of
+      // it, and its group is not below the last laid out group
+      if (_layout_ok && (_nlaid < _clvec.size()) && (_clvec[_nlaid] == ncl)
+          && (gid + 2 >= _goffs.size())) {
+        if (gid + 2 > _goffs.size())
+          _goffs.resize(gid + 2, _nlaid);
+        _goffs[gid + 1] = ++_nlaid;
+      } else
+        _layout_ok = false;
+    }
+  }
+
+  /* Groups the vector of clauses by GID (if it is not grouped already). This
+   * is done automatically on access to the groups, however in multi-threaded
+   * mode it must be called before the threads start.
+   */
+  void layout(void) {
+    if (_layout_ok)
+      return;
+    // stable counting sort; the clauses without a group go last
+    _goffs.assign(_max_gid + 2, 0);
+    for (BasicClause* cl : _clvec)
+      if (cl->get_grp_id() != gid_Undef)
+        ++_goffs[cl->get_grp_id() + 1];
+    for (size_t i = 1; i < _goffs.size(); ++i)
+      _goffs[i] += _goffs[i-1];
+    _nlaid = _goffs.back();
+    std::vector<ULINT> pos(_goffs.begin(), _goffs.end() - 1);
+    ULINT upos = _nlaid;
+    BasicClauseVector sorted(_clvec.size());
+    for (BasicClause* cl : _clvec) {
+      GID gid = cl->get_grp_id();
+      sorted[(gid != gid_Undef) ? pos[gid]++ : upos++] = cl;
+    }
+    _clvec.swap(sorted);
+    _layout_ok = true;
+  }
+
+public:         // Binary serialization
+
+  // The binary format is (native byte order, no padding):
+  //   BinHeader
+  //   uint64_t goffs[max_gid+2]  -- clauses of group g are goffs[g]..goffs[g+1]-1
+  //   uint64_t loffs[ncls+1]     -- literals of clause i are loffs[i]..loffs[i+1]-1
+  //   ULINT clids[ncls]          -- clause IDs
+  //   LINT lits[nlits]           -- literals, clause by clause
+  // The clauses without a group are not stored, and the removal status of
+  // the clauses is ignored.
+  static const char* bin_magic(void) { return "MUSGSET\x01"; }
+  enum { bin_version = 1 };
+  struct BinHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t max_var;
+    uint32_t max_gid;
+    uint32_t reserved;
+    uint64_t ncls;
+    uint64_t nlits;
+  };
+
+  /* Returns true if the first bytes of a file (at least 8) look like a binary
+   * group-set
+   */
+  static bool is_binary(const char* data, size_t size) {
+    return (size >= 8) && !memcmp(data, bin_magic(), 8);
+  }
+
+  /* Writes the group-set out in the binary format */
+  std::ostream& write_binary(std::ostream& out) {
+    layout();
+    BinHeader hdr;
+    memcpy(hdr.magic, bin_magic(), 8);
+    hdr.version = bin_version;
+    hdr.max_var = _max_var;
+    hdr.max_gid = _max_gid;
+    hdr.reserved = 0;
+    hdr.ncls = _nlaid;
+    hdr.nlits = 0;
+    for (ULINT i = 0; i < _nlaid; ++i)
+      hdr.nlits += _clvec[i]->size();
+    out.write((const char*)&hdr, sizeof(hdr));
+    for (GID gid = 0; gid <= _max_gid + 1; ++gid) {
+      uint64_t off = (gid < _goffs.size()) ? _goffs[gid] : _nlaid;
+      out.write((const char*)&off, sizeof(off));
+    }
+    uint64_t loff = 0;
+    out.write((const char*)&loff, sizeof(loff));
+    for (ULINT i = 0; i < _nlaid; ++i) {
+      loff += _clvec[i]->size();
+      out.write((const char*)&loff, sizeof(loff));
+    }
+    // the clause IDs are written densely, as 1..ncls, keeping their order
+    std::vector<ULINT> clids(_nlaid);
+    for (ULINT i = 0; i < _nlaid; ++i)
+      clids[i] = _clvec[i]->get_id();
+    std::vector<ULINT> sorted_ids(clids);
+    std::sort(sorted_ids.begin(), sorted_ids.end());
+    for (ULINT i = 0; i < _nlaid; ++i) {
+      ULINT clid = 1 + (std::lower_bound(sorted_ids.begin(), sorted_ids.end(), 
+                                         clids[i]) - sorted_ids.begin());
+      out.write((const char*)&clid, sizeof(clid));
+    }
+    for (ULINT i = 0; i < _nlaid; ++i)
+      out.write((const char*)_clvec[i]->lits(), 
+                _clvec[i]->size() * sizeof(LINT));
+    return out;
+  }
+
+  /* Populates the (empty) group-set from a binary file. The file is mapped
+   * into memory (read-only), and the clauses use the literals in place --
+   * there is no parsing, and the clauses are not put into the clause registry
+   * until it is needed; a clause copies its literals before changing them.
+   * Returns false if the file cannot be mapped, or is not a valid binary
+   * group-set. The counts in the header are bounded by the size of the file
+   * before any of the sections is located; the clause IDs must be distinct
+   * and in 1..ncls (as written by write_binary()), and the clauses must be
+   * sorted, with the literals within the number of variables.
+   */
+  bool load_binary(const char* fname) {
+    if (_size)
+      throw std::logic_error("BasicGroupSet::load_binary(): non-empty group-set");
+    int fd = open(fname, O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat st;
+    void* mem = MAP_FAILED;
+    if ((fstat(fd, &st) == 0) && ((size_t)st.st_size >= sizeof(BinHeader)))
+      mem = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED)
+      return false;
+    // check the header: every count is bounded by the size of the file (each
+    // item takes at least 4 bytes), and so the size of the sections can be
+    // computed with no overflow; the sections must add up to the file
+    const BinHeader* hdr = static_cast<const BinHeader*>(mem);
+    uint64_t fsize = st.st_size;
+    bool ok = is_binary(hdr->magic, sizeof(hdr->magic)) 
+      && (hdr->version == bin_version) && (hdr->max_var <= MAXLINT)
+      && ((uint64_t)hdr->max_gid < fsize / 8)
+      && (hdr->ncls < fsize / 8) && (hdr->nlits < fsize / 4)
+      && (sizeof(BinHeader) + ((uint64_t)hdr->max_gid + 2) * sizeof(uint64_t)
+          + (hdr->ncls + 1) * sizeof(uint64_t) + hdr->ncls * sizeof(ULINT)
+          + hdr->nlits * sizeof(LINT) == fsize);
+    const uint64_t* goffs = nullptr;
+    const uint64_t* loffs = nullptr;
+    const ULINT* clids = nullptr;
+    LINT* lits = nullptr;
+    if (ok) {
+      goffs = reinterpret_cast<const uint64_t*>(hdr + 1);
+      loffs = goffs + (uint64_t)hdr->max_gid + 2;
+      clids = reinterpret_cast<const ULINT*>(loffs + hdr->ncls + 1);
+      lits = const_cast<LINT*>(reinterpret_cast<const LINT*>(clids + hdr->ncls));
+      ok = (goffs[0] == 0) && (goffs[hdr->max_gid + 1] == hdr->ncls)
+        && (loffs[0] == 0) && (loffs[hdr->ncls] == hdr->nlits);
+    }
+    // check the offsets, the clause IDs, and the clauses: 0 < |lit| <= max_var,
+    // sorted by variable, each variable at most once per sign
+    for (GID gid = 0; ok && gid <= hdr->max_gid; ++gid)
+      ok = (goffs[gid] <= goffs[gid + 1]);
+    for (uint64_t i = 0; ok && i < hdr->ncls; ++i)
+      ok = (loffs[i] <= loffs[i + 1]);
+    std::vector<bool> seen_id(ok ? hdr->ncls + 1 : 0, false);
+    for (uint64_t i = 0; ok && i < hdr->ncls; ++i) {
+      ok = (clids[i] > 0) && (clids[i] <= hdr->ncls) && !seen_id[clids[i]];
+      if (ok)
+        seen_id[clids[i]] = true;
+      ULINT pvar = 0, ppvar = 0;
+      for (uint64_t j = loffs[i]; ok && j < loffs[i + 1]; ++j) {
+        ULINT var = (lits[j] > 0) ? (ULINT)lits[j] : -(ULINT)lits[j];
+        ok = (var != 0) && (var <= hdr->max_var) && (pvar <= var)
+          && ((pvar < var) || ((lits[j] == -lits[j - 1]) && (ppvar < var)));
+        ppvar = pvar;
+        pvar = var;
+      }
+    }
+    if (!ok) {
+      munmap(mem, st.st_size);
+      return false;
+    }
+    _lpool.adopt_mapping(mem, st.st_size);
+    _reg_deferred = true;
+    set_num_vars(hdr->max_var);
+    _clvec.reserve(hdr->ncls);
+    _gmap.reserve(hdr->max_gid + 1);
+    _goffs.reserve(hdr->max_gid + 2);
+    ULINT max_clid = 0;
+    for (GID gid = 0; gid <= hdr->max_gid; ++gid) {
+      for (uint64_t i = goffs[gid]; i < goffs[gid + 1]; ++i) {
+        BasicClause* cl = 
+          _carena.make_clause(lits + loffs[i], loffs[i + 1] - loffs[i]);
+        cl->mark_ro_lits();
+        cl->mark_sorted();
+        cl->set_id(clids[i]);
+        max_clid = std::max(max_clid, clids[i]);
+        _register_clause(cl);
+        set_cl_grp_id(cl, gid);
+      }
+    }
+    // the clause IDs created from now on should not clash with the loaded
+    while (ClauseIdManager::Instance()->id() <= max_clid)
+      ClauseIdManager::Instance()->new_id();
+    return true;
+  }
+
+protected:
+
+  /* Puts the clauses into the registry, if it was deferred by load_binary() */
+  void _sync_registry(void) {
+    if (_reg_deferred) {
+      _clreg.reserve(_clvec.size());
+      for (BasicClause* cl : _clvec)
+        _clreg.register_clause(cl);
+      _reg_deferred = false;
+    }
+  }
+
+  /* Puts a new clause into the group set datastructures */
+  void _register_clause(BasicClause* cl) {
     _clvec.push_back(cl);
     _size++;
     if (cl->size()) {
@@ -430,58 +923,34 @@ public:    // Creation and addition of clauses (note that create_clause is used
     }
     if (cl->get_id() > _max_id) // update max_id
       _max_id = cl->get_id(); 
-    if (has_occs_list()) {         // update the list 
-      for (Literator lpos = cl->begin(); lpos != cl->end(); ++lpos) {
-        _poccs_list->clauses(*lpos).push_back(cl);
-        ++(_poccs_list->active_size(*lpos));
-      }
-    }
+    if (has_occs_list())           // update the list 
+      _poccs_list->add_clause(cl);
     if (_store_units && cl->size() == 1) // remember units
       _units.push_back(cl);
-    _clreg.register_clause(cl);
-    return cl;
+    if (!_reg_deferred)
+      _clreg.register_clause(cl);
   }
 
-  /* Creates and inserts a new clause into group set; when clid != 0, the
-   * clause id will be set to be clid. If an identical clause has already 
-   * been added its returned instead, clid is always ignored in this case.
-   */
-  BasicClause* create_clause(vector<LINT>& clits, LINT clid = 0) {
-    return add_clause(make_clause(clits, clid));
-  }
-
-  /* Sets the group id, and inserts the clause into group map 
-   * TODO: should we allow same clause in the different group ? 
-   */
-  void set_cl_grp_id(BasicClause* ncl, GID gid) {
-    // if the clause already has gid, assume that we've already added it
-    if (ncl->get_grp_id() == gid_Undef) {
-      ncl->set_grp_id(gid);
-      if (_max_gid < gid) {
-        _max_gid = gid;
-        _gmap.resize(gid+1, NULL);
-      }
-      GroupInfo*& gi = _gmap.at(gid);
-      if (gi == NULL) { // new group
-        gi = new GroupInfo();
-        _gsize++;
-      }
-      gi->content.push_back(ncl);
-      gi->a_count++;
-    }
+  /* Destroys all clauses that are not owned by the arena */
+  void _destroy_clauses(void) {
+    for (BasicClause* cl : _clvec)
+      if (!cl->pooled())
+        delete cl;
   }
 
 public:         // Presudo-removal of clauses and groups 
 
   /* Pseudo-removes the group from the groupset -- i.e. pseudo-removes all
-   * of its clauses (see below).
+   * of its clauses (see below). This is also the point where the occs lists
+   * are compacted, once enough of their clauses are gone.
    */
   void remove_group(GID gid) {
     // mark the clauses as removed (and update counts in the occlist)
-    BasicClauseVector& clv = gclauses(gid);
-    for (auto cl : clv)
+    for (BasicClause* cl : gclauses(gid))
       if (!cl->removed())
         remove_clause(cl);
+    if (has_occs_list())
+      _poccs_list->maybe_compact();
   }
 
   /* Pseudo-removes the clause from the groupset: the clause is marked removed, 
@@ -508,8 +977,9 @@ public:         // Presudo-removal of clauses and groups
     }
   }
 
-  /* Simply frees the memory for the clause: this is the inverse of make_clause */
-  void destroy_clause(BasicClause* cl) { delete cl; }
+  /* Simply frees the memory for the clause: this is the inverse of make_clause;
+   * the clauses in the arena are left alone. */
+  void destroy_clause(BasicClause* cl) { if (!cl->pooled()) delete cl; }
 
 public:    // Access to clauses
 
@@ -523,31 +993,37 @@ public:    // Access to clauses
 
 public:    // Access to non-empty groups of clauses - via custom iterator
 
-  typedef gmap_iter_tmpl<GIDMap, BasicClauseVector> gset_iterator;
+  typedef gset_iter gset_iterator;
 
   /* Iterator to the first non-empty group */
-  gset_iterator gbegin(void) { return gset_iterator(_gmap, _gmap.begin()); }
+  gset_iterator gbegin(void) { return gset_iterator(*this, 0); }
 
   /* Iterator past the last non-empty group */
-  gset_iterator gend(void) { return gset_iterator(_gmap, _gmap.end()); }
+  gset_iterator gend(void) { return gset_iterator(*this, _gmap.size()); }
 
   /* True if the group is a non-empty group in the group set
    */
-  bool gexists(GID gid) const { return (gid <= _max_gid) && (_gmap[gid] != NULL); }
+  bool gexists(GID gid) const { return (gid <= _max_gid) && _gmap[gid].used; }
 
   /* Returns true if the group set has g0 */
   bool has_g0(void) const { return gexists(0); }
 
-  /* Returns a reference to the vector of clauses for the specified group ID, 
-   * throws std::out_of_range if group ID does not exist
+  /* Returns the range of clauses for the specified group ID, throws 
+   * std::out_of_range if group ID does not exist; the range is valid until
+   * the next change to the groups (see note 6 at the top of the file)
    */
-  BasicClauseVector& gclauses(GID gid) {
-    GroupInfo* pgi = NULL;
-    if ((gid > _max_gid) || ((pgi = _gmap[gid]) == NULL))
+  ClauseRange gclauses(GID gid) {
+    if (!gexists(gid))
       throw std::out_of_range("non-existent group");
-    return pgi->content;
+    // NOTE: this re-orders _clvec by GID (if not grouped yet), and so changes
+    // the order in which begin()/end() iterate over all clauses
+    layout();
+    if (gid + 1 >= _goffs.size())
+      return ClauseRange();
+    BasicClause* const* base = _clvec.data();
+    return ClauseRange(base + _goffs[gid], base + _goffs[gid + 1]);
   }
-  const BasicClauseVector& gclauses(GID gid) const { 
+  ClauseRange gclauses(GID gid) const { 
     return const_cast<BasicGroupSet*>(this)->gclauses(gid); 
   }
 
@@ -555,10 +1031,9 @@ public:    // Access to non-empty groups of clauses - via custom iterator
    * ID, throws std::out_of_range if group ID does not exist
    */
   ULINT& a_count(GID gid) {
-    GroupInfo* pgi = NULL;
-    if ((gid > _max_gid) || ((pgi = _gmap[gid]) == NULL))
+    if (!gexists(gid))
       throw std::out_of_range("non-existent group");
-    return pgi->a_count;
+    return _gmap[gid].a_count;
   }
   const ULINT& a_count(GID gid) const { 
     return const_cast<BasicGroupSet*>(this)->a_count(gid); 
@@ -652,14 +1127,19 @@ public:  // Methods called from parsers to pass on the info from input files
   void set_num_cls(ULINT ncls) {        // reserve space
     if (_mode) {
       _clvec.reserve(ncls);
-      if (_mode == 1)
+      _clreg.reserve(ncls);
+      if (_mode == 1) {
         _gmap.reserve(ncls+1);
+        _goffs.reserve(ncls+2);
+      }
     }
   }      
 
   void set_num_grp(XLINT ngrp) {        // reserve space
-    if (_mode == 2)
+    if (_mode == 2) {
       _gmap.reserve(ngrp+1);
+      _goffs.reserve(ngrp+2);
+    }
   }
   
   void set_num_vgrp(ULINT nvgrp) {       // reserve space
@@ -672,8 +1152,8 @@ public:    // Output functions
   void dump(std::ostream& out=std::cout) const {
     BasicGroupSet* ths = const_cast<BasicGroupSet*>(this);
     for (gset_iterator pg = ths->gbegin(); pg != ths->gend(); ++pg) {
-      BasicClauseVector& cls = pg.gclauses();
-      for (ClVectIterator pc = cls.begin(); pc != cls.end(); ++pc) {
+      ClauseRange cls = pg.gclauses();
+      for (crange_iterator pc = cls.begin(); pc != cls.end(); ++pc) {
         out << "[gid=" << *pg << "] "; (*pc)->dump(out); out << std::endl;
       }
     }
@@ -710,9 +1190,22 @@ protected:
 
   ClauseRegistry _clreg;   // clause registry (personal copy) 
 
-  BasicClauseVector _clvec;// vector of all clauses
+  LitPool _lpool;          // literals of all clauses
+
+  ClauseArena _carena;     // clauses created here
+
+  BasicClauseVector _clvec;// vector of all clauses, grouped by GID (see note 6)
+
+  GIDMap _gmap;            // index = GID, value = GroupInfo
+
+  std::vector<ULINT> _goffs;// index = GID, clauses of GID are in 
+                           // _clvec[_goffs[GID] .. _goffs[GID+1]-1]
+
+  ULINT _nlaid = 0;        // number of clauses covered by _goffs
+
+  bool _layout_ok = true;  // false if _goffs needs to be re-built
 
-  GIDMap _gmap;            // index = GID, value = GroupInfo (vector of clauses + ...)
+  bool _reg_deferred = false; // true if the clauses are not in _clreg yet
 
   GID _max_gid = 0;        // maximum GID
 
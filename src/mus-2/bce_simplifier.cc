@@ -112,12 +112,8 @@ void BCESimplifier::simplify(BasicClauseSet& clset)
 {
   OccsList occs;
   occs.resize(clset.get_max_var() + 1);
-  for (BasicClause* cl : clset) {
-    for (LINT lit : *cl) {
-      occs.clauses(lit).push_back(cl);
-      ++(occs.active_size(lit));
-    }
-  }
+  for (BasicClause* cl : clset)
+    occs.add_clause(cl);
   simplify(occs, nullptr, &clset);
   // done
 }
@@ -148,48 +144,23 @@ void BCESimplifier::simplify(OccsList& o_list, SimplifyBCE* psb, BasicClauseSet*
   while(!t_queue.empty()) {
     int lit_i = t_queue.removeMin_i();
     LINT lit = OccsList::i2l(lit_i);
-    BasicClauseList& cands = o_list.clauses_i(lit_i);
     NDBG(cout << "Checking literal " << lit
         << "(-occ=" << o_list.active_size_i(lit_i^1)
         << ",+occ=" << o_list.active_size_i(lit_i) << ")" << endl;);
-    for(BasicClauseList::iterator pcand = cands.begin(); pcand != cands.end(); ) {
-      BasicClause* cand =  *pcand; // candidate clause
+    // note: the removed clauses are skipped by the iterators of the occs
+    // list, but stay in it, so that with move2g0 they can be "unremoved"
+    for (BasicClause* cand : o_list.clauses_i(lit_i)) {
       NDBG(cout << "  candidate clause: "; cand->dump(); cout << endl;);
-      if (cand->removed()) {
-        // known to be removed (lazily); remove from map, unless move2g0 is true,
-        // and the clause is in g0
-        if (move2g0 && cand->get_grp_id() == 0)
-          ++pcand;
-        else
-          pcand = cands.erase(pcand);
-        NDBG(cout << "  removed earlier." << endl;);
-        continue;
-      }
       if (ig0 && cand->get_grp_id() == 0) {
         NDBG(cout << "  candidate clause is in g0, ignoring" << endl;);
-        ++pcand;
         continue;
       }
       // inner loop -- look for non-taut resolvent among clashing clauses
       bool found = false;
-      BasicClauseList& clashes = o_list.clauses_i(lit_i^1);
-      for (BasicClauseList::iterator pclash = clashes.begin();
-           pclash != clashes.end(); ) {
-        BasicClause* clash = *pclash;
+      for (BasicClause* clash : o_list.clauses_i(lit_i^1)) {
         NDBG(cout << "      clash: "; clash->dump(); cout << endl;);
-        if (clash->removed()) {
-          // known to be removed (lazily); remove from map, unless move2g0 is
-          // true, and the clause is in g0
-          if (move2g0 && cand->get_grp_id() == 0)
-            ++pclash;
-          else
-            pclash = clashes.erase(pclash);
-          NDBG(cout << "      removed earlier." << endl;);
-          continue;
-        }
         if (ig0 && clash->get_grp_id() == 0) {
           NDBG(cout << "      clash is in g0, ignoring" << endl;);
-          ++pclash;
           continue;
         }
         if (!taut_resolvent(cand, clash, lit)) {
@@ -198,30 +169,24 @@ void BCESimplifier::simplify(OccsList& o_list, SimplifyBCE* psb, BasicClauseSet*
           break;
         }
         NDBG(cout << "      tautological; continuing checking." << endl;);
-        ++pclash;
       }
       if (found) {
         NDBG(cout << "    non-tautological resolvent found, clause is not blocked."
             << endl;);
-        ++pcand;
       } else {
         NDBG(cout << "  all resolvents are tautological, clause is BLOCKED."
             << endl;);
-        // note that we're not going to clean up the map completely - just mark
-        // the clause removed, remove it from cands list, and remove it from the
-        // group-set; later on marked clauses will be dropped from the map
-        // automatically
+        // note that we're not going to clean up the map - just mark the 
+        // clause removed, and remove it from the group-set; the iterators of
+        // the map skip the marked clauses
         cand->mark_removed();
-        if (move2g0) {
+        if (move2g0)
           r_cls.push_back(cand); // to "unremove" it later
-          ++pcand;
-        } else
-          pcand = cands.erase(pcand);
         GID cand_gid = cand->get_grp_id();
         if (psb != nullptr) {
           if (!move2g0 || (move2g0 && cand_gid != 0)) {
             if (--(psb->md().gset().a_count(cand_gid)) == 0) { // group is gone
-              psb->md().r_gids().insert(cand_gid);
+              psb->md().set_removed(cand_gid);
               psb->md().r_list().push_front(cand_gid);
               ++psb->rg_count();
             }
@@ -125,35 +125,24 @@ bool BCPSimplifier::process(SimplifyBCP& sb)
         else { cout << "reason: "; vd.reason->dump(); cout << endl; });
     // SAT clauses: all clauses with lit are satisfied -- remove them, and 
     // clean up the list on the way ...
-    BasicClauseList& sclauses = o_list.clauses(lit);
-    for (BasicClauseList::iterator pscl = sclauses.begin(); pscl != sclauses.end(); ) {
-      BasicClause* scl = *pscl;
-      if (!scl->removed()) {
-        DBG(cout << "    clause "; scl->dump(); cout << " is SAT; removing." << endl;);
-        scl->mark_removed();
-        o_list.update_active_sizes(scl);
-        ++sb.rcl_count();
-        GID gid = scl->get_grp_id();
-        if (--(gs.a_count(gid)) == 0) { // group is gone
-          md.r_gids().insert(gid);
-          md.r_list().push_front(gid);
-          ++sb.rg_count();
-        }       
-      }
-      pscl = sclauses.erase(pscl);
+    for (BasicClause* scl : o_list.clauses(lit)) {
+      DBG(cout << "    clause "; scl->dump(); cout << " is SAT; removing." << endl;);
+      scl->mark_removed();
+      o_list.update_active_sizes(scl);
+      ++sb.rcl_count();
+      GID gid = scl->get_grp_id();
+      if (--(gs.a_count(gid)) == 0) { // group is gone
+        md.set_removed(gid);
+        md.r_list().push_front(gid);
+        ++sb.rg_count();
+      }       
     }
+    o_list.clear(lit);
     // Clauses with -lit need to be updated. Update happens as follows:
     //  - the clause is shrunk by one literal
     //  - if the clause is now unit *and* is allowed to propagate, then enqueue
-    BasicClauseList& clauses = o_list.clauses(-lit);    
-    for (BasicClauseList::iterator pcl = clauses.begin(); pcl != clauses.end(); ) {
-      BasicClause* cl = *pcl;
+    for (BasicClause* cl : o_list.clauses(-lit)) { // skips removed clauses
       DBG(cout << "    checking "; cl->dump(); cout << ": " << flush;);
-      if (cl->removed()) {
-        DBG(cout << "removed earlier, skipping" << endl;);
-        pcl = clauses.erase(pcl);
-        continue;
-      }
       assert(cl->asize() > 0);
       // Note: it is possible that the active size of clause is 1. However,
       // this may only happen in group mode with a non-g0 clause -- if this
@@ -162,6 +151,7 @@ bool BCPSimplifier::process(SimplifyBCP& sb)
       // is necessary, we're just going to shrink the clause to size 0.
       assert(!(cl->asize() == 1) || (group_mode && cl->get_grp_id()));
       // shrink the clause: move the false literal (-lit) towards the end
+      cl->own_lits(); // the literals might be read-only
       Literator pf = cl->abegin(); // find false literal
       while (pf != cl->aend() && *pf != -lit) ++pf;
       assert(pf != cl->aend()); 
@@ -193,12 +183,11 @@ bool BCPSimplifier::process(SimplifyBCP& sb)
         DBG(cout << ((res == 1) ? " done." : " already assigned, skipped") << endl;);
       }
       // done with this clause        
-      ++pcl;
     }
     // neither lit nor -lit does not occur anywhere anymore (lit is done already)
     assert(o_list.clauses(lit).empty());
     assert(o_list.active_size(lit) == 0);
-    o_list.clauses(-lit).clear(); 
+    o_list.clear(-lit);
     o_list.active_size(-lit) = 0;
     // done with lit
     p_queue.pop();
@@ -227,7 +216,7 @@ void BCPSimplifier::reconstruct_solution(SimplifyBCP& sb)
     // clause is the output MUS
     md.make_empty_gmus();
     if (!sb.group_mode()) { // the only clause is the conflict clause
-      md.nec_gids().insert(sb.conflict_clause()->get_id());
+      md.set_necessary(sb.conflict_clause()->get_id());
       DBG(cout << "  top-level conflict, left only: "; 
           sb.conflict_clause()->dump(); cout << endl;);
     }
@@ -258,8 +247,7 @@ void BCPSimplifier::reconstruct_solution(SimplifyBCP& sb)
     pcl->restore();
     pcl->mark_unsorted(); // probably
     pcl->unmark_removed();
-    md.r_gids().erase(pcl->get_grp_id()); // for handling conflict (empty MUS)
-    md.nec_gids().insert(pcl->get_grp_id());
+    md.set_necessary(pcl->get_grp_id()); // for handling conflict (empty MUS)
     q.pop();
   }
   // done
@@ -12,7 +12,9 @@
 #ifndef _BLOCK_SCHEDULER_MT_HH
 #define _BLOCK_SCHEDULER_MT_HH 1
 
-#include <tbb/concurrent_queue.h>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include "basic_group_set.hh"
 #include "group_scheduler.hh"
 #include "mus_data_mt.hh"
@@ -24,7 +26,7 @@
  *          the GID list into the number of blocks that matches the number of 
  *          workers, and gives out groups from these blocks. If a block for a 
  *          particular worker is empty, it takes them from the next non-empty 
- *          block. This implementation uses concurrent_queue from TBB.
+ *          block. Each block has its own mutex.
  *
  * Notes:
  *      1. No fasttrack() yet.
@@ -38,7 +40,8 @@ public:
 
   /** In principle an instance of MUSData and total number of workers is enough */
   BlockSchedulerMT(MUSData& md, unsigned num_workers = 1)
-    : GroupScheduler(md, num_workers), _q(num_workers) {
+    : GroupScheduler(md, num_workers), _q(num_workers), 
+      _mtx(new std::mutex[num_workers]) {
     // populate the queue
     int cutoff = 0;
     int w_idx = -1;
@@ -49,7 +52,7 @@ public:
         w_idx++;
       }
       if (*pg != 0)
-        _q[w_idx].push(*pg);
+        _q[w_idx].push_back(*pg);
     }
   }
 
@@ -57,27 +60,37 @@ public:
    * [0,num_workers) if there's more groups; otherwise false
    */
   virtual bool next_group(GID& next_gid, unsigned worker_id) {
-    bool res = _q[worker_id].try_pop(next_gid);
-    if (!res) {
-      // scan for anything ...
-      for (unsigned id = 0; id < _num_workers; id++)
-        if (res = _q[id].try_pop(next_gid))
-          break;
-    }
-    return res;
+    if (try_pop(worker_id, next_gid))
+      return true;
+    // scan for anything ...
+    for (unsigned id = 0; id < _num_workers; id++)
+      if (try_pop(id, next_gid))
+        return true;
+    return false;
   }
 
   /** This allows users to re-schedule a group ID check - the invariant is that
    * after this call next_group will give out the gid at some point
-   * TODO: there's a potential race here -- figure it out
    */
   virtual void reschedule(GID gid) {
-    _q[_num_workers-1].push(gid);
+    std::lock_guard<std::mutex> lk(_mtx[_num_workers-1]);
+    _q[_num_workers-1].push_back(gid);
   }
 
 private:
 
-  vector<tbb::concurrent_queue<GID> > _q;  // queues with GIDs
+  bool try_pop(unsigned idx, GID& next_gid) {
+    std::lock_guard<std::mutex> lk(_mtx[idx]);
+    if (_q[idx].empty())
+      return false;
+    next_gid = _q[idx].front();
+    _q[idx].pop_front();
+    return true;
+  }
+
+  vector<std::deque<GID> > _q;               // queues with GIDs
+
+  std::unique_ptr<std::mutex[]> _mtx;        // one mutex per queue
 
 };
 
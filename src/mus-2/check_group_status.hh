@@ -68,6 +68,10 @@ public:     // Parameters
   float cpu_limit(void) const { return _cpu_limit; }
   void set_cpu_limit(float cl) { _cpu_limit = cl; }
 
+  /* Wall-clock limit for this call (secs); 0 = no limit */
+  float wc_limit(void) const { return _wc_limit; }
+  void set_wc_limit(float wl) { _wc_limit = wl; }
+
 public:     // Results
 
   /* True if necessary, false if not */
@@ -76,8 +80,8 @@ public:     // Results
 
   /* If not necessary, will contain the gid of the group, plus some more if 
    * refine() is true, and use_rr() did not get in the way */
-  const GIDSet& unnec_gids(void) const { return _unnec_gids; }
-  GIDSet& unnec_gids(void) { return _unnec_gids; }
+  const DenseGIDSet& unnec_gids(void) const { return _unnec_gids; }
+  DenseGIDSet& unnec_gids(void) { return _unnec_gids; }
 
   /* If nesessary and need_model() is true, this will refer to the model */
   const IntVector& model(void) const { return _model; }
@@ -88,22 +92,30 @@ public:     // Results
   const unsigned& version(void) const { return _version; }
   void set_version(unsigned version) { _version = version; }
 
+  /* Returns the number of removed groups in MUSData at the time version() was
+   * taken -- the groups removed since are the first (md.r_list().size() - 
+   * r_count()) elements of md.r_list() */
+  size_t r_count(void) const { return _r_count; }
+  void set_r_count(size_t r_count) { _r_count = r_count; }
+
   /* If true, rr got in a way of refinement */
   const bool& tainted_core(void) const { return _tcore; }
   bool& tainted_core(void) { return _tcore; }
 
-  /* Returns a read-only pointer to the core (all the way into SAT solver),
-   * or nullptr if the outcome was SAT.
+  /* Returns a read-only pointer to the core (all the way into SAT solver);
+   * the core is empty if the outcome was SAT.
    */
-  const GIDSet* pcore(void) { return &_core; }
-  void set_pcore(const GIDSet* pcore) {
-    _core.clear(); if (pcore != nullptr) _core = *pcore; } // TEMP slow !!!!
+  const DenseGIDSet* pcore(void) { return &_core; }
+  /* Takes over the contents of *pcore (which gets the previous core, i.e.
+   * garbage), or clears the core if pcore is nullptr */
+  void set_pcore(DenseGIDSet* pcore) {
+    if (pcore != nullptr) _core.swap(*pcore); else _core.clear(); }
 
 public:     // Reset/recycle
 
   virtual void reset(void) {
     WorkItem::reset(); _status = false; _unnec_gids.clear();
-    _model.clear(); _version = 0; _tcore = false;
+    _model.clear(); _version = 0; _r_count = 0; _tcore = false;
   }
 
 protected:
@@ -126,20 +138,23 @@ protected:
 
   float _cpu_limit = 0.0f;                   // cpu limit for this call
 
+  float _wc_limit = 0.0f;                    // wall-clock limit for this call
+
   // results
 
   bool _status = false;                      // true if SAT, false if not
 
-  GIDSet _unnec_gids;                        // GIDs of unnecessary groups
+  DenseGIDSet _unnec_gids;                   // GIDs of unnecessary groups
 
   IntVector _model;                          // model (if SAT and asked for it)
 
   unsigned _version;                         // the version of MUSData this result is for
 
+  size_t _r_count = 0;                       // size of r_list() at _version
+
   bool _tcore;                               // when true, rr got in a way of refinement
 
-  GIDSet _core;                              // TEMP: make direct access ! pointer to the most recent core
-                                             // or nullptr if outcome was SAT
+  DenseGIDSet _core;                         // the most recent core (empty if SAT)
 };
 
 #endif /* _CHECK_GROUP_STATUS_H */
@@ -74,8 +74,8 @@ public:     // Results
 
   /* If not necessary, will contain the gid of the group, plus some more gids
    * from the chunk if refine() is true. */
-  const GIDSet& unnec_gids(void) const { return _unnec_gids; }
-  GIDSet& unnec_gids(void) { return _unnec_gids; }
+  const DenseGIDSet& unnec_gids(void) const { return _unnec_gids; }
+  DenseGIDSet& unnec_gids(void) { return _unnec_gids; }
 
   /* If nesessary and need_model() is true, this will refer to the model */
   const IntVector& model(void) const { return _model; }
@@ -113,7 +113,7 @@ protected:
 
   bool _status;                              // true if SAT, false if not
 
-  GIDSet _unnec_gids;                        // GIDs of unnecessary groups
+  DenseGIDSet _unnec_gids;                   // GIDs of unnecessary groups
 
   IntVector _model;                          // model (if SAT and asked for it)
 
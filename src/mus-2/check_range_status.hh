@@ -86,8 +86,8 @@ public:     // Results
 
   /* If not necessary, will contain the gids of the subset, plus some more 
    * gids from the remainder if refine() is true. */
-  const GIDSet& unnec_gids(void) const { return _unnec_gids; }
-  GIDSet& unnec_gids(void) { return _unnec_gids; }
+  const DenseGIDSet& unnec_gids(void) const { return _unnec_gids; }
+  DenseGIDSet& unnec_gids(void) { return _unnec_gids; }
 
   /* If nesessary and need_model() is true, this will refer to the model */
   const IntVector& model(void) const { return this->model(); }
@@ -128,7 +128,7 @@ protected:
 
   bool _status = false;                      // true if SAT, false if not
 
-  GIDSet _unnec_gids;                        // GIDs of unnecessary groups among
+  DenseGIDSet _unnec_gids;                   // GIDs of unnecessary groups among
                                              // those in the range
 
   IntVector _model;                          // model (if SAT and asked for it)
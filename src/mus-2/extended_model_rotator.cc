@@ -18,6 +18,7 @@
 //#undef NDEBUG // enable assertions (careful !)
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <ext/hash_set>
 #include <iostream>
@@ -26,6 +27,8 @@
 #include "basic_group_set.hh"
 #include "types.hh"
 #include "model_rotator.hh"
+#include "packed_assignment.hh"
+#include "rotation_counters.hh"
 
 using namespace std;
 using namespace __gnu_cxx;
@@ -61,24 +64,13 @@ namespace {
   // Updates the hash-value to match a flip of the specified variable
   void ass_hash_flip(AHASH& ass_hash, ULINT var);
 
-  // Flips a variable in the assignment
-  void flip(IntVector& ass, ULINT var);
-
-  // Returns the truth-value of clause under assignment: -1;0:+1
-  int tv_clause(IntVector& ass, const BasicClause* cl);
-
-  // Checks whether a given assignment satisfies a set of clauses; return 1 for SAT, -1
-  // for UNSAT, 0 for undetermined. A set is SAT iff all clauses are SAT, a set
-  // is UNSAT iff at least one clause is UNSAT, undetermined otherwise
-  int tv_group(IntVector& ass, const BasicClauseVector& clauses);
-  
   // This is the decision-maker on whether to rotate through a groupset or not;
   // If true - the groupset will be rotated at the given assignment (i.e. the
   // neighbours of the assignment will be added to the queue); o/w not; note that 
   // this (with the help of da_map) superseedes the checks for whether or not a 
   // group is locally or globally necessary, because *all* necessary groups will 
   // end up in da_map
-  bool allow_to_rotate(GIDSet& gids, IntVector& ass, AHASH& hash, 
+  bool allow_to_rotate(GIDSet& gids, const IntVector& ass, AHASH& hash, 
                        unsigned rdepth, unsigned rwidth)
   {
     DBG(cout << "  allow_to_rotate(): checking gids=" << gids
@@ -141,9 +133,8 @@ bool ExtendedModelRotator::process(RotateModel& rm)
   DBG(unsigned n_count = 0;);
   DBG(unsigned p_count = 0;);
 
-#ifdef MULTI_THREADED
-  throw logic_error("ExtendedModelRotator::process() is not ready for multi-threaded mode.");
-#endif
+  // NOTE: in multi-threaded mode the caller holds the read-lock on MUSData for
+  // the duration of the call, so the occs lists are not cleaned up on the way.
 
   DBG(cout << "+ExtendedModelRotator::process(" << gid << "), (d,w) = " 
       << rdepth << "," << rwidth << endl;);
@@ -157,9 +148,12 @@ bool ExtendedModelRotator::process(RotateModel& rm)
 
   // the first entry (delta is empty)
   rot_queue.push(rot_queue_entry(gid));
-  // a copy of the original model -- will be used as working assignment.
-  IntVector curr_ass(orig_model);
+  // the working assignment (starts as the original model), with the counters
+  // of false clauses -- a flip costs O(occs(var))
+  _rc.reset(gs, orig_model);
+  const IntVector& curr_ass = _rc.ass();
   AHASH curr_ass_hash = ass_hash(curr_ass);
+  start_points(orig_model);
   while (!rot_queue.empty()) {
     rot_queue_entry& e = rot_queue.front();
     GIDSet& gids = e._gids;
@@ -169,7 +163,7 @@ bool ExtendedModelRotator::process(RotateModel& rm)
     DBG(cout << ", delta: ";);
     for (list<ULINT>::iterator pv = e._delta.begin(); pv != e._delta.end(); ++pv) {
       DBG(cout << *pv << " ";);
-      flip(curr_ass, *pv);
+      _rc.flip(*pv);
       ass_hash_flip(curr_ass_hash, *pv);
     }
     DBG(cout << endl;);
@@ -177,6 +171,8 @@ bool ExtendedModelRotator::process(RotateModel& rm)
     // see if we're allowed to proceed
     if (!allow_to_rotate(gids, curr_ass, curr_ass_hash, rdepth, rwidth)) {
       DBG(cout << "  not allowed to rotate." << endl;);
+    } else if (seen_point(RotationCache::gids_key(gids), e._delta)) {
+      DBG(cout << "  visited already (in this or an earlier call)." << endl;);
     } else {
       // ok, we're ready to roll:
       //   1. double-check that curr_model falsifies gid (in checked mode)
@@ -191,14 +187,14 @@ bool ExtendedModelRotator::process(RotateModel& rm)
       BasicClauseVector f_clauses;
       f_clauses.reserve(1000);
       for (GIDSet::iterator pgid = gids.begin(); pgid != gids.end(); ++pgid) {
-        const BasicClauseVector& gclauses = gs.gclauses(*pgid);	
+        ClauseRange gclauses = gs.gclauses(*pgid);	
         // collect the currently falsified clauses and their variables 
         DBG(cout << "  Group " << *pgid 
             << ((gclauses.size() < 100) ? " " : " UNSAT ") << "clauses:";);
-        for (cvec_citerator pcl = gclauses.begin(); pcl != gclauses.end(); ++pcl) {
+        for (crange_iterator pcl = gclauses.begin(); pcl != gclauses.end(); ++pcl) {
           if ((*pcl)->removed()) 
             continue;
-          if (tv_clause(curr_ass, *pcl) == -1) {
+          if (_rc.is_false(*pcl)) {
             f_clauses.push_back(*pcl);
             for(CLiterator lpos = (*pcl)->abegin(); lpos != (*pcl)->aend(); ++lpos)
               cand_vars.insert(abs(*lpos));
@@ -212,55 +208,61 @@ bool ExtendedModelRotator::process(RotateModel& rm)
           << cand_vars.size() << " variables." << endl;);
       assert(!cand_vars.empty()); // must be non-empty, o/w gid is not UNSAT !
 
-      // now, for each candidate -- flip and calculate the set of falsified group
-      // ids -- this set will go into the queue
-      for (IntSet::iterator pv = cand_vars.begin(); pv != cand_vars.end(); ++pv) {
-        LINT lit = *pv * curr_ass[*pv]; // clauses with lit might become falsified
-        flip(curr_ass, *pv);
-        ass_hash_flip(curr_ass_hash, *pv);
-        DBG(cout << "  Checking var " << *pv << ", assigned " << curr_ass[*pv] << ": ";);
-        GIDSet new_gids; // these will be falsified gids
-        // first, run through false clauses, and for any clause that is still false,
-        // add it to new_gids;
-        for (cvec_citerator pcl = f_clauses.begin(); pcl != f_clauses.end(); ++pcl)
-          if (tv_clause(curr_ass, *pcl) == -1)
-            new_gids.insert((*pcl)->get_grp_id());
-        // now, run through the clauses that contain lit, and for any clause that
-        // *became* falsified due to the flip, add its gid also to new_gids
-        // early break: if we still have rwidth false gids, no point to check anymore 
-        // since it will stay the same, or increase ...
-        if (new_gids.size() <= rwidth) {
-          BasicClauseList& lclauses = o_list.clauses(lit);
-          for (BasicClauseList::iterator pcl = lclauses.begin(); pcl != lclauses.end(); ) {
-            if ((*pcl)->removed()) { // clause is removed, update occslist
-              pcl = lclauses.erase(pcl);
-              continue;
+      // now, for each candidate -- calculate the set of falsified group ids under
+      // the flip -- this set will go into the queue; the candidates are evaluated
+      // in batches of up to 64 flips, one per lane of _pa, on top of the working
+      // assignment (which stays put)
+      vector<ULINT> cands(cand_vars.begin(), cand_vars.end());
+      vector<PackedAssignment::Word> f_false(f_clauses.size());
+      for (size_t beg = 0; beg < cands.size(); beg += PackedAssignment::max_lanes) {
+        size_t end = min(cands.size(), beg + PackedAssignment::max_lanes);
+        _pa.set_lanes(curr_ass, cands.begin() + beg, cands.begin() + end);
+        // the lanes in which each of the false clauses stays false
+        for (size_t i = 0; i < f_clauses.size(); ++i)
+          f_false[i] = _pa.false_lanes(f_clauses[i]);
+        for (unsigned k = 0; k < _pa.num_lanes(); ++k) {
+          PackedAssignment::Word bit = (PackedAssignment::Word)1 << k;
+          ULINT var = _pa.lane_var(k);
+          LINT lit = var * curr_ass[var]; // clauses with lit might become falsified
+          AHASH lane_hash = curr_ass_hash;
+          ass_hash_flip(lane_hash, var);
+          DBG(cout << "  Checking var " << var << ", assigned " << -curr_ass[var] << ": ";);
+          GIDSet new_gids; // these will be falsified gids
+          // first, run through false clauses, and for any clause that is still false,
+          // add it to new_gids;
+          for (size_t i = 0; i < f_clauses.size(); ++i)
+            if (f_false[i] & bit)
+              new_gids.insert(f_clauses[i]->get_grp_id());
+          // now, run through the clauses that contain lit, and for any clause that
+          // *became* falsified due to the flip, add its gid also to new_gids; only
+          // the clauses where lit is the only non-false literal need a look
+          // early break: if we still have rwidth false gids, no point to check anymore 
+          // since it will stay the same, or increase ...
+          if (new_gids.size() <= rwidth) {
+            OccsList::range lclauses = o_list.clauses(lit); // skips removed clauses
+            for (OccsList::iterator pcl = lclauses.begin(); pcl != lclauses.end(); ++pcl) {
+              if ((_rc.num_nonfalse(*pcl) == 1) && (_pa.false_lanes_memo(*pcl) & bit)) {
+                GID cand_gid = (*pcl)->get_grp_id();
+                if ((cand_gid != 0) || !rm.ignore_g0())
+                  new_gids.insert(cand_gid);  
+                // early break: if over rwidth, we're done ...
+                if (new_gids.size() > rwidth)
+                  break;
+              }
             }
-            if (tv_clause(curr_ass, *pcl) == -1) {
-              GID cand_gid = (*pcl)->get_grp_id();
-              if ((cand_gid != 0) || !rm.ignore_g0())
-                new_gids.insert(cand_gid);  
-              // early break: if over rwidth, we're done ...
-              if (new_gids.size() > rwidth)
-                break;
-            }
-            ++pcl; // next clause
+          }     
+          // ok, now we have the falsified group-set in new_gids; put them on the queue
+          DBG(cout << "  Falsified gids: " << new_gids << endl;);
+          // optimization: check before queuing whether it will be allowed to rotate -- 
+          // if not - do not bother to queue
+          DBG(cout << "  checking if they are worth to queue: ");
+          if (allow_to_rotate(new_gids, curr_ass, lane_hash, rdepth, rwidth)) {
+            rot_queue_entry r(new_gids, e._delta);
+            r._delta.push_back(var);
+            rot_queue.push(r);
+            DBG(cout << " put on the queue" << endl;);
           }
-        }     
-        // ok, now we have the falsified group-set in new_gids; put them on the queue
-        DBG(cout << "  Falsified gids: " << new_gids << endl;);
-        // optimization: check before queuing whether it will be allowed to rotate -- 
-        // if not - do not bother to queue
-        DBG(cout << "  checking if they are worth to queue: ");
-        if (allow_to_rotate(new_gids, curr_ass, curr_ass_hash, rdepth, rwidth)) {
-          rot_queue_entry r(new_gids, e._delta);
-          r._delta.push_back(*pv);
-          rot_queue.push(r);
-          DBG(cout << " put on the queue" << endl;);
         }
-        // unflip
-        flip(curr_ass, *pv);
-        ass_hash_flip(curr_ass_hash, *pv);
       }
       // once a group-set is processed, update da_map and check if its a singleton - 
       // if yes, it should be remembered as necessary
@@ -278,7 +280,7 @@ bool ExtendedModelRotator::process(RotateModel& rm)
     } // if (allow_to_rotate ...)
     // restore working model
     for (list<ULINT>::iterator pv = e._delta.begin(); pv != e._delta.end(); ++pv) {
-      flip(curr_ass, *pv);
+      _rc.flip(*pv);
       ass_hash_flip(curr_ass_hash, *pv);
     }
     // done this group-set
@@ -300,37 +302,6 @@ bool ExtendedModelRotator::process(RotateModel& rm)
 
 namespace {
 
-  // Returns the truth-value of clause under assignment: -1;0:+1
-  int tv_clause(IntVector& ass, const BasicClause* cl)
-  {
-    unsigned false_count = 0;
-    for(CLiterator lpos = cl->abegin(); lpos != cl->aend(); ++lpos) {
-      int var = abs(*lpos);
-      if (ass[var]) {
-        if ((*lpos > 0 && ass[var] == 1) ||
-            (*lpos < 0 && ass[var] == -1))
-          return 1;
-        false_count++;
-      }
-    }
-    return (false_count == cl->asize()) ? -1 : 0;
-  }
-
-  // Checks whether a given assignment satisfies a set of clauses; return 1 for SAT, -1
-  // for UNSAT, 0 for undetermined. A set is SAT iff all clauses are SAT, a set
-  // is UNSAT iff at least one clause is UNSAT, undetermined otherwise
-  int tv_group(IntVector& ass, const BasicClauseVector& clauses)
-  {
-    unsigned sat_count = 0;
-    for (cvec_citerator pcl = clauses.begin(); pcl != clauses.end(); ++pcl) {
-      int tv = tv_clause(ass, *pcl);
-      if (tv == -1)
-        return -1;
-      sat_count += tv;
-    }
-    return (sat_count == clauses.size()) ? 1 : 0;
-  }
-
   // Calculates and returns the hash-value of a assignment
   AHASH ass_hash(const IntVector& ass)
   {
@@ -358,12 +329,4 @@ namespace {
     hash ^= mask;
   }
 
-  // Flips a variable in the assignment
-  void flip(IntVector& ass, ULINT var) {
-    LINT val = ass[var];
-    assert(val != 0); // really shouldn't be flipping unassigned vars
-    if (val)
-      ass[var] = (val == 1) ? -1 : 1;
-  }
-
 } // anonymous namespace
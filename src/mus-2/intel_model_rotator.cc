@@ -195,6 +195,7 @@ bool IntelModelRotator::process(RotateModel& rm)
 
   // a copy of the original model -- will be used as working assignment.
   IntVector curr_ass(orig_model);
+  start_points(orig_model);
   // a set of target gids -- all untested group ids
   GIDSet target_gids;
   for_each(gs.gbegin(), gs.gend(), [&](GID gid) { 
@@ -204,6 +205,12 @@ bool IntelModelRotator::process(RotateModel& rm)
   while (!rot_queue.empty()) {
     rot_queue_entry& e = rot_queue.front();
     GID gid = e.gid;
+    // skip the points visited already (in this or an earlier call)
+    if (seen_point(RotationCache::gid_key(gid), e.delta)) {
+      DBG(cout << "Skipping gid=" << gid << ", visited already." << endl;);
+      rot_queue.pop();
+      continue;
+    }
     BasicClauseVector& fclauses = e.fclauses;
     VarSet multiflip;
     HashedClauseSet new_fclauses;
@@ -231,7 +238,6 @@ bool IntelModelRotator::process(RotateModel& rm)
       // compute the newly falsified clauses (if gid is there, get out)
       for (ULINT var : multiflip) {
         for (BasicClause* cl : o_list.clauses((curr_ass[var] == 1) ? -var : var)) {
-          if (cl->removed()) { continue; }
           if (Utils::tv_clause(curr_ass, cl) == -1) {
             if (cl->get_grp_id() == gid) { // get out
               Utils::multiflip(curr_ass, multiflip);
@@ -376,9 +382,7 @@ BasicClause* IntelModelRotator::analyze_graph(const C& fclauses,
     NDBG(cout << "  clause: "; cl->dump(); cout << ", neighbours: " << endl;);
     for (auto plit = cl->abegin(); plit != cl->aend(); ++plit) {
       NDBG(cout << "    lit=" << *plit << ": ");
-      BasicClauseList& l = o_list.clauses(-*plit);
-      for (auto cl2 : l) {
-        if (cl2->removed()) { continue; }
+      for (auto cl2 : o_list.clauses(-*plit)) {
         // skip if tautology and doing resolution graph
         NDBG(cl2->dump(););
         if (_use_rgraph && Utils::taut_resolvent(cl, cl2, *plit)) { // might be expensive !
@@ -495,7 +499,6 @@ void IntelModelRotator::find_target(GID source_gid,                     // in
       }     
       for (ULINT var : extra_flip) {
         for (BasicClause* cl : o_list.clauses((curr_ass[var] == 1) ? -var : var)) {
-          if (cl->removed()) { continue; }
           if (Utils::tv_clause(curr_ass, cl) == -1) {
             new_fclauses.insert(cl);
             new_fgids.insert(cl->get_grp_id());
@@ -552,15 +555,11 @@ bool IntelModelRotator::fix_assignment_sls(GID target_gid,                // in
     // undo flips, if any (need to update counts)
     for (ULINT var : delta) {
       Utils::flip(curr_ass, var);
-      BasicClauseList& inc = o_list.clauses((curr_ass[var] == 1) ? var : -var);
-      for (BasicClause* cl : inc) {
-        if (cl->removed()) { continue; }
+      for (BasicClause* cl : o_list.clauses((curr_ass[var] == 1) ? var : -var)) {
         if (cl->get_grp_id() != target_gid)
           cl->inc_tl_count();
       }
-      BasicClauseList& dec = o_list.clauses((curr_ass[var] == 1) ? -var : var);
-      for (BasicClause* cl : dec) {
-        if (cl->removed()) { continue; }
+      for (BasicClause* cl : o_list.clauses((curr_ass[var] == 1) ? -var : var)) {
         if (cl->get_grp_id() != target_gid)
           cl->dec_tl_count();
       }
@@ -584,14 +583,11 @@ bool IntelModelRotator::fix_assignment_sls(GID target_gid,                // in
           // variables
           if (!frozen_vars.count(abs(lit))) {
             unsigned score = 0;
-            BasicClauseList& lcl = o_list.clauses(-lit);
-            for (auto pcl = lcl.begin(); pcl != lcl.end(); ) {
-              if ((*pcl)->removed()) { pcl = lcl.erase(pcl); continue; }
-              if (((*pcl)->get_grp_id() != target_gid) && ((*pcl)->tl_count() == 1)) {
+            for (BasicClause* cl : o_list.clauses(-lit)) {
+              if ((cl->get_grp_id() != target_gid) && (cl->tl_count() == 1)) {
                 score++;
                 if (score > best_score) { break; } 
               }
-              ++pcl;
             }
             if (score < best_score) {
               cand_lits.clear();
@@ -641,18 +637,14 @@ bool IntelModelRotator::fix_assignment_sls(GID target_gid,                // in
       fclauses.remove_clauses_with_lit(flip_lit);
       NDBG(cout << "    removed true clauses, now: "; fclauses.dump(); cout << endl;);
       for (BasicClause* cl : o_list.clauses(-flip_lit)) {
-        if (cl->removed()) { continue; }
         if ((cl->get_grp_id() != target_gid) && (cl->dec_tl_count() == 0)) {
           fclauses.add_clause(cl);
           NDBG(cout << "    added false clause "; cl->dump(); cout << endl);
         }
       }
-      BasicClauseList& lcl = o_list.clauses(flip_lit);
-      for (auto pcl = lcl.begin(); pcl != lcl.end(); ) {
-        if ((*pcl)->removed()) { pcl = lcl.erase(pcl); continue; }
-        if ((*pcl)->get_grp_id() != target_gid)
-          (*pcl)->inc_tl_count();
-        ++pcl;
+      for (BasicClause* cl : o_list.clauses(flip_lit)) {
+        if (cl->get_grp_id() != target_gid)
+          cl->inc_tl_count();
       }
       total_steps++;
       //if (fclauses.size() > 100) // strayed too far
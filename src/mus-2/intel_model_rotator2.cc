@@ -58,6 +58,10 @@ bool IntelModelRotator2::process(RotateModel& rm)
         << ", time = " << (RUSAGE::read_cpu_time() - time) << " sec." << endl;);
     if (new_gid == gid_Undef)
       break;
+    // stop at the points visited already (in this or an earlier call)
+    start_points(curr_ass);
+    if (seen_point(RotationCache::gid_key(new_gid), vector<ULINT>()))
+      break;
     // mark as *potentially* necessary ...
     md.pot_nec_gids().insert(new_gid);
     md.mark_necessary(new_gid);
@@ -92,7 +96,7 @@ namespace {
     int v_count = 0;
     // populate the queue with the currently falsified clauses
     // collect the set of variables that appear in the falsified clauses of gid
-    const BasicClauseVector& gclauses = gs.gclauses(start_gid);
+    ClauseRange gclauses = gs.gclauses(start_gid);
     for (auto& cl : gclauses) { 
       assert(!cl->removed()); 
       if (Utils::tv_clause(model, cl) == -1) {
@@ -110,9 +114,7 @@ namespace {
            cout << " (tl=" << Utils::num_tl_clause(model, cl) << "), neighbours: " << endl;);
       for (auto plit = cl->abegin(); plit != cl->aend(); ++plit) {
         NDBG(cout << "    lit=" << *plit << ": ");
-        BasicClauseList& l = o_list.clauses(-*plit);
-        for (auto cl2 : l) {
-          if (cl2->removed()) { continue; }
+        for (auto cl2 : o_list.clauses(-*plit)) {
           // skip if tautology and doing resolution graph
           NDBG(cl2->dump(); cout << " (tl=" << num_tl_clause(model, cl2) << ") ";);
           if (rgraph && Utils::taut_resolvent(cl, cl2, *plit)) {
@@ -59,7 +59,7 @@ namespace {
   // Checks whether a given assignment satisfies a set of clauses; return 1 for SAT, -1
   // for UNSAT, 0 for undetermined. A set is SAT iff all clauses are SAT, a set
   // is UNSAT iff at least one clause is UNSAT, undetermined otherwise
-  int tv_group(IntVector& ass, const BasicClauseVector& clauses);
+  int tv_group(IntVector& ass, const ClauseRange& clauses);
 
 } // anonymous namespace
 
@@ -89,10 +89,17 @@ bool IrrModelRotator::process(RotateModel& rm)
   rot_queue.push(rot_queue_entry(rm.gid()));
   // a copy of the original model -- will be used as working assignment.
   IntVector curr_ass(orig_model);
+  start_points(orig_model);
   while (!rot_queue.empty()) {
     rot_queue_entry& e = rot_queue.front();
     GID gid = e._gid;
     DBG(cout << "Rotating gid=" << gid;);
+    // skip the points visited already (in this or an earlier call)
+    if (seen_point(RotationCache::gid_key(gid), e._delta)) {
+      DBG(cout << ", visited already." << endl;);
+      rot_queue.pop();
+      continue;
+    }
     DBG(cout << ": " << **(gs.gclauses(gid).begin()););
 
     // update working assignment and its hash (don't forget to restore)
@@ -124,8 +131,8 @@ bool IrrModelRotator::process(RotateModel& rm)
 
     // collect the set of variables that appear in the falsified clauses of gid
     IntSet cand_vars;
-    const BasicClauseVector& gclauses = gs.gclauses(gid);
-    for (cvec_citerator pcl = gclauses.begin(); pcl != gclauses.end(); ++pcl) {
+    ClauseRange gclauses = gs.gclauses(gid);
+    for (crange_iterator pcl = gclauses.begin(); pcl != gclauses.end(); ++pcl) {
       if ((*pcl)->removed()) 
         continue;
       else if (tv_clause(curr_ass, *pcl) == -1) {
@@ -136,7 +143,7 @@ bool IrrModelRotator::process(RotateModel& rm)
     // +TEMP: handling of the SAT case
     if (cand_vars.empty()) {
       // now, collect the variables that occur in once-SAT clauses of gid
-      for (cvec_citerator pcl = gclauses.begin(); pcl != gclauses.end(); ++pcl) {
+      for (crange_iterator pcl = gclauses.begin(); pcl != gclauses.end(); ++pcl) {
         if ((*pcl)->removed()) 
           continue;
         else if (tv_clause_slow(curr_ass, *pcl) == 1) {
@@ -158,7 +165,7 @@ bool IrrModelRotator::process(RotateModel& rm)
                        // for the future work on dependencies
       // run through group clauses -- if any clause is still false, add gid to
       // new_gids;
-      for (cvec_citerator pcl = gclauses.begin(); pcl != gclauses.end(); ++pcl) {
+      for (crange_iterator pcl = gclauses.begin(); pcl != gclauses.end(); ++pcl) {
         if ((*pcl)->removed()) 
           continue;
         else if (tv_clause(curr_ass, *pcl) == -1) {
@@ -168,12 +175,8 @@ bool IrrModelRotator::process(RotateModel& rm)
       }
       // ok, run through the clauses that contain lit, and for any clause that
       // *became* falsified due to the flip, add its gid also to new_gids
-      BasicClauseList& lclauses = o_list.clauses(lit);
-      for (BasicClauseList::iterator pcl = lclauses.begin(); pcl != lclauses.end(); ) {
-        if ((*pcl)->removed()) { // clause is removed, update occslist
-          pcl = lclauses.erase(pcl);
-          continue;
-        }
+      OccsList::range lclauses = o_list.clauses(lit); // skips removed clauses
+      for (OccsList::iterator pcl = lclauses.begin(); pcl != lclauses.end(); ++pcl) {
         if (tv_clause(curr_ass, *pcl) == -1) {
           GID cand_gid = (*pcl)->get_grp_id();
           if ((cand_gid != 0) || !rm.ignore_g0())
@@ -182,7 +185,6 @@ bool IrrModelRotator::process(RotateModel& rm)
           if (new_gids.size() > 1)
             break;
         }   
-        ++pcl; // next clause
       }
       // ok, now we have the falsified gid-set in new_gids; put them on the queue
       DBG(cout << "  Falsified gids: " << new_gids << endl;);
@@ -206,8 +208,7 @@ bool IrrModelRotator::process(RotateModel& rm)
       else if (new_gids.size() == 0) {
         // all groups will become satisfied ... ok, pick one that will be 
         // satisfied critically, and that 
-        for (BasicClauseList::iterator pcl = lclauses.begin(); pcl != lclauses.end(); ) {
-          // no need to update occlist -- already done
+        for (OccsList::iterator pcl = lclauses.begin(); pcl != lclauses.end(); ++pcl) {
           if (tv_clause_slow(curr_ass, *pcl) == 1) {
             GID cand_gid = (*pcl)->get_grp_id();
             if ((cand_gid != 0) || !rm.ignore_g0()) {
@@ -223,7 +224,6 @@ bool IrrModelRotator::process(RotateModel& rm)
             //if (new_gids.size() >= 3)
             //  break;
           }   
-          ++pcl; // next clause
         }
         DBG(cout << "  Once-sat gids: " << new_gids << endl;);  
         // queue
@@ -293,10 +293,10 @@ namespace {
   // Checks whether a given assignment satisfies a set of clauses; return 1 for SAT, -1
   // for UNSAT, 0 for undetermined. A set is SAT iff all clauses are SAT, a set
   // is UNSAT iff at least one clause is UNSAT, undetermined otherwise
-  int tv_group(IntVector& ass, const BasicClauseVector& clauses)
+  int tv_group(IntVector& ass, const ClauseRange& clauses)
   {
     unsigned a_count = 0, sat_count = 0;
-    for (cvec_citerator pcl = clauses.begin(); pcl != clauses.end(); ++pcl) {
+    for (crange_iterator pcl = clauses.begin(); pcl != clauses.end(); ++pcl) {
       if ((*pcl)->removed())
         continue;
       a_count++;
@@ -43,15 +43,15 @@ private:
     GIDLenCompare(const BasicGroupSet& gs, unsigned order) 
       : _gs(gs), _order(order) {}
     bool operator()(GID g1, GID g2) {
-      const BasicClauseVector& cls1 = _gs.gclauses(g1);
+      ClauseRange cls1 = _gs.gclauses(g1);
       unsigned sum1 = 0;
-      for (BasicClauseVector::const_iterator pcl = cls1.begin(); 
+      for (crange_iterator pcl = cls1.begin(); 
            pcl != cls1.end(); ++pcl)
         if (!(*pcl)->removed())
           sum1 += (*pcl)->asize();
-      const BasicClauseVector& cls2 = _gs.gclauses(g2);
+      ClauseRange cls2 = _gs.gclauses(g2);
       unsigned sum2 = 0;
-      for (BasicClauseVector::const_iterator pcl = cls2.begin(); 
+      for (crange_iterator pcl = cls2.begin(); 
            pcl != cls2.end(); ++pcl)
         if (!(*pcl)->removed())
           sum2 += (*pcl)->asize();
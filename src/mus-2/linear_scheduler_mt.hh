@@ -12,7 +12,8 @@
 #ifndef _LINEAR_SCHEDULER_MT_HH
 #define _LINEAR_SCHEDULER_MT_HH 1
 
-#include <tbb/concurrent_queue.h>
+#include <deque>
+#include <mutex>
 #include "basic_group_set.hh"
 #include "group_scheduler.hh"
 #include "mus_data_mt.hh"
@@ -21,11 +22,11 @@
  * Class:  LinearSchedulerMT
  *
  * Purpose: Simple linear highest-to-lowest scheduler for multithreaded 
- *          environments. This implementation uses concurrent_queue from TBB.
+ *          environments. The queue is protected by a mutex -- the scheduler
+ *          is hit once per SAT call, so contention is not an issue.
  *
  * Notes:
- *      1. No fasttrack() yet.
- *      2. TODO: perhaps the constructor should take MUSDataMT for cleanness.
+ *      1. TODO: perhaps the constructor should take MUSDataMT for cleanness.
  *
 \*----------------------------------------------------------------------------*/
 
@@ -34,32 +35,49 @@ class LinearSchedulerMT : public GroupScheduler {
 public:
 
   /** In principle an instance of MUSData and total number of workers is enough */
-  LinearSchedulerMT(MUSData& md, unsigned num_workers = 1)
+  LinearSchedulerMT(MUSData& md, unsigned num_workers = 1, bool reverse = false)
     : GroupScheduler(md, num_workers) {
-    // populate the queue (TODO: fix the ordering)
+    // populate the queue (same order as LinearScheduler)
     for (gset_iterator pg = md.gset().gbegin(); pg != md.gset().gend(); ++pg)
-      if (*pg != 0)
-        _q.push(*pg);
+      if (*pg != 0) {
+        (reverse) ? _q.push_back(*pg) : _q.push_front(*pg);
+      }
   }
 
   /** Returns true and sets the next group id for a given worker ID
    * [0,num_workers) if there's more groups; otherwise false
    */
   virtual bool next_group(GID& next_gid, unsigned worker_id) {
-    return _q.try_pop(next_gid);
+    std::lock_guard<std::mutex> lk(_mtx);
+    if (_q.empty())
+      return false;
+    next_gid = _q.front();
+    _q.pop_front();
+    return true;
   }
 
   /** This allows users to re-schedule a group ID check - the invariant is that
-   * after this call next_group will give out the gid at some point
-   * TODO: there's a potential race here -- figure it out
+   * after this call next_group will give out the gid at some point. Note that 
+   * the workers that found the queue empty may have finished already, but the
+   * worker that re-schedules will pick the group up itself.
    */
   virtual void reschedule(GID gid) {
-    _q.push(gid);
+    std::lock_guard<std::mutex> lk(_mtx);
+    _q.push_back(gid);
+  }
+
+  /** This allows to push some gids to the front (if this makes sense)
+   */
+  virtual void fasttrack(GID gid) {
+    std::lock_guard<std::mutex> lk(_mtx);
+    _q.push_front(gid);
   }
 
 private:
 
-  tbb::concurrent_queue<GID> _q;       // queue with GIDs - give one at a time
+  std::deque<GID> _q;       // queue with GIDs - give one at a time
+
+  std::mutex _mtx;          // protects _q
 
 };
 
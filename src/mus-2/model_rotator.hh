@@ -20,10 +20,20 @@
 #include "basic_group_set.hh"
 #include "mus_data.hh"
 #include "mus_config.hh"
+#include "packed_assignment.hh"
 #include "rotate_model.hh"
+#include "rotation_cache.hh"
+#include "rotation_counters.hh"
 #include "solver_wrapper.hh"
 #include "types.hh"
 #include "worker.hh"
+#ifdef MULTI_THREADED
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
 
 /*----------------------------------------------------------------------------*\
  * Class:  ModelRotator
@@ -60,9 +70,38 @@ public:
   /* Prints out the stats */
   virtual void print_stats(std::ostream& out = std::cout) {}
 
+  // cache of visited points
+
+  /* Sets the cache of visited rotation points (0 = none); the cache is not
+   * owned, and may be shared by several rotators */
+  void set_cache(RotationCache* pcache) { _pcache = pcache; }
+
 protected:
 
+  /* Computes the signature of the model of the current call (call this at the
+   * start of process(), if the cache is to be consulted) */
+  void start_points(const IntVector& model) {
+    if (_pcache != 0)
+      _model_key = RotationCache::ass_key(model);
+  }
+
+  /* Returns true if the point (group key gkey, and the model of the current
+   * call with the variables in delta flipped) has been visited already, in
+   * this or an earlier call; if not, the point is remembered. Always false if
+   * there's no cache. */
+  template<class D> bool seen_point(uint64_t gkey, const D& delta) {
+    if (_pcache == 0)
+      return false;
+    uint64_t akey = _model_key;
+    for (ULINT var : delta) { akey ^= RotationCache::var_key(var); }
+    return _pcache->visit(RotationCache::point_key(gkey, akey));
+  }
+
   ULINT _num_points;
+
+  RotationCache* _pcache = 0;   // cache of visited points (not owned)
+
+  uint64_t _model_key = 0;      // signature of the model of the current call
   
 };
 
@@ -107,7 +146,11 @@ public:
 
 protected:
 
-  Dec _d;         // the decider
+  Dec _d;                 // the decider
+
+  RotationCounters _rc;   // working assignment with false clause counters
+
+  PackedAssignment _pa;   // the candidate flips, evaluated 64 at a time
 
 };
 
@@ -180,6 +223,121 @@ private:
 typedef RecursiveModelRotatorTmpl<DeciderSMR> SiertModelRotator;
 
 
+#ifdef MULTI_THREADED
+
+/*----------------------------------------------------------------------------*\
+ * Class:  ParallelModelRotator
+ *
+ * Purpose: A model rotator that implements the RMR algorithm (FMCAD-2011) on
+ *          a pool of threads: the BFS is done level by level, and the points
+ *          of each level are shared out among the threads.
+ *
+ * Notes:
+ *
+ *  1. Currently supported work items: RotateModel
+ *  2. Each thread keeps its own working assignment (with the counters of
+ *     false clauses), and applies the delta of each point to it, and then
+ *     takes it back. The groups found necessary are claimed through a
+ *     per-GID array of atomics, so each one is queued once; the results are
+ *     merged into the work item at the end of each level.
+ *  3. The calling thread is one of the workers; the others are started with
+ *     the rotator, and stay around until it is gone. The caller
+ *     is expected to hold the read lock on MUSData (if any) for the duration
+ *     of process().
+ *  4. Because the points of a level are processed in no particular order,
+ *     the group that a necessary group is reached from (and so the further
+ *     rotation) may differ from the one of RecursiveModelRotator.
+ *
+\*----------------------------------------------------------------------------*/
+
+class ParallelModelRotator : public ModelRotator {
+
+public:
+
+  // lifecycle
+
+  ParallelModelRotator(unsigned num_threads, unsigned id = 0);
+
+  virtual ~ParallelModelRotator(void);
+
+  // functionality
+
+  using Worker::process;
+
+  /* Handles the RotateModel work item
+   */
+  virtual bool process(RotateModel& rm);
+
+private:
+
+  // A point: the falsified group, and the delta from the model
+  struct Point {
+    GID gid;
+    std::vector<ULINT> delta;
+    Point(GID g) : gid(g) {}
+    Point(GID g, const std::vector<ULINT>& d, ULINT var) : gid(g), delta(d) {
+      delta.push_back(var);
+    }
+  };
+
+  // Per-thread state
+  struct Local {
+    RotationCounters rc;                // the working assignment
+    unsigned round = 0;                 // the call the assignment is for
+    std::vector<Point> next;            // the points for the next level
+    std::vector<GID> nec_gids;          // the groups found necessary
+    GIDSet ft_gids;                     // the groups to fasttrack
+    ULINT num_points = 0;               // the points processed
+  };
+
+  // Thread main: processes the levels as they come
+  void _worker(unsigned tid);
+
+  // Processes the points of the current level, taking one at a time
+  void _run_level(Local& loc);
+
+  // Processes one point
+  void _process_point(Local& loc, const Point& p);
+
+  unsigned _num_threads;                // total, including the caller
+
+  std::vector<std::thread> _threads;    // the other threads
+
+  std::vector<Local> _locals;           // per thread state (0 = caller)
+
+  // the current call and level
+
+  RotateModel* _prm = 0;
+
+  unsigned _round = 0;                  // the current call
+
+  std::vector<std::atomic<unsigned> > _claimed; // per GID: the call it was claimed in
+
+  std::vector<Point> _level;            // the points of the current level
+
+  std::atomic<size_t> _next_point { 0 }; // the next point of the level to take
+
+  std::atomic<bool> _abort { false };   // true if an empty clause was seen
+
+  // synchronization between the caller and the threads
+
+  std::mutex _mtx;
+
+  std::condition_variable _cv_start;    // a new level is there (or quit)
+
+  std::condition_variable _cv_done;     // a thread is done with the level
+
+  unsigned _level_gen = 0;              // generation of the current level
+
+  unsigned _busy = 0;                   // threads still working on the level
+
+  bool _quit = false;                   // tells the threads to finish
+
+};
+
+#endif // MULTI_THREADED
+
+
 /*----------------------------------------------------------------------------*\
  * Class:  ExtendedModelRotator
  *
@@ -210,6 +368,12 @@ public:
   /* Handles the RotateModel work item
    */
   virtual bool process(RotateModel& rm);
+
+protected:
+
+  RotationCounters _rc;   // working assignment with false clause counters
+
+  PackedAssignment _pa;   // the candidate flips, evaluated 64 at a time
   
 };
 
@@ -14,6 +14,7 @@
 #define _MUS_CONFIG_H 1
 
 #include "solver_config.hh"
+#include "solver_stop.hh"
 
 
 //jpms:bc
@@ -82,12 +83,46 @@ public:
 
   void set_output_fmt(int fmt) { _output_fmt = fmt; }
 
+  const char* get_bin_output_file() { return _bin_output_file; }
+
+  void set_bin_output_file(const char* ofile) { _bin_output_file = ofile; }
+
+  const char* get_tlm_file() { return _tlm_file; }
+
+  void set_tlm_file(const char* tfile) { _tlm_file = tfile; }
+
   const char* get_sat_solver(void) { return _solver; } 
 
   bool chk_sat_solver(const char* tsolver) { return !strcmp(_solver, tsolver); }
 
   void set_sat_solver(const char* tsolver) { _solver = tsolver; }
 
+  const char* get_ipasir_lib(void) override { return _ipasir_lib; }
+
+  void set_ipasir_lib(const char* lib) { _ipasir_lib = lib; }
+
+  float get_compact_ratio(void) override { return _compact_ratio; }
+
+  void set_compact_ratio(float r) { _compact_ratio = r; }
+
+  bool get_compact_rebuild(void) override { return _compact_rebuild; }
+
+  void set_compact_rebuild(bool r = true) { _compact_rebuild = r; }
+
+  bool get_share_learnts(void) override { return _share_learnts; }
+
+  void set_share_learnts(bool s = true) { _share_learnts = s; }
+
+  const char* get_portfolio(void) override { return _portfolio; }
+
+  void set_portfolio(const char* solvers) { _portfolio = solvers; }
+
+  const SATSolverStop* get_stop(void) override { return &_stop; }
+
+  /* The stop watched by all SAT solvers (and extraction algorithms) made with
+   * this configuration; raise it to stop them from any thread */
+  SATSolverStop& stop(void) { return _stop; }
+
   int get_solpre_mode(void) { return _solpre_mode; }
 
   void set_solpre_mode(int m) { _solpre_mode = m; }
@@ -176,6 +211,22 @@ public:
 
   void unset_refine_clset_mode() { _refine_cset = false; }
 
+  unsigned get_core_trim(void) { return _core_trim; }
+
+  void set_core_trim(unsigned rounds) { _core_trim = rounds; }
+
+  unsigned get_core_trim_del(void) { return _core_trim_del; }
+
+  void set_core_trim_del(unsigned ngroups) { _core_trim_del = ngroups; }
+
+  LINT get_core_trim_cl(void) { return _core_trim_cl; }
+
+  void set_core_trim_cl(LINT cl) { _core_trim_cl = cl; }
+
+  bool get_phase_seed_mode(void) { return _phase_seed; }
+
+  void set_phase_seed_mode(bool ps = true) { _phase_seed = ps; }
+
   bool get_model_rotate_mode() {
     return _rmr_mode || _emr_mode || _imr_mode || _intelmr_mode || _smr_mode;
   }
@@ -231,6 +282,10 @@ public:
 
   void set_iglob_mode(bool iglob_mode = true) { _iglob_mode = iglob_mode; }
 
+  unsigned get_rcache_size() { return _rcache_size; }
+
+  void set_rcache_size(unsigned rcache_size) { _rcache_size = rcache_size; }
+
   unsigned get_smr_mode() { return _smr_mode; }
 
   void set_smr_mode(unsigned smr_mode) {
@@ -333,6 +388,32 @@ public:
 
   void set_num_threads(unsigned num_threads) { _num_threads = num_threads; }
 
+  unsigned get_parse_threads() { return _parse_threads; }
+
+  void set_parse_threads(unsigned parse_threads) { _parse_threads = parse_threads; }
+
+  bool get_ws_sched_mode() { return _ws_sched_mode; }
+
+  void set_ws_sched_mode() { _ws_sched_mode = true; }
+
+  unsigned get_rot_threads() { return _rot_threads; }
+
+  void set_rot_threads(unsigned rot_threads) { _rot_threads = rot_threads; }
+
+  bool get_pipe_mode() { return _pipe_mode; }
+
+  void set_pipe_mode() { _pipe_mode = true; }
+
+  /* Returns the reason why the pipelined mode cannot be used in this
+   * configuration (see MUSExtractionAlgDel), or nullptr if it can */
+  const char* get_pipe_mode_conflict() {
+    if (!get_model_rotate_mode()) { return "model rotation is off"; }
+    if (_refine_cset) { return "it needs -norf"; }
+    if (_reorder_mode) { return "it cannot be used with -reorder"; }
+    if (_approx_mode) { return "it cannot be used with approximation"; }
+    return nullptr;
+  }
+
 #endif
 
   bool get_bcp_mode() { return _bcp_mode; }
@@ -400,6 +481,9 @@ public:
   float get_approx_cpu_lim(void) const { return _approx_cpu_lim; }
   void set_approx_cpu_lim(float approxCpuLim = 0.0f) { _approx_cpu_lim = approxCpuLim; }
 
+  float get_approx_wc_lim(void) const { return _approx_wc_lim; }
+  void set_approx_wc_lim(float approxWcLim = 0.0f) { _approx_wc_lim = approxWcLim; }
+
   float get_approx_fact(void) const { return _approx_fact; }
   void set_approx_fact(float approxFact = 1.0f) { _approx_fact = approxFact; }
 
@@ -470,12 +554,27 @@ public:
     }
 
     if (!_refine_cset) { cfgstr += " -norf"; }
+    if (_core_trim || _core_trim_del) {
+      cfgstr += " -ctrim "; cfgstr += convert<unsigned>(_core_trim);
+      cfgstr += " -ctrim:del "; cfgstr += convert<unsigned>(_core_trim_del);
+      cfgstr += " -ctrim:cl "; cfgstr += convert<LINT>(_core_trim_cl);
+    }
+    if (_phase_seed) { cfgstr += " -phs"; }
 
     cfgstr += " -"; cfgstr += _solver;
+    if (_ipasir_lib != NULL) { cfgstr += " "; cfgstr += _ipasir_lib; }
+    if (_portfolio != NULL) { cfgstr += " -portfolio "; cfgstr += _portfolio; }
     if (_solpre_mode) { cfgstr += " -solpre "; cfgstr += convert<int>(_solpre_mode); }
+    if (_compact_ratio > 0) { cfgstr += " -cdb "; cfgstr += convert<float>(_compact_ratio); }
+    if (_compact_rebuild) { cfgstr += " -cdbr"; }
+    if (_share_learnts) { cfgstr += " -shl"; }
 
 #ifdef MULTI_THREADED
     cfgstr += " -nthr "; cfgstr += convert<unsigned>(_num_threads); 
+    if (_parse_threads != 1) { cfgstr += " -pthr "; cfgstr += convert<unsigned>(_parse_threads); }
+    if (_ws_sched_mode) { cfgstr += " -wsched"; }
+    if (_rot_threads > 1) { cfgstr += " -rthr "; cfgstr += convert<unsigned>(_rot_threads); }
+    if (_pipe_mode) { cfgstr += " -pipe"; }
 #endif
 
     if (_red_mode)      { cfgstr += " -rr"; }
@@ -496,6 +595,7 @@ public:
       }
       if (_reorder_mode) { cfgstr += " -reorder"; }
       if (!_iglob_mode) { cfgstr += " -bglob"; }
+      if (_rcache_size) { cfgstr += " -rcache "; cfgstr += convert<unsigned>(_rcache_size); }
     } else {
       cfgstr += " -norot";
     }
@@ -521,6 +621,7 @@ public:
       cfgstr += " -approx "; cfgstr += convert<int>(_approx_mode);
       cfgstr += " -approx:cl "; cfgstr += convert<int>(_approx_conf_lim);
       cfgstr += " -approx:tl "; cfgstr += convert<float>(_approx_cpu_lim);
+      cfgstr += " -approx:wtl "; cfgstr += convert<float>(_approx_wc_lim);
       cfgstr += " -approx:fact "; cfgstr += convert<float>(_approx_fact);
     }
 
@@ -532,6 +633,7 @@ public:
 
     if (_comp_fmt)   { cfgstr += " -comp"; }
     if (_stats)       { cfgstr += " -st"; }
+    if (_tlm_file != NULL) { cfgstr += " -tlm "; cfgstr += _tlm_file; }
 
     cfgstr += " -T ";
     cfgstr += convert<int>(_timeout);
@@ -567,8 +669,27 @@ protected:
                             // written out: 0 - default (input format),
                             // 1 - unknown first, 2 - GCNF with necessary in g0
 
+  const char* _bin_output_file = NULL; // binary group-set of the input
+
+  const char* _tlm_file = NULL;        // per-call SAT telemetry (JSON lines)
+
   const char* _solver = "glucose";
 
+  const char* _ipasir_lib = NULL;   // IPASIR library to load (for "ipasir")
+
+  const char* _portfolio = NULL;    // solvers to race on each call, comma-
+                                    // separated (NULL = just _solver)
+
+  SATSolverStop _stop;              // the stop watched by the solvers
+
+  float _compact_ratio = 0.0f; // Fraction of groups deleted from the SAT solver
+                               // before its clause DB is compacted (0 = never)
+
+  bool _compact_rebuild = false; // True if compacting by rebuilding the solver
+
+  bool _share_learnts = false; // True if the learnt clauses of the first SAT
+                            // check are given to the other SAT checkers
+
   int _solpre_mode = 0;     // Controls preprocessing in the SAT solver:
                             //  0 - none, 1 - preprocess before the first call
                             //  2 - preprocess before each call
@@ -623,8 +744,22 @@ protected:
 
   bool _iglob_mode = true;   // If true, globally necessary clauses are ignored during rotation
 
+  unsigned _rcache_size = 0; // Size (MB) of the cache of visited rotation points (0 = none)
+
   bool _refine_cset = true;  // Whether to refine working clause set
 
+  unsigned _core_trim = 0;   // Rounds of re-solving with the core only, to trim
+                             // the cores used for refinement (0 = none)
+
+  unsigned _core_trim_del = 0; // Max. number of core groups to try to drop one
+                             // by one, to trim the cores for refinement
+
+  LINT _core_trim_cl = 200;  // Conflict limit per call during core trimming
+                             // (-1 = no limit)
+
+  bool _phase_seed = false;  // If true, the phases of the SAT solver are seeded
+                             // with the model of the last SAT outcome
+
   bool _mus_mode = true;     // True if computing MUS
 
   bool _irr_mode = false;    // True if computing irredundant subformulas of SAT formulas
@@ -645,6 +780,14 @@ protected:
 
 #ifdef MULTI_THREADED
   unsigned _num_threads = 0; // Number of threads to run: 0 = h/w concurrency
+
+  unsigned _parse_threads = 1; // Number of threads for parsing: 0 = h/w concurrency
+
+  bool _ws_sched_mode = false; // True if the work-stealing scheduler is used
+
+  unsigned _rot_threads = 1; // Number of threads for each RMR call
+
+  bool _pipe_mode = false; // True if rotation overlaps the next SAT check
 #endif
 
   bool _bcp_mode = false;    // True if BCP-based simplification should be used
@@ -698,6 +841,9 @@ protected:
   float _approx_cpu_lim = 0.0f; // CPU time limit per call in approximation mode
                              // 0 = no limit
 
+  float _approx_wc_lim = 0.0f; // wall-clock time limit per call in approximation
+                             // mode, 0 = no limit
+
   float _approx_fact = 2.0f; // the factor to multiply limits in approx_mode 3
 
   const char* _nid_file = nullptr; // the file with necessary IDs
@@ -9,10 +9,12 @@
  *
  * 1. MUSData is 1-to-1 with the initial group set
  * 2. Removed lists of clauses - everything is in terms of groups now.
- *    NOTE: if space becomes an issue, combine list and set into one set ordered
- *    by timestamp
  * 3. Not MT-safe
  * 4. Supports groups of variables now too.
+ * 5. The status of groups is kept in a dense GID-indexed vector, so the status
+ *    checks are O(1); the sets r_gids(), nec_gids() and fake_gids() are 
+ *    materialized on demand (and cached until the next status change) -- use 
+ *    num_removed(), num_necessary() and num_fake() for the sizes.
  *
  *                                          Copyright (c) 2011-2012, Anton Belov
 \*----------------------------------------------------------------------------*/
@@ -21,8 +23,10 @@
 #define _MUS_DATA_HH 1
 
 #include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <list>
+#include <vector>
 #include "globals.hh"
 #include "basic_group_set.hh"
 #include "res_graph.hh"
@@ -54,7 +58,9 @@ class MUSData {
 public:
 
   MUSData(BasicGroupSet& gset, bool var_mode = false) 
-    : _gset(gset), _var_mode(var_mode), _version(0) {}
+    : _gset(gset), _var_mode(var_mode), _version(0),
+      _status((var_mode ? gset.max_vgid() : gset.max_gid()) + 1, st_Untested) 
+  { _gset.layout(); } // groups are read concurrently in multi-threaded mode
 
   virtual ~MUSData(void) { if (_has_rgraph) _rgraph.clear(); }
 
@@ -69,16 +75,18 @@ public:    // Accessors
 
   /* Returns a reference to the set of group IDs of removed groups. Thus,
    * effectively, the instance represented by MUSData consists of
-   * gset() \setminus r_gids()
+   * gset() \setminus r_gids(). The set is materialized on demand, and is 
+   * valid until the next status change; to modify, use set_removed() and co.
+   * Note: in MT environments the materialization is not safe under read-lock.
    */
-  GIDSet& r_gids(void) { return _r_gids; }
-  const GIDSet& r_gids(void) const { return _r_gids; }
+  const GIDSet& r_gids(void) const { 
+    return _materialize(_r_gids, _r_valid, st_Removed); }
 
   /* Returns a reference to the set of groups that are known to be in all high-
-   * level MUSes gset() \setminus r_gids()
+   * level MUSes gset() \setminus r_gids(); same notes as for r_gids() apply
    */
-  GIDSet& nec_gids(void) { return _nec_gids; }
-  const GIDSet& nec_gids(void) const { return _nec_gids; }
+  const GIDSet& nec_gids(void) const { 
+    return _materialize(_nec_gids, _nec_valid, st_Nec); }
 
   /* Returns a reference to the list of removed groups, with the most recent in
    * the front
@@ -94,24 +102,32 @@ public:    // Accessors
 
   /* Returns a reference to the set of groups whose status has been faked through
    * approximation; this is a subset of either nec_gids() or r_gids(), depending
-   * on the approximation mechanism
+   * on the approximation mechanism; same notes as for r_gids() apply
    */
-  GIDSet& fake_gids(void) { return _fake_gids; }
-  const GIDSet& fake_gids(void) const { return _fake_gids; }
+  const GIDSet& fake_gids(void) const { 
+    return _materialize(_fake_gids, _fake_valid, st_Fake); }
 
   /* Returns the actual size of the instance (number of non-removed groups)
    */
-  unsigned real_gsize(void) const { return _gset.gsize() - _r_gids.size(); }
+  unsigned real_gsize(void) const { return _gset.gsize() - _num_r; }
 
   /* Returns the number of untested groups (disregarding group 0)
    */
   unsigned num_untested(void) const { 
-    return _gset.gsize() - _gset.has_g0() - (_nec_gids.size() + _r_gids.size());
+    return _gset.gsize() - _gset.has_g0() - (_num_nec + _num_r);
   }
 
+  /* Returns the number of removed groups, i.e. r_gids().size()
+   */
+  unsigned num_removed(void) const { return _num_r; }
+
+  /* Returns the number of necessary groups, i.e. nec_gids().size()
+   */
+  unsigned num_necessary(void) const { return _num_nec; }
+
   /* Returns the number of fake groups
    */
-  unsigned num_fake(void) const { return _fake_gids.size(); }
+  unsigned num_fake(void) const { return _num_fake; }
 
 public:    // Updates
 
@@ -124,10 +140,9 @@ public:    // Updates
     if (_has_rgraph && _rgraph_dynamic)
       for (BasicClause* cl : _gset.gclauses(gid))
         _rgraph.remove_clause(cl);
-    _r_gids.insert(gid);
+    set_removed(gid, fake);
     _r_list.push_front(gid);
     _gset.remove_group(gid);
-    if (fake) { _fake_gids.insert(gid); }
   }
 
   /* Marks gid as necessary: puts it into nec_gids() and f_list()
@@ -135,24 +150,36 @@ public:    // Updates
    */
   void mark_necessary(GID gid, bool fake = false) {
     assert(!r(gid) && !nec(gid));
-    _nec_gids.insert(gid);
+    set_necessary(gid, fake);
     _f_list.push_front(gid);
-    if (fake) { _fake_gids.insert(gid); }
   }
 
+  /* Low-level status updates: set the status of gid to removed, necessary or 
+   * untested, respectively, and nothing else -- the lists and the groupset are
+   * the responsibility of the caller. Setting to the current status is a no-op
+   * (but the fake flag, if given, is still set).
+   */
+  void set_removed(GID gid, bool fake = false) { _set_status(gid, st_Removed, fake); }
+  void set_necessary(GID gid, bool fake = false) { _set_status(gid, st_Nec, fake); }
+  void set_untested(GID gid) { _set_status(gid, st_Untested, false); }
+
   /* Clears the lists */
   void clear_lists(void) { _f_list.clear(); _r_list.clear(); }
 
 public:    // Status checks
 
   /* True if group with gid is removed */
-  bool r(const GID& gid) const { return _r_gids.find(gid) != _r_gids.end(); }
+  bool r(const GID& gid) const { return _status_of(gid) & st_Removed; }
 
   /* True if group with gid is necessary */
-  bool nec(const GID& gid) const { return _nec_gids.find(gid) != _nec_gids.end(); }
+  bool nec(const GID& gid) const { return _status_of(gid) & st_Nec; }
 
   /* True if group with gid is untested (neither necessary nor removed */
-  bool untested(const GID& gid) const { return !r(gid) && !nec(gid); }
+  bool untested(const GID& gid) const { 
+    return !(_status_of(gid) & (st_Removed | st_Nec)); }
+
+  /* True if the status of the group with gid has been faked */
+  bool fake(const GID& gid) const { return _status_of(gid) & st_Fake; }
  
 public:    // Versioning
 
@@ -180,9 +207,9 @@ public:    // Output functions
    * written out first, followed by unknown.
    */
   std::ostream& write_comp(std::ostream& out) {
-    out << "c nec: " << _nec_gids.size() << " unk: " << num_untested() << std::endl;
+    out << "c nec: " << _num_nec << " unk: " << num_untested() << std::endl;
     out << "v ";
-    for (GID gid : _nec_gids) { out << gid << " "; }
+    for (GID gid : nec_gids()) { out << gid << " "; }
     std::for_each(_gset.gbegin(), _gset.gend(), [&](GID gid) {
       if (gid && untested(gid)) { out << gid << " "; }});
     out << "0" << std::endl;
@@ -199,18 +226,18 @@ public:    // Output functions
    */
   std::ostream& write_cnf(std::ostream& out, bool ignore_g0 = false, int output_fmt = 0) {
     // check if finished, if not, add a comment
-    if (real_gsize() != _nec_gids.size())
+    if (real_gsize() != _num_nec)
       out << "c WARNING: MUSer2 did not finish extraction; "
           << "this is an over-approximation of the result." << endl;
-    out << "c " << num_untested() << " unknown clauses, " << _nec_gids.size()
+    out << "c " << num_untested() << " unknown clauses, " << _num_nec
         << " necessary clauses." << endl;
     if (output_fmt <= 1) {
       out << "p cnf " << _gset.max_var() << " "
-          << (_gset.gsize() - _r_gids.size()) << std::endl;
+          << (_gset.gsize() - _num_r) << std::endl;
     } else {
       assert(output_fmt == 2 && "invalid output_fmt value (should be 0,1,2)");
       out << "p gcnf " << _gset.max_var() << " "
-          << (_gset.gsize() - _r_gids.size()) << " "
+          << (_gset.gsize() - _num_r) << " "
           << (num_untested()) << std::endl;
     }
     for (gset_iterator pgid = _gset.gbegin(); pgid != _gset.gend(); ++pgid) {
@@ -220,7 +247,7 @@ public:    // Output functions
                                " this is not CNF");
       }
       if (!r(*pgid) && (!output_fmt || untested(*pgid))) {
-        BasicClauseVector& gcl = pgid.gclauses();
+        ClauseRange gcl = pgid.gclauses();
         if (gcl.size() != 1)
           throw std::logic_error("MUSData::write_cnf(): found non-singleton "
                                  "group, this is not CNF");
@@ -232,8 +259,8 @@ public:    // Output functions
     }
     // for output_fmt > 0, still need to output necessary groups
     if (output_fmt) {
-      for (GID gid : _nec_gids) {
-        BasicClauseVector& gcl = _gset.gclauses(gid);
+      for (GID gid : nec_gids()) {
+        ClauseRange gcl = _gset.gclauses(gid);
         if (gcl.size() != 1)
           throw std::logic_error("MUSData::write_cnf(): found non-singleton "
                                  "group, this is not CNF");
@@ -250,7 +277,7 @@ public:    // Output functions
    */
   std::ostream& write_gcnf(std::ostream& out) {
     // check if finished, if not, add a comment
-    if (real_gsize()-1 != _nec_gids.size()) // TODO BUG: what if there's no G0 ?
+    if (real_gsize()-1 != _num_nec) // TODO BUG: what if there's no G0 ?
       out << "c WARNING: MUSer2 did not finish extraction; "
           << "this is an over-approximation of the result." << endl;
     unsigned r_clauses = 0; // number of removed clauses
@@ -262,8 +289,8 @@ public:    // Output functions
         <<  " " << _gset.max_gid() << std::endl;
     for (gset_iterator pgid = _gset.gbegin(); pgid != _gset.gend(); ++pgid) {
       if (!r(*pgid)) {
-        BasicClauseVector& gcl = pgid.gclauses();
-        for (ClVectIterator pcl = gcl.begin(); pcl != gcl.end(); ++pcl)
+        ClauseRange gcl = pgid.gclauses();
+        for (crange_iterator pcl = gcl.begin(); pcl != gcl.end(); ++pcl)
           if (!(*pcl)->removed()) {
             out << "{" << *pgid << "} ";
             (*pcl)->awrite(out);
@@ -280,14 +307,14 @@ public:    // Output functions
    */
   std::ostream& write_induced_cnf(std::ostream& out) {
     // check if finished, if not, add a comment
-    if (real_gsize() != _nec_gids.size())
+    if (real_gsize() != _num_nec)
       out << "c WARNING: MUSer2 did not finish extraction; "
           << "this is an over-approximation of the result." << endl;
     // compute induced formula size
     unsigned if_size = 0;
     for (cvec_iterator pcl = _gset.begin(); pcl != _gset.end(); ++pcl)
       if_size += !((*pcl)->removed());
-    out << "p cnf " << _nec_gids.size() << " " << if_size << std::endl;
+    out << "p cnf " << _num_nec << " " << if_size << std::endl;
     for (cvec_iterator pcl = _gset.begin(); pcl != _gset.end(); ++pcl)
       if (!(*pcl)->removed()) 
         out << **pcl << std::endl;
@@ -300,7 +327,7 @@ public:    // Output functions
    */
   std::ostream& write_induced_vgcnf(std::ostream& out) {
     // check if finished, if not, add a comment
-    if (real_gsize()-1 != _nec_gids.size())
+    if (real_gsize()-1 != _num_nec)
       out << "c WARNING: MUSer2 did not finish extraction; "
           << "this is an over-approximation of the result." << endl;
     // compute induced formula size
@@ -332,10 +359,9 @@ public:         // Miscellaneous
   void make_empty_gmus(void) {
     _r_list.clear();
     for (gset_iterator pgid = _gset.gbegin(); pgid != _gset.gend(); ++pgid) {
-      _r_gids.insert(*pgid);
+      set_removed(*pgid);
       _r_list.push_back(*pgid);
     }
-    _nec_gids.clear();
   }
 
 public:         // Resolution graph
@@ -381,10 +407,6 @@ protected:
 
   bool _var_mode;              // when true, groups are groups of variables, and not clauses
 
-  GIDSet _r_gids;              // removed GIDs
-
-  GIDSet _nec_gids;            // necessary GIDs of _gset \setminus _r_gids
-
   GIDList _r_list;             // ordered list of removed GIDs: most recent first
 
   GIDList _f_list;             // ordered list of finalized GIDs: most recent first
@@ -401,8 +423,58 @@ protected:
                                // those groups that are no proven to be necessary
                                // but are "suspected" to be necessary
 
-  GIDSet _fake_gids;           // group IDs whose status has been faked through
-                               // approximation
+  // group status: dense, indexed by GID
+
+  enum : uint8_t { st_Untested = 0, st_Nec = 1, st_Removed = 2, st_Fake = 4 };
+
+  std::vector<uint8_t> _status;// status of each group (st_* flags)
+
+  unsigned _num_r = 0;         // number of removed groups
+
+  unsigned _num_nec = 0;       // number of necessary groups
+
+  unsigned _num_fake = 0;      // number of groups with faked status
+
+  mutable GIDSet _r_gids;      // materialized removed GIDs (see r_gids())
+
+  mutable GIDSet _nec_gids;    // materialized necessary GIDs
+
+  mutable GIDSet _fake_gids;   // materialized GIDs whose status has been faked 
+                               // through approximation
+
+  mutable bool _r_valid = true;    // true if _r_gids is up-to-date
+
+  mutable bool _nec_valid = true;  // true if _nec_gids is up-to-date
+
+  mutable bool _fake_valid = true; // true if _fake_gids is up-to-date
+
+  uint8_t _status_of(GID gid) const { 
+    return (gid < _status.size()) ? _status[gid] : (uint8_t)st_Untested; }
+
+  void _set_status(GID gid, uint8_t st, bool fake) {
+    if (gid >= _status.size())
+      _status.resize(gid + 1, st_Untested);
+    uint8_t& s = _status[gid];
+    uint8_t ns = (st == st_Untested) ? st : (st | (s & st_Fake) | (fake ? st_Fake : 0));
+    if (s == ns)
+      return;
+    _num_r += ((ns & st_Removed) != 0) - ((s & st_Removed) != 0);
+    _num_nec += ((ns & st_Nec) != 0) - ((s & st_Nec) != 0);
+    _num_fake += ((ns & st_Fake) != 0) - ((s & st_Fake) != 0);
+    _r_valid = _nec_valid = _fake_valid = false;
+    s = ns;
+  }
+
+  const GIDSet& _materialize(GIDSet& gids, bool& valid, uint8_t flag) const {
+    if (!valid) {
+      gids.clear();
+      for (GID gid = 0; gid < _status.size(); ++gid)
+        if (_status[gid] & flag)
+          gids.insert(gids.end(), gid);
+      valid = true;
+    }
+    return gids;
+  }
 };
 
 #endif /* _MUS_DATA_H */
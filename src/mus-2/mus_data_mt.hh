@@ -14,7 +14,8 @@
 #ifndef _MUS_DATA_MT_HH
 #define _MUS_DATA_MT_HH 1
 
-#include <tbb/reader_writer_lock.h>
+#include <condition_variable>
+#include <mutex>
 #include "basic_group_set.hh"
 #include "mus_data.hh"
 
@@ -23,11 +24,15 @@
  *
  * Purpose: Multi-thread safe container for MUS extraction-related data
  *
- * Description: adds the read-write lock from TBB to MUSData
+ * Description: adds a read-write lock to MUSData
  *
  * Notes:
  *      1. TODO (major): switch to scoped-lock design -- mostly because of 
  *      potential disaster related to exception handling.
+ *      2. The lock is writer-preferring: once a writer is waiting, new readers
+ *      are blocked -- otherwise the workers that are rotating models (under
+ *      read-lock) could starve the workers that want to record results.
+ *      3. The lock is not re-entrant.
  *
 \*----------------------------------------------------------------------------*/
 
@@ -35,7 +40,8 @@ class MUSDataMT : public MUSData {
 
 public:
 
-  MUSDataMT(BasicGroupSet& gset) : MUSData(gset) {}
+  MUSDataMT(BasicGroupSet& gset, bool var_mode = false) 
+    : MUSData(gset, var_mode) {}
 
   virtual ~MUSDataMT(void) {}
 
@@ -43,22 +49,49 @@ public:    // Lock functions (subclasses provide implementation)
 
   /* Get a read-lock on the object */
   virtual void lock_for_reading(void) const {
-    _lock.lock_read();
+    std::unique_lock<std::mutex> lk(_mtx);
+    _rd_cv.wait(lk, [this]{ return !_writer && !_w_waiting; });
+    ++_readers;
   }
 
   /* Get a write-lock on the object: only through non constant reference */
   virtual void lock_for_writing(void) {
-    _lock.lock();
+    std::unique_lock<std::mutex> lk(_mtx);
+    ++_w_waiting;
+    _wr_cv.wait(lk, [this]{ return !_writer && !_readers; });
+    --_w_waiting;
+    _writer = true;
   }
 
-  /* Release lock */
+  /* Release lock (read or write -- while the write lock is held there are no
+   * readers, so the kind of the lock is unambiguous) */
   virtual void release_lock(void) const {
-    _lock.unlock();
+    std::lock_guard<std::mutex> lk(_mtx);
+    if (_writer) {
+      _writer = false;
+    } else {
+      assert(_readers);
+      --_readers;
+    }
+    if (_w_waiting) {
+      if (!_readers) _wr_cv.notify_one();
+    } else
+      _rd_cv.notify_all();
   }
 
 protected:
 
-  mutable tbb::reader_writer_lock _lock;    // lock -- TODO(major): switch to scoped_lock !
+  mutable std::mutex _mtx;                  // protects the fields below
+
+  mutable std::condition_variable _rd_cv;   // readers wait here
+
+  mutable std::condition_variable _wr_cv;   // writers wait here
+
+  mutable unsigned _readers = 0;            // number of active readers
+
+  mutable unsigned _w_waiting = 0;          // number of waiting writers
+
+  mutable bool _writer = false;             // true if a writer is active
 
 };
 
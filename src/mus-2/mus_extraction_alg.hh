@@ -81,6 +81,10 @@ public:
 
   double sat_time_unsat(void) { return _sat_time_unsat; }
 
+  unsigned tail_groups(void) { return _tail_groups; }
+
+  double tail_time(void) { return _tail_time; }
+
 protected:
   
   unsigned _id;                 // logical thread ID - same as SAT checker's
@@ -125,6 +129,10 @@ protected:
 
   double _sat_time_unsat = 0;   // SAT solving time (UNSAT outcomes)
 
+  unsigned _tail_groups = 0;    // hard groups checked without limits (approx 3)
+
+  double _tail_time = 0;        // SAT solving time on the hard groups (approx 3)
+
   double _sat_timer = 0;        // used for timing
 
   void start_sat_timer(void) { _sat_timer = RUSAGE::read_cpu_time(); }
@@ -157,6 +165,36 @@ public:
    */
   void operator()(void);
 
+protected:
+
+  /* Returns true if the core of the UNSAT outcome in wi survived the removals
+   * made since the version of wi, i.e. the result can be used as is.
+   */
+  bool core_survived(CheckGroupStatus& wi);
+
+  /* Approximation mode 3: sets the limits for the check of the group gid in
+   * wi, and enters the tail once only the hard groups are left.
+   */
+  void set_limits(CheckGroupStatus& wi, GID gid);
+
+  /* Returns true if every untested group has had an unknown outcome in this
+   * worker (approximation mode 3)
+   */
+  bool hard_only(void);
+
+  /* Records the results of the (completed) rotation in rm: the groups found
+   * necessary go into MUSData and the scheduler; resets rm.
+   */
+  void record_rotation(RotateModel& rm);
+
+protected:
+
+  GID2IntMap _tries;            // approx 3: number of unknown outcomes per group
+
+  bool _tail = false;           // approx 3: true once only hard groups are left
+
+  double _tail_start = 0;       // approx 3: SAT time at the start of the tail
+
 };
 
 
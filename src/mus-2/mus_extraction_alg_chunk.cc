@@ -109,7 +109,7 @@ void MUSExtractionAlgChunk::operator()(void)
       if (gsc.status()) { // SAT
         // take care of the necessary group: put into MUSData, and mark final
         _md.lock_for_writing();
-        _md.nec_gids().insert(gid);
+        _md.set_necessary(gid);
         _md.f_list().push_front(gid);
         _md.release_lock();
         // do rotation, if asked for it
@@ -129,7 +129,7 @@ void MUSExtractionAlgChunk::operator()(void)
                  pgid != rm.nec_gids().end(); ++pgid) {
               // double-check check if not necessary already and not gid 0
               if (*pgid && !_md.nec(*pgid)) {
-                _md.nec_gids().insert(*pgid);
+                _md.set_necessary(*pgid);
                 _md.f_list().push_front(*pgid);
                 r_count++;
               }
@@ -139,22 +139,23 @@ void MUSExtractionAlgChunk::operator()(void)
               cout_pref << "wrkr-" << _id << " " << r_count
                         << " groups are necessary due to rotation." << endl;
             _rot_groups += r_count;
+            _schecker.note_rotated(r_count);
           }
           rm.reset();
         }
         ++_sat_outcomes;
       } else { // gsc.status = UNSAT
         // take care of unnecessary groups
-        GIDSet& ugids = gsc.unnec_gids();
+        DenseGIDSet& ugids = gsc.unnec_gids();
         if (!ugids.empty()) {
           _md.lock_for_writing();
           if (gsc.version() == _md.version()) {
-            for (GIDSetIterator pgid = ugids.begin(); pgid != ugids.end(); ++pgid) {
-              _md.r_gids().insert(*pgid);
+            for (DenseGIDSet::iterator pgid = ugids.begin(); pgid != ugids.end(); ++pgid) {
+              _md.set_removed(*pgid);
               _md.r_list().push_front(*pgid);
               // mark the clauses as removed (and update counts in the occlist)
-              BasicClauseVector& clv = gs.gclauses(*pgid);
-              for (cvec_iterator pcl = clv.begin(); pcl != clv.end(); ++pcl) {
+              ClauseRange clv = gs.gclauses(*pgid);
+              for (crange_iterator pcl = clv.begin(); pcl != clv.end(); ++pcl) {
                 if (!(*pcl)->removed()) {
                   (*pcl)->mark_removed();
                   if (gs.has_occs_list())
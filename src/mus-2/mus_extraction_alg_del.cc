@@ -13,6 +13,7 @@
  *                                           Copyright (c) 2011-12, Anton Belov
 \*----------------------------------------------------------------------------*/
 
+#include <cmath>
 #include <cstdio>
 #include <iostream>
 #include <sstream>
@@ -20,9 +21,8 @@
 #if __linux__
 #include <sched.h>
 #endif
-#include <tbb/tbb.h>
-#include <tbb/tbb_thread.h>
-//#include <tbb/compat/thread>
+#include <algorithm>
+#include <thread>
 #endif
 #include "basic_group_set.hh"
 #include "mus_extraction_alg.hh"
@@ -43,7 +43,7 @@ namespace {
       fflush(stdout);
     }
     std::ostringstream& get(void) {
-      _out << "tid 0x" << hex << tbb::this_tbb_thread::get_id()
+      _out << "tid 0x" << hex << std::this_thread::get_id()
            << ": " << dec;
       return _out;
     }
@@ -56,6 +56,11 @@ namespace {
    * ID. The id's on linux are in the range [0,num_logical_cpu's). Nooped on Mac
    */
   void set_hard_affinity(unsigned id);
+
+  /** Lets the calling thread run on any CPU (the threads inherit the affinity
+   * of the thread that starts them). Nooped on Mac
+   */
+  void clear_hard_affinity(void);
 #endif // MULTI_THREADED
 
 #if STATS  
@@ -117,7 +122,8 @@ namespace {
 void MUSExtractionAlgDel::operator()(void)
 {
 #ifdef MULTI_THREADED      
-  set_hard_affinity(_id);     // use thread ID as CPU ID
+  // use thread ID as CPU ID (wrap around if there are more threads than CPUs)
+  set_hard_affinity(_id % std::max(1U, std::thread::hardware_concurrency()));
 #endif
   // now, as long as group scheduler has something to work on, do it ...
   // if retry_last_gid = true we assume that a last group gid needs to be
@@ -135,7 +141,24 @@ void MUSExtractionAlgDel::operator()(void)
   if (config.get_approx_mode()) {
     wi.set_conf_limit(config.get_approx_conf_lim());
     wi.set_cpu_limit(config.get_approx_cpu_lim());
+    wi.set_wc_limit(config.get_approx_wc_lim());
   }
+#ifdef MULTI_THREADED
+  wi.set_save_core(true);  // needed to salvage results on version mismatch
+  std::thread rot_thread;  // pipelined mode: the rotation of the last model
+  // the check that overlaps the rotation is speculative: if the rotation
+  // decides the group, the check would not have been made at all. Its outcome
+  // is dropped then, but its effect on the SAT solver stays, and so the cores
+  // (refinement), the approximate outcomes and the fasttracked groups (the
+  // order) could differ from the non-pipelined mode -- so, no overlapping in
+  // these modes; otherwise the outcomes of the checks do not depend on the
+  // state of the solver, and the result is the same (main() reports it when
+  // -pipe is ignored for this reason)
+  bool pipe_mode = config.get_pipe_mode()
+    && (config.get_pipe_mode_conflict() == nullptr);
+#else
+  bool pipe_mode = false;
+#endif
   while (retry_last_gid || _sched.next_group(gid, _id)) {
     retry_last_gid = false; // will be set to true when needed
     if (gid == 0) {
@@ -170,6 +193,8 @@ void MUSExtractionAlgDel::operator()(void)
     // otherwise, do the check: set up the work item
     wi.reset();
     wi.set_gid(gid);
+    if (config.get_approx_mode() == 3)
+      set_limits(wi, gid);
 #if (__linux__ && FULLDEBUG) || (__linux__ && STATS)
     double curr_t = _schecker.sat_time();
 #endif
@@ -177,6 +202,33 @@ void MUSExtractionAlgDel::operator()(void)
 #if (__linux__ && STATS)
     ts.report_stats(gid, (_schecker.sat_time()-curr_t), wi.status(), _id);
 #endif
+#ifdef MULTI_THREADED
+    // pipelined mode: the rotation of the previous model ran alongside the
+    // check -- record its results first; if they decided the group, the
+    // outcome of the check is dropped (the group would have been skipped in
+    // the non-pipelined mode)
+    if (rot_thread.joinable()) {
+      rot_thread.join();
+      record_rotation(rm);
+      _md.lock_for_reading();
+      status_known = !_md.untested(gid);
+      _md.release_lock();
+      if (status_known) {
+        if (config.get_verbosity() >= 4)
+          cout_pref_mt << "wrkr-" << _id << " necessary due to rotation. Dropping the outcome." << endl;
+        continue;
+      }
+    }
+    // the checker does not run the SAT check if in the meantime the status of
+    // the group was determined by another worker -- nothing to do then
+    if (!wi.completed()) {
+      _md.lock_for_reading();
+      status_known = !_md.untested(gid);
+      _md.release_lock();
+      if (status_known)
+        continue;
+    }
+#endif
 #if (__linux__ && FULLDEBUG)
     cout_mt << "wrkr-" << _id << " "
             << (wi.completed() ? "done" : "NOT done")
@@ -195,48 +247,49 @@ void MUSExtractionAlgDel::operator()(void)
       }
       if (wi.status()) { // SAT
         // take care of the necessary group: put into MUSData, and mark final
+        // (in MT mode, the status could have been decided by another worker 
+        // in the meantime, but only in approximation modes)
         _md.lock_for_writing();
-        _md.mark_necessary(gid);
+        bool untested = _md.untested(gid);
+        if (untested)
+          _md.mark_necessary(gid);
+        bool do_rotate = untested && _md.num_untested();
         _md.release_lock();
-        _sched.update_necessary(gid);
-        // do rotation, if asked for it (and there're untested groups)
-        if (config.get_model_rotate_mode() && _md.num_untested()) {
+        if (untested)
+          _sched.update_necessary(gid);
+        // do rotation, if asked for it (and there're untested groups); the
+        // model satisfies the current groupset minus gid, because the groupset
+        // can only shrink since the SAT call. The rotation is done under the 
+        // read-lock, and so other workers can keep reading.
+        if (config.get_model_rotate_mode() && do_rotate) {
           rm.set_gid(gid);
-          rm.set_model(wi.model()); // this is safe b/c the same thread that did
-                                    // the SAT check is doing rotation
+          // this is safe b/c the same thread that did the SAT check is doing
+          // rotation; in the pipelined mode wi is re-used by the next check
+          // while the rotation runs, and so the model is copied
+          rm.set_model(wi.model(), pipe_mode);
           rm.set_rot_depth(config.get_rotation_depth());
           rm.set_rot_width(config.get_rotation_width());
           rm.set_collect_ft_gids(config.get_reorder_mode());
           rm.set_ignore_g0(config.get_ig0_mode());
           rm.set_ignore_global(config.get_iglob_mode());
-          _mrotter.process(rm);
-          if (rm.completed()) {
-            unsigned r_count = 0;
-            _md.lock_for_writing();
-            for (GIDSetIterator pgid = rm.nec_gids().begin();
-                 pgid != rm.nec_gids().end(); ++pgid) {
-              // double-check check if not necessary already and not gid 0
-              if (*pgid && !_md.nec(*pgid)) {
-                _md.mark_necessary(*pgid);
-                _sched.update_necessary(*pgid);
-                r_count++;
-              }
-            }
-            if (config.get_reorder_mode()) {
-              for (GIDSet::iterator pr = rm.ft_gids().begin(); 
-                   pr != rm.ft_gids().end(); ++pr)
-                if (!_md.nec(*pr))
-                  _sched.fasttrack(*pr);
-              rm.ft_gids().clear();
-            }
-
+#ifdef MULTI_THREADED
+          // pipelined mode: the rotation runs alongside the next SAT check,
+          // and the results are recorded once that check is done
+          if (pipe_mode) {
+            rot_thread = std::thread([this, &rm]{
+                clear_hard_affinity();
+                _md.lock_for_reading();
+                _mrotter.process(rm);
+                _md.release_lock();
+              });
+          } else
+#endif
+          {
+            _md.lock_for_reading();
+            _mrotter.process(rm);
             _md.release_lock();
-            if ((config.get_verbosity() >= 4) && r_count)
-              cout_pref_mt << "wrkr-" << _id << " " << r_count
-                           << " groups are necessary due to rotation." << endl;
-            _rot_groups += r_count;
+            record_rotation(rm);
           }
-          rm.reset();
         }
         _sat_outcomes++;
         if (config.get_rm_reda_mode()) // re-enable redundancy removal
@@ -247,18 +300,24 @@ void MUSExtractionAlgDel::operator()(void)
         // no need to check the version number - however, for parallel version
         // we must look at the version number inside wi.version() -- if the
         // current version of MUSData is ahead of wi.version() this means that
-        // we have removed some groups while the item was being processed, in
-        // which case the unnecessary gids may not be unnecessary anymore. The
-        // simplest way to handle this is by simply discaring the result: this
-        // code is below
-        GIDSet& ugids = wi.unnec_gids();
+        // some groups were removed while the item was being processed, in
+        // which case the unnecessary gids may not be unnecessary anymore. 
+        // However, if the core does not touch any of the groups removed since
+        // then, the core is still there, and so the result is still valid. 
+        // Only if it does, the result is discarded and the group is re-tried.
+        DenseGIDSet& ugids = wi.unnec_gids();
         if (!ugids.empty()) {
           _md.lock_for_writing();
-          if (wi.version() == _md.version()) {
-            for (GIDSetIterator pgid = ugids.begin(); pgid != ugids.end(); ++pgid) {
+          if ((wi.version() == _md.version()) || core_survived(wi)) {
+            unsigned u_count = 0;
+            for (DenseGIDSet::iterator pgid = ugids.begin(); pgid != ugids.end(); ++pgid) {
+              if (!_md.untested(*pgid)) // decided by others in the meantime
+                continue;
               _md.mark_removed(*pgid);
               _sched.update_removed(*pgid);
+              ++u_count;
             }
+            _ref_groups += u_count - (u_count > 0);
             // removed some clauses -- increment the version
             _md.incr_version();
             if (wi.tainted_core()) {
@@ -279,7 +338,6 @@ void MUSExtractionAlgDel::operator()(void)
           _md.release_lock();
         }
         _unsat_outcomes++;
-        _ref_groups += ugids.size() - 1;
       }
       // done with this call
     } // wi.completed()
@@ -287,7 +345,8 @@ void MUSExtractionAlgDel::operator()(void)
       if (config.get_verbosity() >= 4)
         cout_pref_mt << "wrkr-" << _id << " " << " group status is unknown." << endl;
       ++_unknown_outcomes;
-      switch(config.get_approx_mode()) {
+      // if stopped (rather than out of the limits), the group stays unknown
+      switch(config.stop().reached() ? 0 : config.get_approx_mode()) {
       case 1: // overaproximation - treat as necessary
         _md.lock_for_writing();
         _md.mark_necessary(gid, true);
@@ -305,9 +364,13 @@ void MUSExtractionAlgDel::operator()(void)
         if (config.get_verbosity() >= 4)
           cout_pref_mt << "wrkr-" << _id << " " << " treating as unneccessary." << endl;
         break;
-      case 3: // resheduing
-        // TODO: increase limits, if its time to do it
-        tool_abort("approximation mode 3 is not yet implemented");
+      case 3: // rescheduling - try again later, with larger limits
+        ++_tries[gid];
+        if (config.get_verbosity() >= 4)
+          cout_pref_mt << "wrkr-" << _id << " " << " rescheduling (try "
+                       << _tries[gid] << ")." << endl;
+        _sched.reschedule(gid);
+        break;
       default:
         _sched.reschedule(gid);
       }
@@ -318,23 +381,42 @@ void MUSExtractionAlgDel::operator()(void)
         cout_pref_mt << "wrkr-" << _id << " reached CPU time limit." << endl;
       break;
     }
+    // check the stop (interrupt, or wall-clock deadline)
+    if (config.stop().reached()) {
+      if (config.get_verbosity() >= 3)
+        cout_pref_mt << "wrkr-" << _id << " was stopped." << endl;
+      break;
+    }
     // check iteration limit
     if (_iter_limit && ++n_iter >= _iter_limit) {
       if (config.get_verbosity() >= 3)
         cout_pref_mt << "wrkr-" << _id << " reached iteration limit." << endl;
       break;
     }
-    if (config.get_verbosity() >= 3)
+    if (config.get_verbosity() >= 3) {
+      _md.lock_for_reading();
       cout_pref_mt << "[" << RUSAGE::read_cpu_time() << " sec] "
-                   << "wrkr-" << _id << ": nec = " << _md.nec_gids().size()
-                   << ", unn = " << _md.r_gids().size() 
+                   << "wrkr-" << _id << ": nec = " << _md.num_necessary()
+                   << ", unn = " << _md.num_removed() 
                    << ", unk = " << _md.num_untested()
                    << (config.get_approx_mode() ? (", fake = "+convert<int>(_md.num_fake())) : "")
                     << endl;
+      _md.release_lock();
+    }
   } // main loop
+#ifdef MULTI_THREADED
+  if (rot_thread.joinable()) { // record the results of the last rotation
+    rot_thread.join();
+    record_rotation(rm);
+  }
+#endif
+  _md.lock_for_reading();
   _schecker.sync_solver(_md); // sync the results of the very last call
+  _md.release_lock();
   _sat_calls = _schecker.sat_calls();
   _sat_time = _schecker.sat_time();
+  if (_tail)
+    _tail_time = _sat_time - _tail_start;
   if (config.get_verbosity() >= 2) {
     cout_pref_mt << "wrkr-" << _id << " finished; "
                  << " SAT calls: " << _sat_calls
@@ -348,6 +430,8 @@ void MUSExtractionAlgDel::operator()(void)
                  << ", SAT time UNSAT: " << _schecker.sat_time_unsat() 
                  << " sec (" << _schecker.sat_time_unsat()/_unsat_outcomes << " sec/call)"
                  << (config.get_approx_mode() ? (", UNKNOWN outcomes = "+convert<int>(_unknown_outcomes)) : "")
+                 << ((config.get_approx_mode() == 3) ? (", hard groups = "+convert<int>(_tail_groups)
+                                                        +", hard SAT time: "+convert<double>(_tail_time)+" sec") : "")
                  << endl;
     _mrotter.print_stats();     // TODO: pass the predix
   }
@@ -356,6 +440,107 @@ void MUSExtractionAlgDel::operator()(void)
 #endif
 }
 
+/* Returns true if the group core in the (completed, UNSAT) work item does not
+ * contain any of the groups removed since the version of the work item, i.e.
+ * the core is still a subset of the current groupset. Assumes that the caller
+ * holds a lock on MUS data.
+ */
+bool MUSExtractionAlgDel::core_survived(CheckGroupStatus& wi)
+{
+  if (!wi.save_core())
+    return false;
+  const DenseGIDSet& core = *wi.pcore();
+  assert(_md.r_list().size() >= wi.r_count());
+  size_t n_new = _md.r_list().size() - wi.r_count();
+  GIDListCIterator pg = _md.r_list().begin();
+  for ( ; n_new; --n_new, ++pg)
+    if (core.count(*pg))
+      return false;
+  return true;
+}
+
+/* Records the results of the (completed) rotation in rm: the groups found
+ * necessary go into MUSData and the scheduler, and, in the re-ordering mode,
+ * the groups to fasttrack go to the scheduler. Resets rm.
+ */
+void MUSExtractionAlgDel::record_rotation(RotateModel& rm)
+{
+  if (rm.completed()) {
+    unsigned r_count = 0;
+    _md.lock_for_writing();
+    for (GIDSetIterator pgid = rm.nec_gids().begin();
+         pgid != rm.nec_gids().end(); ++pgid) {
+      // double-check check if not necessary already and not gid 0
+      if (*pgid && _md.untested(*pgid)) {
+        _md.mark_necessary(*pgid);
+        _sched.update_necessary(*pgid);
+        r_count++;
+      }
+    }
+    if (config.get_reorder_mode()) {
+      for (GIDSet::iterator pr = rm.ft_gids().begin(); 
+           pr != rm.ft_gids().end(); ++pr)
+        if (!_md.nec(*pr))
+          _sched.fasttrack(*pr);
+      rm.ft_gids().clear();
+    }
+
+    _md.release_lock();
+    if ((config.get_verbosity() >= 4) && r_count)
+      cout_pref_mt << "wrkr-" << _id << " " << r_count
+                   << " groups are necessary due to rotation." << endl;
+    _rot_groups += r_count;
+    _schecker.note_rotated(r_count);
+  }
+  rm.reset();
+}
+
+/* Approximation mode 3: the group gets the configured limits multiplied by
+ * the approximation factor once for each of its unknown outcomes so far. Once
+ * the scheduler hands out a group that has been tried before, and all of the
+ * untested groups are such groups, the rest of the groups (the "tail") are
+ * checked without any limits, and so the result is exact. In multi-threaded
+ * mode the tries are counted per worker; the limits of the groups rescheduled
+ * to other workers keep growing until a worker gets to see all of them.
+ */
+void MUSExtractionAlgDel::set_limits(CheckGroupStatus& wi, GID gid)
+{
+  GID2IntMap::iterator pt = _tries.find(gid);
+  if (!_tail && (pt != _tries.end()) && hard_only()) {
+    _tail = true;
+    _tail_start = _schecker.sat_time();
+    if (config.get_verbosity() >= 3)
+      cout_pref_mt << "wrkr-" << _id << " only hard groups are left ("
+                   << _tail_groups << "), lifting the limits." << endl;
+  }
+  if (_tail) {
+    wi.set_conf_limit(-1);
+    wi.set_cpu_limit(0.0f);
+    wi.set_wc_limit(0.0f);
+    return;
+  }
+  double f = (pt == _tries.end()) ? 1.0 : pow(config.get_approx_fact(), pt->second);
+  LINT cl = config.get_approx_conf_lim();
+  wi.set_conf_limit((cl == -1) ? -1 : (LINT)std::min(cl * f, 1e18));
+  wi.set_cpu_limit(config.get_approx_cpu_lim() * f);
+  wi.set_wc_limit(config.get_approx_wc_lim() * f);
+}
+
+/* Returns true if every untested group has had an unknown outcome in this
+ * worker; if so, the number of such groups goes into _tail_groups.
+ */
+bool MUSExtractionAlgDel::hard_only(void)
+{
+  _md.lock_for_reading();
+  unsigned n_hard = 0;
+  for (const auto& t : _tries)
+    if (_md.untested(t.first)) { ++n_hard; }
+  bool res = (n_hard >= _md.num_untested());
+  if (res) { _tail_groups = n_hard; }
+  _md.release_lock();
+  return res;
+}
+
 // local implementations ....
 
 namespace {
@@ -376,6 +561,20 @@ namespace {
 #endif
 #if (__APPLE__ & __MACH__)
     DBG(cout_mt << "warning: cannot set affinity to CPU " << id << " on Mac" << endl;);
+#endif
+  }
+
+  /** Lets the calling thread run on any CPU (the threads inherit the affinity
+   * of the thread that starts them). Nooped on Mac
+   */
+  void clear_hard_affinity(void)
+  {
+#if __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (unsigned id = 0; id < std::max(1U, std::thread::hardware_concurrency()); id++)
+      CPU_SET(id, &mask);
+    (void)sched_setaffinity(0, sizeof(mask), &mask);
 #endif
   }
 #endif
@@ -92,7 +92,7 @@ void MUSExtractionAlgDich::operator()(void)
         // groups within [p_unknown, p_mid) if refinement is ok -- get them and 
         // shift them to the end
         if (config.get_mus_mode() && config.get_refine_clset_mode()) {
-          const GIDSet& unnec_gids = crs.unnec_gids();
+          const DenseGIDSet& unnec_gids = crs.unnec_gids();
           DBG(cout << "  refinement: " << unnec_gids.size() << " unnecessary GIDs " 
               << unnec_gids << endl;);
           // move all unnecessary groups to the end; but note that every 
@@ -163,6 +163,7 @@ void MUSExtractionAlgDich::operator()(void)
                   << " necessary groups." << endl;
       p_unknown = p;
       _rot_groups += nec_gids.size() - 1;
+      _schecker.note_rotated(nec_gids.size() - 1);
       rm.reset();
     }
     crs.reset();
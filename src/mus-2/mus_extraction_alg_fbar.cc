@@ -204,7 +204,7 @@ void MUSExtractionAlgFBAR::_do_cegar(void)
     _md.mark_removed(*pg);
   }
   unsigned curr_size = _cand_gids.size();
-  GIDSet& gcore = _solver.get_group_unsat_core();  
+  DenseGIDSet& gcore = _solver.get_group_unsat_core();  
   for (auto pg = _cand_gids.begin(); pg != _cand_gids.end(); ) {
     if (!gcore.count(*pg)) {
       _solver.del_group(*pg);
@@ -331,7 +331,7 @@ void MUSExtractionAlgFBAR::_cleanup_cands(void)
         if (config.get_verbosity() >= 3)
           cout_pref << "wrkr-" << _id << " group " << gid
                     << " became redundant, removed." << endl;
-        GIDSet& gcore = _solver.get_group_unsat_core();
+        DenseGIDSet& gcore = _solver.get_group_unsat_core();
         unsigned curr_size = _untested_gids.size();
         for (auto pg = _untested_gids.begin(); pg != _untested_gids.end(); ) {
           if (!gcore.count(*pg)) {
@@ -462,7 +462,7 @@ GID MUSExtractionAlgFBAR::_pick_next_group(GID last_gid, SATRes last_outcome)
 void MUSExtractionAlgFBAR::_add_neg_group(GID gid)
 {
   BasicGroupSet& gs = _md.gset();
-  const BasicClauseVector& cls = gs.gclauses(gid);
+  ClauseRange cls = gs.gclauses(gid);
   _assumps.clear();
   if (cls.size() == 1) { // singleton, nothing to add, just assume
     const BasicClause* cl = *cls.begin();
@@ -532,7 +532,7 @@ void MUSExtractionAlgFBAR::_remove_witness(GID gid)
 /** Returns true if the assignment satisfies the given group; false otherwise */
 bool MUSExtractionAlgFBAR::_satisfies_group(GID gid, const IntVector& ass)
 {
-  const BasicClauseVector& cls = _md.gset().gclauses(gid);
+  ClauseRange cls = _md.gset().gclauses(gid);
   for (const BasicClause* cl : cls) 
     if (!cl->removed() && (Utils::tv_clause(ass, cl) != 1))
       return false;
@@ -542,7 +542,7 @@ bool MUSExtractionAlgFBAR::_satisfies_group(GID gid, const IntVector& ass)
 /** Returns the number of clauses in the group falsified by the assignment */
 unsigned MUSExtractionAlgFBAR::_num_fclauses(GID gid, const IntVector& ass)
 {
-  const BasicClauseVector& cls = _md.gset().gclauses(gid);
+  ClauseRange cls = _md.gset().gclauses(gid);
   unsigned count = 0;
   for (const BasicClause* cl : cls) 
     if (!cl->removed() && (Utils::tv_clause(ass, cl) != 1))
@@ -594,7 +594,7 @@ void MUSExtractionAlgFBAR::_check_invariants(void)
     GID test_gid = 0;
     auto pg = _cand_gids.begin();
     while (1) {
-      const BasicClauseVector& cls = gs.gclauses(test_gid);
+      ClauseRange cls = gs.gclauses(test_gid);
       for (const BasicClause* cl : cls) {
         if (cl->removed()) { continue; }
         if (Utils::tv_clause(witness, cl) != 1) {
@@ -121,7 +121,7 @@ void MUSExtractionAlgIns::operator()(void)
 
     // unnecessary groups (refinement is only for MUS mode)
     if (config.get_mus_mode() && config.get_refine_clset_mode()) {
-      const GIDSet& unnec_gids = crs.unnec_gids();
+      const DenseGIDSet& unnec_gids = crs.unnec_gids();
       DBG(cout << "  refinement: " << unnec_gids.size() << " unnecessary GIDs " 
           << unnec_gids << endl;);
       assert(!unnec_gids.count(*p_curr)); // cannot be unnecessary !
@@ -165,6 +165,7 @@ void MUSExtractionAlgIns::operator()(void)
                   << " necessary groups." << endl;
       p_unknown = p;
       _rot_groups += nec_gids.size() - 1;
+      _schecker.note_rotated(nec_gids.size() - 1);
       rm.reset();
     }
     crs.reset();
@@ -273,6 +273,7 @@ void MUSExtractionAlgProg::do_model_rotation(vector<GID>::iterator p_nec, IntVec
   if (config.get_verbosity() >= 3)
     cout_pref << (p_border - _p_unknown) << " necessary groups due to model rotation" << endl;
   _rot_groups += (p_border - _p_unknown);
+  _schecker.note_rotated(p_border - _p_unknown);
   _p_unknown = p_border;
   _rm.reset();
 }
@@ -286,7 +287,7 @@ void MUSExtractionAlgProg::do_model_rotation(vector<GID>::iterator p_nec, IntVec
  * @post p_removed' == p_removed - r
  */
 size_t MUSExtractionAlgProg::do_refinement(vector<GID>::iterator p_from, 
-                                           const GIDSet& unnec_gids,
+                                           const DenseGIDSet& unnec_gids,
                                            bool fast)
 {
   DBG(cout << "  refinement: " << unnec_gids.size() << " unnecessary groups: " 
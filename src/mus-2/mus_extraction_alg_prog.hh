@@ -108,7 +108,7 @@ protected:
    * @return r = number of groups removed from the range
    * @post p_removed' == p_removed - r
    */
-  size_t do_refinement(vector<GID>::iterator p_from, const GIDSet& unnec_gids, bool fast = true);
+  size_t do_refinement(vector<GID>::iterator p_from, const DenseGIDSet& unnec_gids, bool fast = true);
 
   /** Shifts falsified groups in the range [p_target, p_removed) to the end of the 
    * range, and adjusts p_target to point to the begining of false clauses.
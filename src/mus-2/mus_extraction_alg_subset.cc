@@ -124,17 +124,17 @@ namespace {
     // gives the greatest element first, we will return true if the sum of 
     // path counts of g2 is smaller than that of g1 (for order = 1)
     bool operator()(GID g1, GID g2) {
-      const BasicClauseVector& cls1 = _gs.gclauses(g1);
+      ClauseRange cls1 = _gs.gclauses(g1);
       double sum1 = 0;
-      for (BasicClauseVector::const_iterator pcl = cls1.begin(); 
+      for (crange_iterator pcl = cls1.begin(); 
            pcl != cls1.end(); ++pcl)
         if (!(*pcl)->removed()) {
           TraceAnalyzer::PathCountMap::const_iterator pm = _pm.find((*pcl)->ss_id()+1);
           sum1 += (pm == _pm.end()) ? 0 : pm->second;
         }
-      const BasicClauseVector& cls2 = _gs.gclauses(g2);
+      ClauseRange cls2 = _gs.gclauses(g2);
       double sum2 = 0;
-      for (BasicClauseVector::const_iterator pcl = cls2.begin(); 
+      for (crange_iterator pcl = cls2.begin(); 
            pcl != cls2.end(); ++pcl)
         if (!(*pcl)->removed()) {
           TraceAnalyzer::PathCountMap::const_iterator pm = _pm.find((*pcl)->ss_id()+1);
@@ -235,8 +235,8 @@ void MUSExtractionAlgSubset::operator()(void)
               subset_gids.insert(gid);
               DBG(cout << "  added group " << gid << ": ";
                   const TraceAnalyzer::PathCountMap& pcm = ta.compute_path_count_map();
-                  BasicClauseVector& cls = gset.gclauses(gid);
-                  for (cvec_iterator pcl = cls.begin(); pcl != cls.end(); ++pcl) {
+                  ClauseRange cls = gset.gclauses(gid);
+                  for (crange_iterator pcl = cls.begin(); pcl != cls.end(); ++pcl) {
                     BasicClause* cl = *pcl;
                     cout << "clause " << *cl << ", ss_id=" << cl->ss_id() << ", path_count=";
                     TraceAnalyzer::PathCountMap::const_iterator pm = pcm.find(cl->ss_id()+1);
@@ -333,7 +333,7 @@ void MUSExtractionAlgSubset::operator()(void)
         DBG(cout << "got a singleton, adding, rotating if needed." << endl;);
         // take care of the necessary group: put into MUSData, and mark final
         GID gid = *false_gids.begin();
-        _md.nec_gids().insert(gid);
+        _md.set_necessary(gid);
         _md.f_list().push_front(gid);
         // do rotation, if asked for it
         if (config.get_model_rotate_mode()) {
@@ -350,7 +350,7 @@ void MUSExtractionAlgSubset::operator()(void)
                  pgid != rm.nec_gids().end(); ++pgid) {
               // double-check check if not necessary already and not gid 0
               if (*pgid && !_md.nec(*pgid)) {
-                _md.nec_gids().insert(*pgid);
+                _md.set_necessary(*pgid);
                 _md.f_list().push_front(*pgid); 
                 r_count++;
               }
@@ -359,6 +359,7 @@ void MUSExtractionAlgSubset::operator()(void)
               cout_pref << "wrkr-" << _id << " " << r_count
                         << " groups are necessary due to rotation." << endl;
             _rot_groups += r_count;
+            _schecker.note_rotated(r_count);
           }
           rm.reset();
         }
@@ -370,15 +371,15 @@ void MUSExtractionAlgSubset::operator()(void)
       ++_sat_outcomes;
     } else { // gsc.status = UNSAT
       // take care of unnecessary groups
-      GIDSet& ugids = css.unnec_gids();
+      DenseGIDSet& ugids = css.unnec_gids();
       DBG(cout << "UNSAT: " << ugids.size() << " unnecessary groups." << endl;);
       if (!ugids.empty()) {
-        for (GIDSetIterator pgid = ugids.begin(); pgid != ugids.end(); ++pgid) {
-          _md.r_gids().insert(*pgid);
+        for (DenseGIDSet::iterator pgid = ugids.begin(); pgid != ugids.end(); ++pgid) {
+          _md.set_removed(*pgid);
           _md.r_list().push_front(*pgid);
           // mark the clauses as removed (and update counts in the occlist)
-          BasicClauseVector& clv = gset.gclauses(*pgid);
-          for (cvec_iterator pcl = clv.begin(); pcl != clv.end(); ++pcl) {
+          ClauseRange clv = gset.gclauses(*pgid);
+          for (crange_iterator pcl = clv.begin(); pcl != clv.end(); ++pcl) {
             if (!(*pcl)->removed()) {
               (*pcl)->mark_removed();
               if (gset.has_occs_list())
@@ -490,9 +491,9 @@ namespace {
   // is UNSAT iff at least one clause is UNSAT, undetermined otherwise
   int tv_group(const IntVector& ass, const BasicGroupSet& gset, GID gid)
   {
-    const BasicClauseVector& clauses = gset.gclauses(gid);
+    ClauseRange clauses = gset.gclauses(gid);
     unsigned sat_count = 0;
-    for (cvec_citerator pcl = clauses.begin(); pcl != clauses.end(); ++pcl) {
+    for (crange_iterator pcl = clauses.begin(); pcl != clauses.end(); ++pcl) {
       if ((*pcl)->removed())
         continue;
       int tv = tv_clause(ass, *pcl);
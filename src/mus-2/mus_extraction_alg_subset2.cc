@@ -144,6 +144,7 @@ void MUSExtractionAlgSubset2::operator()(void)
               cout_pref << "wrkr-" << _id << " " << r_count
                         << " groups are necessary due to rotation." << endl;
             _rot_groups += r_count;
+            _schecker.note_rotated(r_count);
           }
           rm.reset();
         }
@@ -155,7 +156,7 @@ void MUSExtractionAlgSubset2::operator()(void)
       ++_sat_outcomes;
     } else { // gsc.status = UNSAT
       // take care of unnecessary groups
-      GIDSet& ugids = css.unnec_gids();
+      DenseGIDSet& ugids = css.unnec_gids();
       DBG(cout << "UNSAT: " << ugids.size() << " unnecessary groups." << endl;);
       for (GID gid : ugids) 
         _md.mark_removed(gid);
@@ -253,9 +254,9 @@ namespace {
   // is UNSAT iff at least one clause is UNSAT, undetermined otherwise
   int tv_group(const IntVector& ass, const BasicGroupSet& gset, GID gid)
   {
-    const BasicClauseVector& clauses = gset.gclauses(gid);
+    ClauseRange clauses = gset.gclauses(gid);
     unsigned sat_count = 0;
-    for (cvec_citerator pcl = clauses.begin(); pcl != clauses.end(); ++pcl) {
+    for (crange_iterator pcl = clauses.begin(); pcl != clauses.end(); ++pcl) {
       if ((*pcl)->removed())
         continue;
       int tv = tv_clause(ass, *pcl);
@@ -25,12 +25,15 @@
 #include "mus_extraction_alg_prog.hh"
 #include "random_scheduler.hh"
 #include "rgraph_scheduler.hh"
+#include "rotation_cache.hh"
 #ifdef MULTI_THREADED
-#include <tbb/tbb.h>
-#include <tbb/tick_count.h>
-#include <tbb/tbb_thread.h>
-#include <tbb/compat/thread>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <memory>
 #include "linear_scheduler_mt.hh"
+#include "stealing_scheduler_mt.hh"
 #endif
 
 #ifndef MULTI_THREADED
@@ -46,6 +49,8 @@ bool MUSExtractor::process(ComputeMUS& cm)
   if (_pschecker == NULL) {
     _pschecker = new SATChecker(_imgr, config);
     _pschecker->set_pre_mode(config.get_solpre_mode());
+    if (_plcls != NULL)
+      _pschecker->import_learnts(*_plcls);
     own_schecker = true;
   }
   ModelRotator* pmrotter = 0;
@@ -71,6 +76,12 @@ bool MUSExtractor::process(ComputeMUS& cm)
   if (pmrotter == 0) // shouldn't happen
     throw std::logic_error("could not pick model rotator");
   ModelRotator& mrotter(*pmrotter);
+  // cache of visited rotation points (shared by all rotation calls)
+  RotationCache* prcache = 0;
+  if (config.get_rcache_size()) {
+    prcache = new RotationCache(config.get_rcache_size());
+    mrotter.set_cache(prcache);
+  }
 
   // scheduler
   GroupScheduler* psched = 0;
@@ -156,11 +167,18 @@ bool MUSExtractor::process(ComputeMUS& cm)
   _sat_calls = mus_thread.sat_calls();
   _rot_groups = mus_thread.rot_groups();
   _ref_groups = mus_thread.ref_groups();
+  _tail_groups = mus_thread.tail_groups();
+  _tail_time = mus_thread.tail_time();
+  if ((prcache != 0) && (config.get_verbosity() >= 2))
+    cout_pref << "Rotation cache: " << prcache->lookups() << " lookups, "
+              << prcache->hits() << " hits, " << prcache->capacity()
+              << " slots" << endl;
 
   delete &mus_thread;
   delete &sched;
   delete &mrotter;
-  if (own_schecker) { delete _pschecker; }
+  delete prcache;
+  if (own_schecker) { delete _pschecker; } else { _pschecker->flush_telemetry(); }
 
   cm.set_completed();
   return true;  // all good
@@ -168,19 +186,27 @@ bool MUSExtractor::process(ComputeMUS& cm)
 
 #else 
 
-/* Handles the ComputeMUS work item (multi-threaded mode)
+/* Handles the ComputeMUS work item (multi-threaded mode): each thread runs 
+ * the deletion-based algorithm with its own SAT checker and model rotator; the
+ * MUS data (must be an instance of MUSDataMT) and the scheduler are shared.
  */
 bool MUSExtractor::process(ComputeMUS& cm)
 {
   MUSData& md = cm.md();
 
-  // figure out the actual number of threads
+  if (!config.get_del_mode() || config.get_var_mode())
+    throw std::logic_error("multi-threaded mode supports deletion-based "
+                           "(G)MUS extraction only");
+
+  // figure out the actual number of threads (an explicit request is honoured
+  // even if it exceeds the h/w concurrency)
   unsigned num_threads = config.get_num_threads();
-  if ((num_threads == 0) || (num_threads > thread::hardware_concurrency()))
-    num_threads = thread::hardware_concurrency();
+  unsigned hw_threads = std::max(1U, std::thread::hardware_concurrency());
+  if (num_threads == 0)
+    num_threads = hw_threads;
   
   cout_pref << "Number of threads (used/avail): " << num_threads << "/"
-            << thread::hardware_concurrency() << endl;
+            << hw_threads << endl;
   assert(num_threads);
 
   // clones of ID manager
@@ -189,41 +215,92 @@ bool MUSExtractor::process(ComputeMUS& cm)
   // sat checkers -- if one is given, reuse it
   vector<SATChecker*> scheckers(num_threads, _pschecker);
   for (unsigned id = 0; id < num_threads; id++)
-    if (id > 0 || _pschecker == NULL)
+    if (id > 0 || _pschecker == NULL) {
       scheckers[id] = new SATChecker(imgrs[id], config, id);
+      scheckers[id]->set_pre_mode(config.get_solpre_mode());
+      if (_plcls != NULL)
+        scheckers[id]->import_learnts(*_plcls);
+    }
 
-  // scheduler (TODO: pick one based on configuration)
-  LinearSchedulerMT sched(md, num_threads);
+  // scheduler
+  std::unique_ptr<GroupScheduler> psched;
+  if (config.get_ws_sched_mode())
+    psched.reset(new StealingSchedulerMT(md, num_threads,
+                                         config.get_order_mode() == 3));
+  else
+    psched.reset(new LinearSchedulerMT(md, num_threads,
+                                       config.get_order_mode() == 3));
   //BlockSchedulerMT sched(md, num_threads);
+  GroupScheduler& sched = *psched;
   
-  // rotator(s) TEMP: will not be used
-  ModelRotator& mrotter(*new ModelRotator());
-  assert(!config.get_model_rotate_mode());
+  // rotators -- one per thread, as they keep their own state
+  vector<ModelRotator*> mrotters(num_threads);
+  for (unsigned id = 0; id < num_threads; id++) {
+    if (!config.get_model_rotate_mode())
+      mrotters[id] = new ModelRotator();  // dummy one
+    else if (config.get_rmr_mode() && (config.get_rot_threads() > 1))
+      mrotters[id] = new ParallelModelRotator(config.get_rot_threads());
+    else if (config.get_rmr_mode())
+      mrotters[id] = new RecursiveModelRotator();
+    else if (config.get_emr_mode())
+      mrotters[id] = new ExtendedModelRotator();
+    else
+      throw std::logic_error("the model rotator is not supported in "
+                             "multi-threaded mode");
+  }
+  // cache of visited rotation points (shared by all threads)
+  RotationCache* prcache = 0;
+  if (config.get_rcache_size()) {
+    prcache = new RotationCache(config.get_rcache_size());
+    for (unsigned id = 0; id < num_threads; id++)
+      mrotters[id]->set_cache(prcache);
+  }
+
+  // the algorithms
+  vector<MUSExtractionAlgDel*> algs(num_threads);
+  for (unsigned id = 0; id < num_threads; id++) {
+    algs[id] = new MUSExtractionAlgDel(imgrs[id], config, *scheckers[id], 
+                                       *mrotters[id], md, sched);
+    algs[id]->set_cpu_time_limit(_cpu_time_limit);
+    algs[id]->set_iter_limit(_iter_limit);
+  }
 
   // off we go ...
   double t_start = RUSAGE::read_cpu_time();
-  tbb::tick_count wt_start = tbb::tick_count::now();
-  vector<thread*> mus_threads(num_threads);
+  auto wt_start = std::chrono::steady_clock::now();
+  vector<std::thread> mus_threads;
   for (unsigned id = 0; id < num_threads; id++)
-    mus_threads[id] = 
-      new thread(MUSExtractionAlgDel(_imgr, config, *scheckers[id], mrotter, md, sched));
+    mus_threads.emplace_back(std::ref(*algs[id]));
   // wait for them to finish ...
-  for (unsigned id = 0; id < num_threads; id++)
-      mus_threads[id]->join();      
+  for (auto& t : mus_threads)
+    t.join();
   // done
-  tbb::tick_count wt_end = tbb::tick_count::now();
+  auto wt_end = std::chrono::steady_clock::now();
   double t_end = RUSAGE::read_cpu_time();    
 
   // stats and cleanup
   _cpu_time = t_end - t_start;
-  _wc_time = (wt_end - wt_start).seconds();
-  _sat_calls = _rot_groups = 0; // TEMP - figure out how to do this 
-  delete &mrotter;
+  _wc_time = std::chrono::duration<double>(wt_end - wt_start).count();
+  _sat_calls = _rot_groups = _ref_groups = _tail_groups = 0;
+  _tail_time = 0;
   for (unsigned id = 0; id < num_threads; id++) {
-    delete mus_threads[id];
+    _sat_calls += algs[id]->sat_calls();
+    _rot_groups += algs[id]->rot_groups();
+    _ref_groups += algs[id]->ref_groups();
+    _tail_groups += algs[id]->tail_groups();
+    _tail_time += algs[id]->tail_time();
+    delete algs[id];
+    delete mrotters[id];
     if (id > 0 || _pschecker == NULL)
       delete scheckers[id];
+    else
+      scheckers[id]->flush_telemetry();
   }
+  if ((prcache != 0) && (config.get_verbosity() >= 2))
+    cout_pref << "Rotation cache: " << prcache->lookups() << " lookups, "
+              << prcache->hits() << " hits, " << prcache->capacity()
+              << " slots" << endl;
+  delete prcache;
 
   // done
   cm.set_completed();
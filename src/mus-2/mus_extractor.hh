@@ -54,6 +54,10 @@ public:
   void set_sat_checker(SATChecker* pschecker) { _pschecker = pschecker; }
   SATChecker* sat_checker(void) { return _pschecker; }
 
+  // learnt clauses -- if set before process(), then the checkers made for
+  // extraction start with these (see SATChecker::import_learnts())
+  void set_learnts(const std::vector<MUSer2::GroupLearnt>* plcls) { _plcls = plcls; }
+
   // functionality
 
   using Worker::process;
@@ -90,6 +94,13 @@ public:
   /* Returns the number of groups removed with refinement */
   unsigned ref_groups(void) const { return _ref_groups; }
 
+  /* Returns the number of hard groups in approximation mode 3, i.e. the ones
+   * that were checked without limits in the end */
+  unsigned tail_groups(void) const { return _tail_groups; }
+
+  /* Returns the SAT time (seconds) spent on the hard groups (approx. mode 3) */
+  double tail_time(void) const { return _tail_time; }
+
 protected:
   
   IDManager& _imgr;             // id manager
@@ -98,6 +109,9 @@ protected:
 
   SATChecker* _pschecker = NULL;// pointer to SAT checker (to reuse)
 
+  const std::vector<MUSer2::GroupLearnt>* _plcls = NULL; // learnt clauses to
+                                // start the new checkers with (if any)
+
   double _cpu_time_limit = 0;   // soft limit on CPU time 
 
   unsigned _iter_limit = 0;     // limit on the number of iterations
@@ -110,6 +124,10 @@ protected:
 
   unsigned _ref_groups = 0;     // groups removed with refinement
 
+  unsigned _tail_groups = 0;    // hard groups (approximation mode 3)
+
+  double _tail_time = 0;        // SAT time on the hard groups (approx. mode 3)
+
 #ifdef MULTI_THREADED
   double _wc_time = 0;          // elapsed wall-clock time (seconds)
 #endif
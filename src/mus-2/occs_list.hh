@@ -8,8 +8,7 @@
  * 
  * Notes:
  *      1. IMPORTANT: this implementation is NOT multi-thread safe.
- *      2. TODO: important -- provide iterators that automatically drop the
- *         removed clauses. And make an MT-safe version !!!!
+ *      2. TODO: make an MT-safe version !!!!
  *      3. TODO: possibly lits to groups ? groups to lits ? 
  *
  *                                              Copyright (c) 2011, Anton Belov
@@ -38,6 +37,26 @@
  *  The _i versions of methods take the *index* of literal, rather than the
  *  literal itself, directly.
  *
+ *  2. The lists are stored in compressed sparse row (CSR) form: the lists of
+ *  all literals are kept back to back in a single vector, and each literal
+ *  has the offset and the size of its list. The clauses added after the CSR
+ *  has been built go into a per-literal tail. compact() rebuilds the CSR
+ *  from the lists and the tails, dropping the removed clauses on the way;
+ *  maybe_compact() does so only when at least half of the entries are dead
+ *  or in the tails (BasicGroupSet calls it whenever a group is removed).
+ *
+ *  3. The removed clauses stay in the lists until the next compaction, but
+ *  the iterators of the lists (clauses()) skip them. Appending to the tail
+ *  of a literal while iterating over its list is fine; compact() and clear()
+ *  invalidate the iterators.
+ *
+ *  4. The lists hold clause pointers, not clause indices. There is no stable
+ *  index to use: the lists are also built over plain BasicClauseSets (BCE),
+ *  clauses are added to a group set after the lists are built (e.g. the VE
+ *  resolvents), and BasicGroupSet::layout() re-orders its clause vector.
+ *  Besides, every access dereferences the clause anyway (removed() check in
+ *  the iterators), so an index would only add an indirection.
+ *
 \*----------------------------------------------------------------------------*/
 
 class OccsList {
@@ -53,34 +72,75 @@ public:       // Lifecycle
 
   /* Reserves memory for the map; max_var is the expected maximum variable index. */
   void init(unsigned max_var) { 
-    _clauses.reserve(l2i(-(LINT)max_var)+1);
-    _active_sizes.reserve(l2i(-(LINT)max_var)+1);
+    size_t n = l2i(-(LINT)max_var) + 1;
+    _first.reserve(n + 1);
+    _csize.reserve(n);
+    _tails.reserve(n);
+    _active_sizes.reserve(n);
   }
 
   /* Ensures that the map has support for up to max_var variables. */
   void resize(unsigned max_var) { 
-    _clauses.resize(l2i(-(LINT)max_var)+1);
-    _active_sizes.resize(l2i(-(LINT)max_var)+1, 0);
+    size_t n = l2i(-(LINT)max_var) + 1;
+    if (n <= _active_sizes.size())
+      return;
+    _first.resize(n + 1, _occs.size());
+    _csize.resize(n, 0);
+    _tails.resize(n);
+    _active_sizes.resize(n, 0);
   }
   
   /* True if the map is empty */
-  bool empty(void) const { return _clauses.empty(); }
+  bool empty(void) const { return _active_sizes.empty(); }
 
   /* Clears everything out */
-  void clear(void) { _clauses.clear(); _active_sizes.clear(); }
+  void clear(void) {
+    _occs.clear(); _first.assign(1, 0); _csize.clear(); _tails.clear();
+    _active_sizes.clear(); _entries = _dead = _ntail = 0;
+  }
 
 public:       // Access to clauses
 
-  typedef std::vector<BasicClauseList>::const_iterator cl_citer;
+  /* Forward iterator over a list; skips the removed clauses */
+  class iterator : public std::iterator<std::forward_iterator_tag, BasicClause*> {
+  public:
+    iterator(void) {}
+    iterator(const OccsList* ol, int i)
+      : _csr(ol->_occs.data() + ol->_first[i]), _ncsr(ol->_csize[i]),
+        _tail(&ol->_tails[i]) { _skip(); }
+    BasicClause* operator*(void) const {
+      return (_pos < _ncsr) ? _csr[_pos] : (*_tail)[_pos - _ncsr]; }
+    iterator& operator++(void) { ++_pos; _skip(); return *this; }
+    iterator operator++(int) { iterator res(*this); ++*this; return res; }
+    bool operator==(const iterator& o) const {
+      bool e = _at_end(), oe = o._at_end();
+      return (e || oe) ? (e && oe) : (_pos == o._pos); }
+    bool operator!=(const iterator& o) const { return !(*this == o); }
+  private:
+    bool _at_end(void) const {
+      return (_tail == 0) || (_pos >= _ncsr + _tail->size()); }
+    void _skip(void) { while (!_at_end() && (**this)->removed()) ++_pos; }
+    BasicClause* const* _csr = 0;       // the list in the CSR
+    size_t _ncsr = 0;                   // its size
+    const BasicClauseVector* _tail = 0; // the tail (0 for end())
+    size_t _pos = 0;                    // position in the CSR, then the tail
+  };
 
-  cl_citer cl_begin(void) const { return _clauses.begin(); }
-  cl_citer cl_end(void) const { return _clauses.end(); }
+  /* The (non-removed) clauses of a literal */
+  class range {
+  public:
+    range(const OccsList* ol, int i) : _ol(ol), _i(i) {}
+    iterator begin(void) const { return iterator(_ol, _i); }
+    iterator end(void) const { return iterator(); }
+    bool empty(void) const { return begin() == end(); }
+  private:
+    const OccsList* _ol;
+    int _i;
+  };
 
-  BasicClauseList& clauses(LINT lit) { return _clauses[l2i(lit)]; }
-  const BasicClauseList& clauses(LINT lit) const { return _clauses[l2i(lit)]; }
+  range clauses(LINT lit) const { return range(this, l2i(lit)); }
   // direct
-  BasicClauseList& clauses_i(int i) { return _clauses[i]; }
-  const BasicClauseList& clauses_i(int i) const { return _clauses[i]; }
+  range clauses_i(int i) const { return range(this, i); }
 
 public:      // Access to sizes
 
@@ -97,25 +157,78 @@ public:      // Access to sizes
 
 public:     // Support for operations
 
+  /* Adds the clause to the lists of all of its literals, and increments the
+   * active sizes */
+  void add_clause(BasicClause* cl) {
+    for (Literator pl = cl->begin(); pl != cl->end(); ++pl) {
+      int i = l2i(*pl);
+      _tails[i].push_back(cl);
+      ++_active_sizes[i];
+    }
+    _entries += cl->size();
+    _ntail += cl->size();
+  }
+
+  /* Drops the list of a literal (but does not touch its active size) */
+  void clear(LINT lit) {
+    int i = l2i(lit);
+    _entries -= _csize[i] + _tails[i].size();
+    _ntail -= _tails[i].size();
+    _csize[i] = 0;
+    BasicClauseVector().swap(_tails[i]);
+  }
+
   // decrements active size of each literal in the clause
   void update_active_sizes(BasicClause* cl) {
     for (Literator pl = cl->abegin(); pl != cl->aend(); ++pl)
       if (active_size(*pl)) // b/c could be removed
         --active_size(*pl);
+    _dead += cl->size();
+  }
+
+  /* Compacts the lists if worthwhile; returns true if compacted */
+  bool maybe_compact(void) {
+    if ((_entries < min_compact) || (2 * (_dead + _ntail) < _entries))
+      return false;
+    compact();
+    return true;
+  }
+
+  /* Rebuilds the CSR from the lists and their tails, and drops the removed
+   * clauses */
+  void compact(void) {
+    size_t n = _active_sizes.size();
+    std::vector<size_t> first(n + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+      size_t live = 0;
+      for (BasicClause* cl : clauses_i(i)) { (void)cl; ++live; }
+      first[i + 1] = first[i] + live;
+    }
+    BasicClauseVector occs(first[n]);
+    for (size_t i = 0; i < n; ++i) {
+      size_t pos = first[i];
+      for (BasicClause* cl : clauses_i(i))
+        occs[pos++] = cl;
+      _csize[i] = first[i + 1] - first[i];
+      if (!_tails[i].empty()) { BasicClauseVector().swap(_tails[i]); }
+    }
+    _occs.swap(occs);
+    _first.swap(first);
+    _entries = _occs.size();
+    _dead = _ntail = 0;
   }
 
 public:     // Debugging
 
   void dump(std::ostream& out = std::cout) const {
     out << "Occurences list: " << std::endl;
-    int idx = 0;
-    for (OccsList::cl_citer pl = cl_begin(); pl != cl_end(); ++pl, ++idx) {
-      if (!pl->empty()) {
+    for (size_t idx = 0; idx < _active_sizes.size(); ++idx) {
+      range cls = clauses_i(idx);
+      if (!cls.empty()) {
         out << "  " << OccsList::i2l(idx) << ":";
         out << "(active size = " << _active_sizes[idx] << "): ";
-        for(BasicClauseList::const_iterator pcl = pl->begin(); 
-            pcl != pl->end(); ++pcl) {
-          cout << " "; (*pcl)->dump(cout);
+        for (BasicClause* cl : cls) {
+          cout << " "; cl->dump(cout);
         }
         cout << std::endl;
       }
@@ -129,9 +242,24 @@ public:     // Debugging
 
 private:
 
-  std::vector<BasicClauseList> _clauses;        // index = literal index;
+  static const size_t min_compact = 1 << 12;    // don't bother below this
+
+  BasicClauseVector _occs;                      // the CSR: all lists
+
+  std::vector<size_t> _first{0};                // index = literal index;
+                                                // start of the list in _occs
+  std::vector<ULINT> _csize;                    // index = literal index;
+                                                // size of the list in _occs
+  std::vector<BasicClauseVector> _tails;        // index = literal index;
+                                                // added since compact()
+  std::vector<unsigned> _active_sizes;          // index = literal index;
+
+  size_t _entries = 0;                          // entries in lists and tails
+
+  size_t _dead = 0;                             // entries of removed clauses
+
+  size_t _ntail = 0;                            // entries in the tails
   
-  std::vector<unsigned> _active_sizes;            // index = literal index;
 };
 
 #endif /* _OCCS_LISTS_HH */
@@ -0,0 +1,151 @@
+/*----------------------------------------------------------------------------*\
+ * File:        packed_assignment.hh
+ *
+ * Description: Class definition and implementation of bit-parallel (packed)
+ *              assignments for evaluating up to 64 single-variable flips of an
+ *              assignment at once.
+ *
+ * Author:      agent
+ *
+ *                                                     Copyright (c) 2026, agent
+ \*----------------------------------------------------------------------------*/
+
+#ifndef _PACKED_ASSIGNMENT_HH
+#define _PACKED_ASSIGNMENT_HH 1
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "basic_clause.hh"
+#include "cl_types.hh"
+#include "types.hh"
+
+/*----------------------------------------------------------------------------*\
+ * Class:  PackedAssignment
+ *
+ * Purpose: A set of up to 64 assignments ("lanes") packed into a machine word
+ *          per variable: lane k is the base assignment with the k-th flipped
+ *          variable flipped. Truth values of clauses are computed for all
+ *          lanes at once, with no branching per literal.
+ *
+ * Notes:
+ *      1. The base assignment is given in terms of -1;0;1 (as in Utils); the
+ *         unassigned variables are never false. The flipped variables must be
+ *         assigned, and must be distinct.
+ *      2. The base assignment is not copied -- it must not change while the
+ *         lanes are set.
+ *      3. false_lanes_memo() remembers the result for each clause until the
+ *         next set_lanes(); this is for the clauses that come up in the
+ *         occurrence lists of several flipped literals. The results are kept
+ *         in a vector indexed by clause ID, and are invalidated in O(1) by
+ *         bumping the round number -- set_lanes() allocates nothing once the
+ *         vectors have grown to size.
+ *      4. The rotators keep the base assignment in RotationCounters, and use
+ *         its counters to pick the clauses worth evaluating: a single flip
+ *         can only falsify a clause with at most one non-false literal.
+ *
+\*----------------------------------------------------------------------------*/
+
+class PackedAssignment {
+
+public:
+
+  typedef uint64_t Word;
+
+  static const unsigned max_lanes = 64;
+
+  /** Sets up the lanes for the variables in [vbeg, vend) (at most max_lanes)
+   * on top of the assignment ass */
+  template<class It>
+  void set_lanes(const IntVector& ass, It vbeg, It vend) {
+    clear_lanes();
+    _pass = &ass;
+    if (_flips.size() < ass.size())
+      _flips.resize(ass.size(), 0);
+    for (It pv = vbeg; pv != vend; ++pv) {
+      assert(_vars.size() < max_lanes);
+      _flips[*pv] = (Word)1 << _vars.size();
+      _vars.push_back(*pv);
+    }
+    _lanes = (_vars.size() == max_lanes) ? ~(Word)0 : (((Word)1 << _vars.size()) - 1);
+  }
+
+  /** Clears the lanes */
+  void clear_lanes(void) {
+    for (ULINT var : _vars) { _flips[var] = 0; }
+    _vars.clear();
+    _lanes = 0;
+    if (++_round == 0) { // wrapped around -- clear the stamps
+      std::fill(_memo_stamp.begin(), _memo_stamp.end(), 0);
+      _round = 1;
+    }
+  }
+
+  /** Returns the mask of the lanes in use */
+  Word lanes(void) const { return _lanes; }
+
+  /** Returns the variable flipped in a given lane */
+  ULINT lane_var(unsigned lane) const { return _vars[lane]; }
+
+  /** Returns the number of lanes in use */
+  unsigned num_lanes(void) const { return _vars.size(); }
+
+  /** Returns the mask of the lanes in which a literal is not false */
+  Word lit_val(LINT lit) const {
+    ULINT var = std::abs(lit);
+    int val = (*_pass)[var];
+    if (val == 0)
+      return ~(Word)0;
+    Word w = ((val > 0) == (lit > 0)) ? ~(Word)0 : 0;
+    return w ^ _flips[var];
+  }
+
+  /** Returns the mask of the lanes in which the clause is false */
+  Word false_lanes(const BasicClause* cl) const {
+    Word tv = 0;
+    for (CLiterator lpos = cl->abegin(); lpos != cl->aend(); ++lpos) {
+      tv |= lit_val(*lpos);
+      if ((tv & _lanes) == _lanes)
+        break;
+    }
+    return ~tv & _lanes;
+  }
+
+  /** Same as false_lanes(), but remembers the result until the next call to
+   * set_lanes() */
+  Word false_lanes_memo(const BasicClause* cl) {
+    ULINT id = cl->get_id();
+    if (id >= _memo_stamp.size()) {
+      _memo_stamp.resize(id + 1, 0);
+      _memo.resize(id + 1, 0);
+    }
+    if (_memo_stamp[id] != _round) {
+      _memo[id] = false_lanes(cl);
+      _memo_stamp[id] = _round;
+    }
+    return _memo[id];
+  }
+
+private:
+
+  const IntVector* _pass = nullptr;     // the base assignment
+
+  std::vector<Word> _flips;             // per variable: the lanes it is flipped in
+
+  std::vector<ULINT> _vars;             // per lane: the flipped variable
+
+  Word _lanes = 0;                      // the mask of the lanes in use
+
+  std::vector<Word> _memo;              // per clause ID: the memoized result
+
+  std::vector<unsigned> _memo_stamp;    // per clause ID: round of _memo
+
+  unsigned _round = 1;                  // the current round (see note 3.)
+
+};
+
+#endif // _PACKED_ASSIGNMENT_HH
+
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,240 @@
+/*----------------------------------------------------------------------------*\
+ * File:        parallel_model_rotator.cc
+ *
+ * Description: Implementation of model rotator that runs RMR (FMCAD-2011) on
+ *              a pool of threads.
+ *
+ * Author:      agent
+ *
+ * Notes:
+ *
+ *   1. Available in multi-threaded mode only.
+ *
+ *                                                     Copyright (c) 2026, agent
+ \*----------------------------------------------------------------------------*/
+
+#ifdef MULTI_THREADED
+
+#ifdef NDEBUG
+//#undef NDEBUG // enable assertions (careful !)
+#endif
+
+#include <cassert>
+#include <iostream>
+#include <utility>
+#include "basic_group_set.hh"
+#include "types.hh"
+#include "model_rotator.hh"
+
+using namespace std;
+
+//#define DBG(x) x
+
+/* Starts the threads
+ */
+ParallelModelRotator::ParallelModelRotator(unsigned num_threads, unsigned id)
+  : ModelRotator(id), _num_threads(max(1U, num_threads)), _locals(_num_threads)
+{
+  for (unsigned tid = 1; tid < _num_threads; tid++)
+    _threads.emplace_back(&ParallelModelRotator::_worker, this, tid);
+}
+
+/* Stops the threads
+ */
+ParallelModelRotator::~ParallelModelRotator(void)
+{
+  {
+    lock_guard<mutex> lk(_mtx);
+    _quit = true;
+  }
+  _cv_start.notify_all();
+  for (auto& t : _threads)
+    t.join();
+}
+
+/* Handles the RotateModel work item
+ */
+bool ParallelModelRotator::process(RotateModel& rm)
+{
+  BasicGroupSet& gs = rm.md().gset();
+
+  DBG(cout << "+ParallelModelRotator::process(" << rm.gid() << ")" << endl;);
+
+  // set up the call: a new round for the claims (and the thread-local
+  // assignments), which are reset if needed
+  if (++_round == 0 || _claimed.size() <= gs.max_gid()) {
+    _claimed = vector<atomic<unsigned> >(gs.max_gid() + 1);
+    if (_round == 0) {
+      for (Local& loc : _locals) { loc.round = 0; }
+      _round = 1;
+    }
+  }
+  start_points(rm.model());
+  _prm = &rm;
+  _abort = false;
+
+  // BFS, level by level; the first level is the group itself (delta is empty)
+  _level.clear();
+  _level.emplace_back(rm.gid());
+  while (!_level.empty() && !_abort) {
+    DBG(cout << "  level of " << _level.size() << " points" << endl;);
+    _next_point = 0;
+    if ((_level.size() > 1) && (_num_threads > 1)) {
+      {
+        lock_guard<mutex> lk(_mtx);
+        _busy = _num_threads - 1;
+        ++_level_gen;
+      }
+      _cv_start.notify_all();
+      _run_level(_locals[0]);
+      unique_lock<mutex> lk(_mtx);
+      _cv_done.wait(lk, [this]{ return _busy == 0; });
+    } else
+      _run_level(_locals[0]);
+    // merge the results of the level
+    vector<Point> next;
+    for (Local& loc : _locals) {
+      for (GID gid : loc.nec_gids)
+        rm.nec_gids().insert(gid);
+      loc.nec_gids.clear();
+      move(loc.next.begin(), loc.next.end(), back_inserter(next));
+      loc.next.clear();
+    }
+    _level.swap(next);
+  }
+  for (Local& loc : _locals) {
+    if (rm.collect_ft_gids())
+      copy(loc.ft_gids.begin(), loc.ft_gids.end(),
+           inserter(rm.ft_gids(), rm.ft_gids().end()));
+    loc.ft_gids.clear();
+    _num_points += loc.num_points;
+    loc.num_points = 0;
+  }
+  _level.clear();
+  _prm = 0;
+  rm.set_completed();
+  DBG(cout << "-ParallelModelRotator::process(" << rm.gid() << ")" << endl;);
+  return rm.completed();
+}
+
+/* Thread main: processes the levels as they come
+ */
+void ParallelModelRotator::_worker(unsigned tid)
+{
+  unsigned gen = 0;
+  while (true) {
+    {
+      unique_lock<mutex> lk(_mtx);
+      _cv_start.wait(lk, [&]{ return _quit || (_level_gen != gen); });
+      if (_quit)
+        return;
+      gen = _level_gen;
+    }
+    _run_level(_locals[tid]);
+    lock_guard<mutex> lk(_mtx);
+    if (--_busy == 0)
+      _cv_done.notify_one();
+  }
+}
+
+/* Processes the points of the current level, taking one at a time
+ */
+void ParallelModelRotator::_run_level(Local& loc)
+{
+  size_t i;
+  while (((i = _next_point.fetch_add(1)) < _level.size()) && !_abort)
+    _process_point(loc, _level[i]);
+}
+
+/* Processes one point: this is the body of the main loop of
+ * RecursiveModelRotatorTmpl::process() with DeciderRMR, except that the
+ * necessary groups are claimed, and the results go to loc
+ */
+void ParallelModelRotator::_process_point(Local& loc, const Point& p)
+{
+  RotateModel& rm = *_prm;
+  MUSData& md = rm.md();
+  BasicGroupSet& gs = md.gset();
+  OccsList& o_list = gs.occs_list();
+  GID gid = p.gid;
+
+  // skip the points visited already (in this or an earlier call)
+  if (seen_point(RotationCache::gid_key(gid), p.delta))
+    return;
+
+  // update working assignment (don't forget to restore)
+  if (loc.round != _round) {
+    loc.rc.reset(gs, rm.model());
+    loc.round = _round;
+  }
+  for (ULINT var : p.delta)
+    loc.rc.flip(var);
+  const IntVector& curr_ass = loc.rc.ass();
+
+  // collect the set of variables that appear in the falsified clauses of gid
+  IntSet cand_vars;
+  ClauseRange gclauses = gs.gclauses(gid);
+  for (crange_iterator pcl = gclauses.begin(); pcl != gclauses.end(); ++pcl) {
+    if ((*pcl)->removed())
+      continue;
+    else if (loc.rc.is_false(*pcl)) {
+      if ((*pcl)->asize() == 0) { // empty clause -- get out, can't do anything
+        _abort = true;
+        break;
+      }
+      for(CLiterator lpos = (*pcl)->abegin(); lpos != (*pcl)->aend(); ++lpos)
+        cand_vars.insert(abs(*lpos));
+    }
+  }
+  assert(_abort || !cand_vars.empty()); // o/w gid is not UNSAT !
+
+  // now, for each candidate -- flip and calculate the set of falsified group
+  // ids -- if its of size 1, it will go into the next level
+  for (IntSet::iterator pv = cand_vars.begin(); !_abort && pv != cand_vars.end(); ++pv) {
+    LINT lit = *pv * curr_ass[*pv]; // clauses with lit might become falsified
+    loc.rc.flip(*pv);
+    // skip if any clause of gid is still false; otherwise run through the
+    // clauses that contain lit, and collect the gids of the clauses that
+    // *became* falsified due to the flip (up to 2)
+    if (loc.rc.num_false(gid) == 0) {
+      GID new_gids[2];
+      unsigned count = 0;
+      OccsList::range lclauses = o_list.clauses(lit); // skips removed clauses
+      for (OccsList::iterator pcl = lclauses.begin(); pcl != lclauses.end(); ++pcl) {
+        if (loc.rc.is_false(*pcl)) {
+          GID cand_gid = (*pcl)->get_grp_id();
+          if (((cand_gid != 0) || !rm.ignore_g0())
+              && ((count == 0) || (new_gids[0] != cand_gid)))
+            new_gids[count++] = cand_gid;
+          if (count > 1)
+            break;
+        }
+      }
+      if (count == 1) {
+        // the decider of RMR, with the local set replaced by the claims
+        GID new_gid = new_gids[0];
+        if (rm.ignore_global() || !md.nec(new_gid)) {
+          unsigned old = _claimed[new_gid].load();
+          if ((old != _round) && _claimed[new_gid].compare_exchange_strong(old, _round)) {
+            loc.nec_gids.push_back(new_gid);
+            loc.next.emplace_back(new_gid, p.delta, *pv);
+          }
+        }
+      } else if (rm.collect_ft_gids()) {
+        // remember the gids to fastrack
+        for (unsigned i = 0; i < count; i++)
+          loc.ft_gids.insert(new_gids[i]);
+      }
+    }
+    // unflip
+    loc.rc.flip(*pv);
+  }
+  // restore working model
+  for (ULINT var : p.delta)
+    loc.rc.flip(var);
+  loc.num_points++;
+}
+
+#endif // MULTI_THREADED
+
+/*----------------------------------------------------------------------------*/
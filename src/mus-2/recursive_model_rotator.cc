@@ -18,6 +18,7 @@
 //#undef NDEBUG // enable assertions (careful !)
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <ext/hash_set>
 #include <unordered_map>
@@ -27,7 +28,8 @@
 #include "basic_group_set.hh"
 #include "types.hh"
 #include "model_rotator.hh"
-#include "utils.hh"
+#include "packed_assignment.hh"
+#include "rotation_counters.hh"
 
 using namespace std;
 using namespace __gnu_cxx;
@@ -57,9 +59,8 @@ bool RecursiveModelRotatorTmpl<Dec>::process(RotateModel& rm)
   OccsList& o_list = gs.occs_list();
   const IntVector& orig_model = rm.model();
 
-#ifdef MULTI_THREADED
-  throw logic_error("RecursiveModelRotatorTmpl::process() is not ready for multi-threaded mode.");
-#endif
+  // NOTE: in multi-threaded mode the caller holds the read-lock on MUSData for
+  // the duration of the call, so the occs lists are not cleaned up on the way.
 
   DBG(cout << "+RecursiveModelRotatorTmpl::process(" << rm.gid() << ")" << endl;);
 
@@ -72,18 +73,27 @@ bool RecursiveModelRotatorTmpl<Dec>::process(RotateModel& rm)
 
   // the first entry (delta is empty)
   rot_queue.push(rot_queue_entry(rm.gid()));
-  // a copy of the original model -- will be used as working assignment.
-  IntVector curr_ass(orig_model);
+  // the working assignment (starts as the original model), with the counters
+  // of false clauses and groups -- a flip costs O(occs(var))
+  _rc.reset(gs, orig_model);
+  const IntVector& curr_ass = _rc.ass();
+  start_points(orig_model);
   while (!rot_queue.empty()) {
     rot_queue_entry& e = rot_queue.front();
     GID gid = e._gid;
     DBG(cout << "Rotating gid=" << gid;);
+    // skip the points visited already (in this or an earlier call)
+    if (seen_point(RotationCache::gid_key(gid), e._delta)) {
+      DBG(cout << ", visited already." << endl;);
+      rot_queue.pop();
+      continue;
+    }
 
-    // update working assignment and its hash (don't forget to restore)
+    // update working assignment (don't forget to restore)
     DBG(cout << ", delta: ";);
     for (list<ULINT>::iterator pv = e._delta.begin(); pv != e._delta.end(); ++pv) {
       DBG(cout << *pv << " ";);
-      Utils::flip(curr_ass, *pv);
+      _rc.flip(*pv);
     }
     DBG(cout << endl;);
 
@@ -92,84 +102,90 @@ bool RecursiveModelRotatorTmpl<Dec>::process(RotateModel& rm)
     //      calculate the set of falsified group ids; if the set becomes larger
     //      than one, abort; otherwise we've got another necessary group;
 
-    // collect the set of variables that appear in the falsified clauses of gid
+    // collect the set of variables that appear in the falsified clauses of gid,
+    // and the clauses of gid that a single flip might leave (or make) false
     IntSet cand_vars;
-    const BasicClauseVector& gclauses = gs.gclauses(gid);
-    for (cvec_citerator pcl = gclauses.begin(); pcl != gclauses.end(); ++pcl) {
+    BasicClauseVector g_clauses;
+    ClauseRange gclauses = gs.gclauses(gid);
+    for (crange_iterator pcl = gclauses.begin(); pcl != gclauses.end(); ++pcl) {
       if ((*pcl)->removed()) 
         continue;
-      else if (Utils::tv_clause(curr_ass, *pcl) == -1) {
+      ULINT nf = _rc.num_nonfalse(*pcl);
+      if (nf == 0) {
         if ((*pcl)->asize() == 0) { // empty clause -- get out, can't do anything
           DBG(cout << "Saw an empty clause, can't do anything else." << endl;);
           goto _done;
         }
         for(CLiterator lpos = (*pcl)->abegin(); lpos != (*pcl)->aend(); ++lpos)
           cand_vars.insert(abs(*lpos));
-      }       
+      }
+      if (nf <= 1)
+        g_clauses.push_back(*pcl);
     }
     assert(!cand_vars.empty()); // must be non-empty, o/w gid is not UNSAT !
 
-    // now, for each candidate -- flip and calculate the set of falsified group
-    // ids -- if its of size 1, it will go into the queue
-    for (IntSet::iterator pv = cand_vars.begin(); pv != cand_vars.end(); ++pv) {
-      LINT lit = *pv * curr_ass[*pv]; // clauses with lit might become falsified
-      Utils::flip(curr_ass, *pv);
-      DBG(cout << "  Checking var " << *pv << ", assigned " << curr_ass[*pv] << ": ";);
-      GIDSet new_gids; // these will be falsified gids -- this is a plubming
-                       // for the future work on dependencies
-      // run through group clauses -- if any clause is still false, add gid to
-      // new_gids;
-      for (cvec_citerator pcl = gclauses.begin(); pcl != gclauses.end(); ++pcl) {
-        if ((*pcl)->removed()) 
-          continue;
-        else if (Utils::tv_clause(curr_ass, *pcl) == -1) {
-          new_gids.insert(gid);
-          break;
+    // now, for each candidate -- calculate the set of falsified group ids under
+    // the flip -- if its of size 1, it will go into the queue; the candidates
+    // are evaluated in batches of up to 64 flips, one per lane of _pa, on top
+    // of the working assignment (which stays put)
+    {
+      vector<ULINT> cands(cand_vars.begin(), cand_vars.end());
+      for (size_t beg = 0; beg < cands.size(); beg += PackedAssignment::max_lanes) {
+        size_t end = min(cands.size(), beg + PackedAssignment::max_lanes);
+        _pa.set_lanes(curr_ass, cands.begin() + beg, cands.begin() + end);
+        // the lanes in which some clause of gid is still false are skipped
+        PackedAssignment::Word gid_false = 0;
+        for (cvec_citerator pcl = g_clauses.begin(); pcl != g_clauses.end(); ++pcl) {
+          gid_false |= _pa.false_lanes(*pcl);
+          if (gid_false == _pa.lanes())
+            break;
         }
-      }
-      // ok, run through the clauses that contain lit, and for any clause that
-      // *became* falsified due to the flip, add its gid also to new_gids
-      if (new_gids.size() == 0) { // skip otherwise
-        BasicClauseList& lclauses = o_list.clauses(lit);
-        for (BasicClauseList::iterator pcl = lclauses.begin(); pcl != lclauses.end(); ) {
-          if ((*pcl)->removed()) { // clause is removed, update occslist
-            pcl = lclauses.erase(pcl);
+        for (unsigned k = 0; k < _pa.num_lanes(); ++k) {
+          PackedAssignment::Word bit = (PackedAssignment::Word)1 << k;
+          if (gid_false & bit)
             continue;
+          ULINT var = _pa.lane_var(k);
+          LINT lit = var * curr_ass[var]; // clauses with lit might become falsified
+          DBG(cout << "  Checking var " << var << ", assigned " << -curr_ass[var] << ": ";);
+          GIDSet new_gids; // these will be falsified gids -- this is a plubming
+                           // for the future work on dependencies
+          // run through the clauses that contain lit, and for any clause that
+          // *became* falsified due to the flip, add its gid to new_gids; only
+          // the clauses where lit is the only non-false literal need a look
+          OccsList::range lclauses = o_list.clauses(lit); // skips removed clauses
+          for (OccsList::iterator pcl = lclauses.begin(); pcl != lclauses.end(); ++pcl) {
+            if ((_rc.num_nonfalse(*pcl) == 1) && (_pa.false_lanes_memo(*pcl) & bit)) {
+              GID cand_gid = (*pcl)->get_grp_id();
+              if ((cand_gid != 0) || !rm.ignore_g0())
+                new_gids.insert(cand_gid);  
+              // early break: if new_gids.size() > 1 -- get out
+              if (new_gids.size() > 1)
+                break;
+            }   
           }
-          if (Utils::tv_clause(curr_ass, *pcl) == -1) {
-            GID cand_gid = (*pcl)->get_grp_id();
-            if ((cand_gid != 0) || !rm.ignore_g0())
-              new_gids.insert(cand_gid);  
-            // early break: if new_gids.size() > 1 -- get out
-            if (new_gids.size() > 1)
-              break;
-          }   
-          ++pcl; // next clause
-        }
-        // ok, now we have the falsified gid-set in new_gids; put them on the queue
-        DBG(cout << "  Falsified gids: " << new_gids << endl;);
-        // check if singleton and new - if yes, enqueue and add
-        if (new_gids.size() == 1) {
-          GID new_gid = *new_gids.begin();
-          // consult the decider
-          if (_d.rotate_through(rm, new_gid, lit)) {
-            rm.nec_gids().insert(new_gid);
-            rot_queue_entry r(new_gid, e._delta);
-            r._delta.push_back(*pv);
-            rot_queue.push(r);
-            DBG(cout << " put on the queue" << endl;);
+          // ok, now we have the falsified gid-set in new_gids; put them on the queue
+          DBG(cout << "  Falsified gids: " << new_gids << endl;);
+          // check if singleton and new - if yes, enqueue and add
+          if (new_gids.size() == 1) {
+            GID new_gid = *new_gids.begin();
+            // consult the decider
+            if (_d.rotate_through(rm, new_gid, lit)) {
+              rm.nec_gids().insert(new_gid);
+              rot_queue_entry r(new_gid, e._delta);
+              r._delta.push_back(var);
+              rot_queue.push(r);
+              DBG(cout << " put on the queue" << endl;);
+            }
+          } else if (rm.collect_ft_gids()) {
+            // remember the gids to fastrack
+            copy(new_gids.begin(), new_gids.end(), inserter(rm.ft_gids(), rm.ft_gids().end()));
           }
-        } else if (rm.collect_ft_gids()) {
-          // remember the gids to fastrack
-          copy(new_gids.begin(), new_gids.end(), inserter(rm.ft_gids(), rm.ft_gids().end()));
         }
-      } // if (new_gids.size() == 0) ...
-      // unflip
-      Utils::flip(curr_ass, *pv);
+      }
     }
     // restore working model
     for (list<ULINT>::iterator pv = e._delta.begin(); pv != e._delta.end(); ++pv)
-      Utils::flip(curr_ass, *pv);
+      _rc.flip(*pv);
     // done this group-set
     rot_queue.pop();
     _num_points++;
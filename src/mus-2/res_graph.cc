@@ -44,8 +44,8 @@ void ResGraph::construct(BasicGroupSet& gs)
     unsigned as_n = occs.active_size(-var);
     if (!as_p || !as_n)
       continue;
-    BasicClauseList& l1 = (as_p <= as_n) ? occs.clauses(var) : occs.clauses(-var);
-    BasicClauseList& l2 = (as_p > as_n) ? occs.clauses(var) : occs.clauses(-var);
+    OccsList::range l1 = (as_p <= as_n) ? occs.clauses(var) : occs.clauses(-var);
+    OccsList::range l2 = (as_p > as_n) ? occs.clauses(var) : occs.clauses(-var);
     for (BasicClause* cl : l1) {
       if (cl->removed())
         continue;
@@ -72,10 +72,8 @@ namespace RGraphUtils {
       DBG(cout << "  clause: "; cl->dump(); cout << ", neighbours: " << endl;);
       for (auto plit = cl->abegin(); plit != cl->aend(); ++plit) {
         NDBG(cout << "    lit=" << *plit << ": ");
-        const BasicClauseList& l = o_list.clauses(-*plit);
-        if (l.size() > 100) { continue; }
-        for (auto cl2 : l) {
-          if (cl2->removed()) { continue; }
+        if (o_list.active_size(-*plit) > 100) { continue; }
+        for (auto cl2 : o_list.clauses(-*plit)) {
           // skip if tautology and doing resolution graph
           NDBG(cl2->dump(););
           if (use_rgraph && Utils::taut_resolvent(cl, cl2, *plit)) { // might be expensive !
@@ -0,0 +1,137 @@
+/*----------------------------------------------------------------------------*\
+ * File:        rotation_cache.hh
+ *
+ * Description: Class definition and implementation of a bounded cache of the
+ *              points visited by model rotation.
+ *
+ * Author:      agent
+ *
+ *                                                     Copyright (c) 2026, agent
+ \*----------------------------------------------------------------------------*/
+
+#ifndef _ROTATION_CACHE_HH
+#define _ROTATION_CACHE_HH 1
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "basic_group_set.hh"
+#include "types.hh"
+
+/*----------------------------------------------------------------------------*\
+ * Class:  RotationCache
+ *
+ * Purpose: A fixed-size, lossy set of the rotation points (a falsified group
+ *          or group-set, and an assignment) visited so far, shared by the
+ *          rotation calls (and the rotators of all threads). The rotators
+ *          consult it before expanding a point, and skip the points that are
+ *          already there.
+ *
+ * Notes:
+ *      1. A point is kept as a 64-bit signature: the assignment part is the
+ *         XOR of the keys of the true variables (Zobrist-style), so it is
+ *         updated in O(1) per flip, and the signature of an assignment given
+ *         as a delta to a model costs O(|delta|).
+ *      2. The table is split into buckets of 8 slots (a cache line); when a
+ *         bucket is full, a slot picked by the signature is overwritten. So
+ *         the cache may forget points (and so re-visit them), and, with tiny
+ *         probability, report a point that was never visited (and so skip it)
+ *         -- neither affects the correctness of the groups found necessary.
+ *      3. Lock-free: the slots are atomics, accessed with relaxed ordering.
+ *
+\*----------------------------------------------------------------------------*/
+
+class RotationCache {
+
+public:
+
+  /** Creates the cache using (at most) mem_mb megabytes */
+  RotationCache(unsigned mem_mb) {
+    size_t nslots = bucket_size;
+    while (2 * nslots * sizeof(uint64_t) <= ((size_t)mem_mb << 20))
+      nslots <<= 1;
+    _slots = std::vector<std::atomic<uint64_t> >(nslots);
+    _bmask = (nslots - 1) & ~(uint64_t)(bucket_size - 1);
+  }
+
+  /** Returns true if a point is in the cache; otherwise adds it and returns
+   * false */
+  bool visit(uint64_t key) {
+    if (key == 0) { key = 1; } // 0 marks empty slots
+    _lookups.fetch_add(1, std::memory_order_relaxed);
+    size_t b = key & _bmask;
+    for (size_t i = 0; i < bucket_size; ++i) {
+      uint64_t old = 0;
+      if (_slots[b + i].compare_exchange_strong(old, key, std::memory_order_relaxed))
+        return false;
+      if (old == key) {
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    _slots[b + ((key >> 32) & (bucket_size - 1))].store(key, std::memory_order_relaxed);
+    return false;
+  }
+
+  /** Returns the number of lookups so far */
+  ULINT lookups(void) const { return _lookups.load(std::memory_order_relaxed); }
+
+  /** Returns the number of lookups that found the point */
+  ULINT hits(void) const { return _hits.load(std::memory_order_relaxed); }
+
+  /** Returns the number of slots */
+  size_t capacity(void) const { return _slots.size(); }
+
+public:   // Signatures
+
+  /** The key of a variable (for the assignment part) */
+  static uint64_t var_key(ULINT var) { return mix(var); }
+
+  /** The signature of an assignment (in terms of -1;0;1) */
+  static uint64_t ass_key(const IntVector& ass) {
+    uint64_t key = 0;
+    for (size_t var = 1; var < ass.size(); ++var)
+      if (ass[var] > 0) { key ^= var_key(var); }
+    return key;
+  }
+
+  /** The key of a group */
+  static uint64_t gid_key(GID gid) { return mix(gid ^ 0x5bd1e9955bd1e995ULL); }
+
+  /** The key of a group-set */
+  static uint64_t gids_key(const GIDSet& gids) {
+    uint64_t key = 0;
+    for (GID gid : gids) { key ^= gid_key(gid); }
+    return key;
+  }
+
+  /** The signature of a point */
+  static uint64_t point_key(uint64_t gkey, uint64_t akey) {
+    return mix(gkey ^ mix(akey));
+  }
+
+private:
+
+  static const size_t bucket_size = 8;
+
+  /* splitmix64 finalizer */
+  static uint64_t mix(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  std::vector<std::atomic<uint64_t> > _slots;   // the signatures, 0 = empty
+
+  uint64_t _bmask = 0;                          // maps signatures to buckets
+
+  std::atomic<ULINT> _lookups { 0 };            // stats
+
+  std::atomic<ULINT> _hits { 0 };
+
+};
+
+#endif // _ROTATION_CACHE_HH
+
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,163 @@
+/*----------------------------------------------------------------------------*\
+ * File:        rotation_counters.hh
+ *
+ * Description: Class definition and implementation of incremental false-clause
+ *              counters for model rotation.
+ *
+ * Author:      agent
+ *
+ *                                                     Copyright (c) 2026, agent
+ \*----------------------------------------------------------------------------*/
+
+#ifndef _ROTATION_COUNTERS_HH
+#define _ROTATION_COUNTERS_HH 1
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+#include "basic_clause.hh"
+#include "basic_group_set.hh"
+#include "cl_types.hh"
+#include "occs_list.hh"
+#include "types.hh"
+
+/*----------------------------------------------------------------------------*\
+ * Class:  RotationCounters
+ *
+ * Purpose: A working assignment with, SLS-style, the number of non-false
+ *          literals of each clause and the number of false clauses of each
+ *          group. A flip costs O(occs(var)); the truth-values of clauses and
+ *          groups are then read off in O(1).
+ *
+ * Notes:
+ *      1. The counters are set up lazily: a clause when it is first asked
+ *         about, and a group (with all of its clauses) when it is first asked
+ *         about. So, a rotation round costs the size of the groups it touches,
+ *         and not the size of the group-set. reset() starts a new round in
+ *         O(1) (plus the copy of the assignment).
+ *      2. The assignment is in terms of -1;0;1 (as in Utils); the unassigned
+ *         variables are never false, and must not be flipped.
+ *      3. The removed clauses are ignored; the group-set must not change
+ *         within a round (in multi-threaded mode the rotators hold the read
+ *         lock on MUSData anyway).
+ *
+\*----------------------------------------------------------------------------*/
+
+class RotationCounters {
+
+public:
+
+  /** Starts a new round on the group-set gs, with the assignment ass */
+  void reset(BasicGroupSet& gs, const IntVector& ass) {
+    _pgs = &gs;
+    _po_list = &gs.occs_list();
+    _ass = ass;
+    if (_cl_stamp.size() <= gs.max_id()) {
+      _cl_stamp.resize(gs.max_id() + 1, 0);
+      _nf.resize(gs.max_id() + 1, 0);
+    }
+    if (_g_stamp.size() <= gs.max_gid()) {
+      _g_stamp.resize(gs.max_gid() + 1, 0);
+      _gf.resize(gs.max_gid() + 1, 0);
+    }
+    if (++_round == 0) { // wrapped around -- clear the stamps
+      std::fill(_cl_stamp.begin(), _cl_stamp.end(), 0);
+      std::fill(_g_stamp.begin(), _g_stamp.end(), 0);
+      _round = 1;
+    }
+  }
+
+  /** Returns the working assignment */
+  const IntVector& ass(void) const { return _ass; }
+
+  /** Flips a variable in the working assignment, and updates the counters of
+   * the clauses and groups set up so far */
+  void flip(ULINT var) {
+    LINT val = _ass[var];
+    assert(val != 0); // really shouldn't be flipping unassigned vars
+    LINT tlit = (val > 0) ? (LINT)var : -(LINT)var; // true now, false after
+    _ass[var] = -val;
+    OccsList::range fclauses = _po_list->clauses(tlit);
+    for (OccsList::iterator pcl = fclauses.begin(); pcl != fclauses.end(); ++pcl) {
+      ULINT id = (*pcl)->get_id();
+      if ((_cl_stamp[id] == _round) && (--_nf[id] == 0))
+        _inc_gf((*pcl)->get_grp_id(), 1);
+    }
+    OccsList::range tclauses = _po_list->clauses(-tlit);
+    for (OccsList::iterator pcl = tclauses.begin(); pcl != tclauses.end(); ++pcl) {
+      ULINT id = (*pcl)->get_id();
+      if ((_cl_stamp[id] == _round) && (_nf[id]++ == 0))
+        _inc_gf((*pcl)->get_grp_id(), -1);
+    }
+  }
+
+  /** Returns true if the clause is false under the working assignment */
+  bool is_false(const BasicClause* cl) { return _cl_nf(cl) == 0; }
+
+  /** Returns the number of non-false literals of the clause under the working
+   * assignment; a clause with 2 or more cannot be falsified by a single flip
+   * (as the clauses are duplicate-free) */
+  ULINT num_nonfalse(const BasicClause* cl) { return _cl_nf(cl); }
+
+  /** Returns the number of false clauses of a group under the working
+   * assignment */
+  ULINT num_false(GID gid) {
+    if (_g_stamp[gid] != _round) {
+      ULINT count = 0;
+      ClauseRange gclauses = _pgs->gclauses(gid);
+      for (crange_iterator pcl = gclauses.begin(); pcl != gclauses.end(); ++pcl)
+        if (!(*pcl)->removed() && (_cl_nf(*pcl) == 0))
+          count++;
+      _gf[gid] = count;
+      _g_stamp[gid] = _round;
+    }
+    return _gf[gid];
+  }
+
+private:
+
+  /* Returns the number of non-false literals in the clause (sets it up if
+   * needed) */
+  ULINT _cl_nf(const BasicClause* cl) {
+    ULINT id = cl->get_id();
+    if (_cl_stamp[id] != _round) {
+      ULINT count = 0;
+      for (CLiterator lpos = cl->abegin(); lpos != cl->aend(); ++lpos) {
+        LINT val = _ass[std::abs(*lpos)];
+        if ((val == 0) || ((val > 0) == (*lpos > 0)))
+          count++;
+      }
+      _nf[id] = count;
+      _cl_stamp[id] = _round;
+    }
+    return _nf[id];
+  }
+
+  /* Updates the false clause count of a group, if it is set up */
+  void _inc_gf(GID gid, int delta) {
+    if ((gid < _g_stamp.size()) && (_g_stamp[gid] == _round))
+      _gf[gid] += delta;
+  }
+
+  BasicGroupSet* _pgs = nullptr;        // the group-set
+
+  OccsList* _po_list = nullptr;         // its occurrence lists
+
+  IntVector _ass;                       // the working assignment
+
+  std::vector<ULINT> _nf;               // per clause ID: non-false literals
+
+  std::vector<ULINT> _gf;               // per GID: false clauses
+
+  std::vector<unsigned> _cl_stamp;      // per clause ID: round of _nf
+
+  std::vector<unsigned> _g_stamp;       // per GID: round of _gf
+
+  unsigned _round = 0;                  // the current round
+
+};
+
+#endif // _ROTATION_COUNTERS_HH
+
+/*----------------------------------------------------------------------------*/
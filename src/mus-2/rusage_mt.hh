@@ -30,15 +30,14 @@ static inline double RUSAGE::read_cpu_time_thread(void)
 {
 #if (__APPLE__ & __MACH__)
 #warning "RUSAGE::read_cpu_time_thread(void) is 0 on MAC OS X"
-  return 0;
 #endif
-#if linux
+#if __linux__   // note: plain 'linux' is not defined in strict -std=c++11
   struct timespec ts;
   if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
     return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000;
   }
-  return 0;
 #endif
+  return 0;
 }
 
 
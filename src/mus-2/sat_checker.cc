@@ -61,8 +61,10 @@ bool SATChecker::process(CheckGroupStatus& gs)
   md.lock_for_reading();
   // synchronize
   sync_solver(md);
+  compact_solver(md);
   // remember the version
   gs.set_version(md.version());
+  gs.set_r_count(md.r_list().size());
 
   // now, it is possible that by the time the worker got around to processing
   // of this work item, the status of the group has already been determined;
@@ -99,24 +101,38 @@ bool SATChecker::process(CheckGroupStatus& gs)
     for (ULINT av = md.gset().get_first_abbr(); av < md.gset().get_first_sel(); ++av)
       _psolver->set_phase(av, (pcfg->get_pc_pol() == 1) ? 1 : 0);
   }
-  // set limits, if specified
-  if (gs.conf_limit() != -1) { _psolver->set_max_conflicts(gs.conf_limit()); }
-  if (gs.cpu_limit() != 0.0f) { _psolver->set_timeout(gs.cpu_limit()); }
+  // set limits, if changed (incl. back to no limit)
+  if (gs.conf_limit() != _conf_limit) { _psolver->set_max_conflicts(_conf_limit = gs.conf_limit()); }
+  if (gs.cpu_limit() != _cpu_limit) { _psolver->set_timeout(_cpu_limit = gs.cpu_limit()); }
+  if (gs.wc_limit() != _wc_limit) { _psolver->set_wc_timeout(_wc_limit = gs.wc_limit()); }
+  // seed the phases with the last model, if the solver has lost them since
+  if (_seed_due) {
+    for (ULINT var = 1; var < _seed.size(); ++var)
+      if (_seed[var]) { _psolver->set_phase(var, (_seed[var] > 0) ? 1 : 0); }
+    _seed_due = false;
+  }
   // run SAT solver
   _psolver->init_run();
   SATRes outcome = solve();
+  _note_call("group", gid);
+  if (pcfg->get_phase_seed_mode() && (outcome != SAT_True))
+    _seed_due = !_seed.empty();
 
   // if UNSAT the group is unneccessary
   if (outcome == SAT_False) {
-    // add groups outside of core, if asked for refinement
+    // add groups outside of core, if asked for refinement; trim the core first,
+    // if asked for this too
+    bool trim = gs.refine() && (pcfg->get_core_trim() || pcfg->get_core_trim_del());
+    if (trim)
+      trim_core(md, gid, rr_gid);
     if (gs.refine()) {
       md.lock_for_reading();
-      refine(md, gs.unnec_gids(), rr_gid);
+      refine(md, gs.unnec_gids(), rr_gid, trim ? &_tcore : nullptr);
       gs.tainted_core() = gs.unnec_gids().empty();
       md.release_lock();
     }
     gs.unnec_gids().insert(gid);
-    if (gs.save_core()) { gs.set_pcore(&_psolver->get_group_unsat_core()); }
+    if (gs.save_core()) { gs.set_pcore(trim ? &_tcore : &_psolver->get_group_unsat_core()); }
     gs.set_status(false);
     gs.set_completed();
   }
@@ -124,6 +140,9 @@ bool SATChecker::process(CheckGroupStatus& gs)
   else if (outcome == SAT_True) {
     if (gs.need_model())
       _psolver->get_model(gs.model());
+    if (pcfg->get_phase_seed_mode()) {
+      if (gs.need_model()) { _seed = gs.model(); } else { _psolver->get_model(_seed); }
+    }
     if (gs.model().size() <= md.gset().max_var())
       gs.model().resize(md.gset().max_var() + 1, 0);
     gs.set_pcore(nullptr);
@@ -174,6 +193,7 @@ bool SATChecker::process(TrimGroupSet& tg)
     // run solver
     _psolver->init_run();
     SATRes outcome = solve();
+    _note_call("trim");
     if (outcome == SAT_True) {
       DBG(cout << "  instance is SAT, terminating trimming." << endl;);
       break; // is_unsat will stay false
@@ -181,20 +201,21 @@ bool SATChecker::process(TrimGroupSet& tg)
     tg.set_unsat();
     // refine: every (non-removed) group that is not in the core is removed, and
     // saved inside trimmed_gids
-    GIDSet& gcore = _psolver->get_group_unsat_core();
+    DenseGIDSet& gcore = _psolver->get_group_unsat_core();
+    _rec.core_size = gcore.size();
     unsigned r_count = 0;
     md.lock_for_writing(); // will update MUSData right away
     for (gset_iterator pgid = gs.gbegin(); pgid != gs.gend(); ++pgid) {
       if ((*pgid != 0) &&
           (trimmed_gids.find(*pgid) == trimmed_gids.end()) && // not already trimmed
-          (gcore.find(*pgid) == gcore.end())) { // not in the core
+          !gcore.count(*pgid)) { // not in the core
         trimmed_gids.insert(*pgid);
         // update the MUSData right away - for re-initializing the solver
-        md.r_gids().insert(*pgid);
+        md.set_removed(*pgid);
         md.r_list().push_front(*pgid);
         // mark the clauses as removed (and update counts in the occlist)
-        BasicClauseVector& clv = gs.gclauses(*pgid);
-        for (cvec_iterator pcl = clv.begin(); pcl != clv.end(); ++pcl) {
+        ClauseRange clv = gs.gclauses(*pgid);
+        for (crange_iterator pcl = clv.begin(); pcl != clv.end(); ++pcl) {
           if (!(*pcl)->removed()) {
             (*pcl)->mark_removed();
             if (gs.has_occs_list())
@@ -206,6 +227,7 @@ bool SATChecker::process(TrimGroupSet& tg)
         r_count++;
       }
     }
+    _rec.refined = r_count;
     _psolver->reset_run();
     md.incr_version();
     md.release_lock();
@@ -257,11 +279,14 @@ bool SATChecker::process(CheckUnsat& cu)
   // grab read-lock, sync, release
   md.lock_for_reading();
   sync_solver(md);
+  compact_solver(md);
   md.release_lock();
 
   // run SAT solver
   _psolver->init_run();
-  if (solve() == SAT_False) { cu.set_unsat(); }
+  SATRes outcome = solve();
+  _note_call("unsat");
+  if (outcome == SAT_False) { cu.set_unsat(); }
   _psolver->reset_run();
 
   // done
@@ -289,6 +314,7 @@ bool SATChecker::process(CheckGroupStatusChunk& gsc)
   md.lock_for_reading();
   // synchronize
   sync_solver(md);
+  compact_solver(md);
   // remember the version
   gsc.set_version(md.version());
   // now, it is possible that by the time the worker got around to processing
@@ -369,6 +395,7 @@ bool SATChecker::process(CheckGroupStatusChunk& gsc)
   // run SAT solver
   _psolver->init_run();
   SATRes outcome = solve();
+  _note_call("chunk", gid);
 
   // if UNSAT the group is unneccessary
   if (outcome == SAT_False) {
@@ -376,11 +403,13 @@ bool SATChecker::process(CheckGroupStatusChunk& gsc)
     if (gsc.refine()) {
       md.lock_for_reading();
       // customized version of refinement -- only considers chunk gids
-      GIDSet& gcore = _psolver->get_group_unsat_core();
+      DenseGIDSet& gcore = _psolver->get_group_unsat_core();
       for (GIDSet::const_iterator pgid = chunk.begin(); pgid != chunk.end(); ++pgid) {
-        if (!md.r(*pgid) && !md.nec(*pgid) && (gcore.find(*pgid) == gcore.end()))
+        if (!md.r(*pgid) && !md.nec(*pgid) && !gcore.count(*pgid))
           gsc.unnec_gids().insert(*pgid);
       }
+      _rec.core_size = gcore.size();
+      _rec.refined = gsc.unnec_gids().size();
       md.release_lock();
     }
     gsc.unnec_gids().insert(gid);
@@ -488,6 +517,7 @@ bool SATChecker::process(CheckVGroupStatus& vgs)
   // run SAT solver
   _psolver->init_run();
   SATRes outcome = solve();
+  _note_call("vgroup", vgid);
 
   // if UNSAT the group is unneccessary
   if (outcome == SAT_False) {
@@ -545,6 +575,7 @@ bool SATChecker::process(CheckSubsetStatus& css)
   md.lock_for_reading();
   // synchronize
   sync_solver(md);
+  compact_solver(md);
   // remember the version
   css.set_version(md.version());
 
@@ -582,6 +613,7 @@ bool SATChecker::process(CheckSubsetStatus& css)
   // run SAT solver
   _psolver->init_run();
   SATRes outcome = solve();
+  _note_call("subset");
 
   // if UNSAT the group is unneccessary
   if (outcome == SAT_False) {
@@ -731,14 +763,17 @@ bool SATChecker::process(CheckRangeStatus& crs)
     outcome = solve(&assum);
   } else
     outcome = solve();
+  _note_call("range");
 
   // if UNSAT, collect unnecessary groups
   if (outcome == SAT_False) {
     if (crs.refine()) {
       // add groups from [begin, end) that are not in the core
-      GIDSet& gcore = _psolver->get_group_unsat_core();
+      DenseGIDSet& gcore = _psolver->get_group_unsat_core();
       copy_if(crs.begin(), crs.end(), inserter(crs.unnec_gids(), crs.unnec_gids().begin()), 
               [&](GID gid) { return !gcore.count(gid); });
+      _rec.core_size = gcore.size();
+      _rec.refined = crs.unnec_gids().size();
     }
     crs.set_status(false);
     crs.set_completed();
@@ -818,9 +853,13 @@ void SATChecker::sync_solver(const MUSData& md)
         _psolver->del_group(*pg);      // might be removed already
     for (GIDListCIterator pg = md.f_list().begin(); pg != md.f_list().end(); ++pg)
       _psolver->make_group_final(*pg);
+    if (!_lcls_in.empty()) {
+      _psolver->add_learnts(_lcls_in);
+      vector<MUSer2::GroupLearnt>().swap(_lcls_in);
+    }
   }
   // case (b): assume that some clauses are gone from gset
-  else if (gs.gsize() - md.r_gids().size() <= (ULINT)_psolver->gsize()) {
+  else if (gs.gsize() - md.num_removed() <= (ULINT)_psolver->gsize()) {
     // scan the list from the front and for each clause remove it from the
     // solver -- if a clause is not in the solver, stop
     for (GIDListCIterator pg = md.r_list().begin(); pg != md.r_list().end(); ++pg) {
@@ -858,18 +897,67 @@ void SATChecker::sync_solver(const MUSData& md)
   // unsupported case
   else {
     DBG(cout << "SATChecker::sync_solver: unsupported case gs.gsize() = "
-             << gs.gsize() << ", removed " << md.r_gids().size()
+             << gs.gsize() << ", removed " << md.num_removed()
              << ", solver gsize = " << _psolver->gsize() << endl;)
     assert(false);
   }
 }
 
+/* Compacts the clause database of the SAT solver once enough groups have
+ * been deleted from it. The rebuild keeps the SAT solver wrapper (others may
+ * hold a reference to it), and is not done while the negation of a chunk is
+ * in the solver, as it is not part of md.
+ */
+void SATChecker::compact_solver(const MUSData& md)
+{
+  if (!_psolver->compaction_due())
+    return;
+  if (!_config.get_compact_rebuild() && _psolver->compact()) {
+    DBG(cout << "SATChecker::compact_solver: compacted in place" << endl;);
+    return;
+  }
+  if (!_aux_map.empty() || (_aux_long_gid != gid_Undef))
+    return;
+  vector<MUSer2::GroupLearnt> lcls;
+  _psolver->get_learnts(lcls, md.gset().max_var());
+  _psolver->reset_all();
+  _psolver->init_all();
+  load_groupset(md);
+  _psolver->add_learnts(lcls);
+  DBG(cout << "SATChecker::compact_solver: rebuilt the solver, carried over "
+           << lcls.size() << " learnt clauses" << endl;);
+}
+
+/* Takes out the learnt clauses that still hold for the current groups; see
+ * the header for why the final groups get in the way.
+ */
+void SATChecker::export_learnts(const MUSData& md, vector<MUSer2::GroupLearnt>& lcls)
+{
+  for (GID gid : md.nec_gids())
+    if (gid && _psolver->exists_group(gid) && _psolver->is_group_final(gid))
+      return;
+  _psolver->get_learnts(lcls, md.gset().max_var());
+  DBG(cout << "SATChecker::export_learnts: took out " << lcls.size()
+           << " learnt clauses" << endl;);
+}
+
+/* Keeps the learnt clauses until the solver is loaded, unless it already is
+ */
+void SATChecker::import_learnts(const vector<MUSer2::GroupLearnt>& lcls)
+{
+  if (_psolver->gsize() > 0)
+    _psolver->add_learnts(lcls);
+  else
+    _lcls_in.insert(_lcls_in.end(), lcls.begin(), lcls.end());
+}
+
 /* Invokes the underlying SAT solver; assumes that solver->init_run() has been
  * invoked
  */
 SATRes SATChecker::solve(const IntVector* assum)
 {
   SATRes res = SAT_NoRes;
+  if (_tlm) { _start_record(); }
   _start_sat_timer();
   if (_pre_mode && _psolver->is_preprocessing()) {
       res = _psolver->preprocess(_pre_mode == 1); // _pre_mode == 1 means turn off
@@ -879,9 +967,51 @@ SATRes SATChecker::solve(const IntVector* assum)
     res = (assum == nullptr) ? _psolver->solve() : _psolver->solve(*assum);
   _stop_sat_timer(res);
   _sat_calls++;
+  if (_tlm) { _stop_record(res); }
   return res;
 }
 
+/* Turns the telemetry on, if asked for
+ */
+void SATChecker::_init_telemetry(void)
+{
+  const char* path = static_cast<ToolConfig*>(&_config)->get_tlm_file();
+  if (path != nullptr) {
+    Telemetry::Instance().open(path);
+    _tlm = true;
+  }
+}
+
+/* Starts the telemetry record of a call: writes out the record of the previous
+ * call, and remembers the counters of the solver
+ */
+void SATChecker::_start_record(void)
+{
+  _flush_record();
+  _rec = SATCallRecord();
+  _rec.worker = id();
+  _rec.call = _sat_calls + 1;
+  _rec.conflicts = _psolver->nconflicts();
+  _rec.decisions = _psolver->ndecisions();
+  _rec.propagations = _psolver->npropagations();
+  _wall_timer = chrono::steady_clock::now();
+}
+
+/* Completes the telemetry record of a call (the callers may add to it until
+ * the next call)
+ */
+void SATChecker::_stop_record(SATRes outcome)
+{
+  _rec.outcome = outcome;
+  _rec.cpu_time = _sat_timer;
+  _rec.wall_time = chrono::duration<double>(chrono::steady_clock::now() - _wall_timer).count();
+  _rec.conflicts = _psolver->nconflicts() - _rec.conflicts;
+  _rec.decisions = _psolver->ndecisions() - _rec.decisions;
+  _rec.propagations = _psolver->npropagations() - _rec.propagations;
+  _rec.db_clauses = _psolver->ndbclauses();
+  _rec_pending = true;
+}
+
 
 /* In the case the last SAT call returned UNSAT, this method will get the core
  * from the SAT solver, and will add the GIDs of unnecessary groups (i.e. those
@@ -891,21 +1021,25 @@ SATRes SATChecker::solve(const IntVector* assum)
  * used for redundancy removal trick -- if the core contains rr_gid, then the
  * refinement cannot be used safely, in this cases unnec_gids stays empty.
  */
-void SATChecker::refine(const MUSData& md, GIDSet& unnec_gids, GID rr_gid)
+void SATChecker::refine(const MUSData& md, DenseGIDSet& unnec_gids, GID rr_gid,
+                        const DenseGIDSet* pcore)
 {
   // TEMP: get rid of const - TODO: fix when BasicGroupSet is const-correct
   BasicGroupSet& gs(*const_cast<BasicGroupSet*>(&md.gset()));
 
   // put all unremoved and not known to be necessary groups that are not in the
   // group core into unnec_gids
-  GIDSet& gcore = _psolver->get_group_unsat_core();
-  if ((rr_gid == gid_Undef) || (gcore.find(rr_gid) == gcore.end())) {
+  const DenseGIDSet& gcore = (pcore != nullptr) ? *pcore : _psolver->get_group_unsat_core();
+  _rec.core_size = gcore.size();
+  if ((rr_gid == gid_Undef) || !gcore.count(rr_gid)) {
     // refinement is safe
+    size_t old_size = unnec_gids.size();
+    unnec_gids.reserve(gs.max_gid());
     for (gset_iterator pgid = gs.gbegin(); pgid != gs.gend(); ++pgid) {
-      if ((*pgid != 0) && !md.r(*pgid) && !md.nec(*pgid) 
-          && (gcore.find(*pgid) == gcore.end()))
+      if ((*pgid != 0) && !md.r(*pgid) && !md.nec(*pgid) && !gcore.count(*pgid))
         unnec_gids.insert(*pgid);
     }
+    _rec.refined = unnec_gids.size() - old_size;
     DBG(cout << "=SATChecker::refine() - core is clean, refined." << endl;);
   } else {
     DBG(cout << "=SATChecker::refine() - core is tainted, not refined." << endl;);
@@ -914,6 +1048,92 @@ void SATChecker::refine(const MUSData& md, GIDSet& unnec_gids, GID rr_gid)
 }
 
 
+/* Trims the group core of the last (UNSAT) call to gid: first, the groups
+ * outside of the core are deactivated, and the solver is called again, for up
+ * to get_core_trim() rounds or until the core stays the same; then, up to
+ * get_core_trim_del() groups of the core are deactivated one by one (rr_gid
+ * first, as a core with it is no good for refinement), and stay so if the
+ * outcome is still UNSAT. The calls are limited by get_core_trim_cl()
+ * conflicts, and those that do not come back UNSAT change nothing -- so, the
+ * result is always a core of the groups that were active. The groups
+ * deactivated here are activated back at the end.
+ */
+void SATChecker::trim_core(const MUSData& md, GID gid, GID rr_gid)
+{
+  ToolConfig* pcfg = static_cast<ToolConfig*>(&_config);
+  _tcore = _psolver->get_group_unsat_core();
+  _psolver->reset_run();
+
+  // TEMP: get rid of const - TODO: fix when BasicGroupSet is const-correct
+  BasicGroupSet& gs(*const_cast<BasicGroupSet*>(&md.gset()));
+
+  // the groups that can be deactivated
+  std::vector<GID> act;
+  md.lock_for_reading();
+  for (gset_iterator pgid = gs.gbegin(); pgid != gs.gend(); ++pgid) {
+    if ((*pgid != 0) && (*pgid != gid) && _psolver->exists_group(*pgid)
+        && !_psolver->is_group_final(*pgid) && _psolver->is_group_active(*pgid))
+      act.push_back(*pgid);
+  }
+  md.release_lock();
+  if (rr_gid != gid_Undef) { act.push_back(rr_gid); }
+
+  std::vector<GID> off;          // the groups deactivated here
+  auto drop_outside = [&](void) {
+    size_t n_off = off.size();
+    for (GID g : act)
+      if (!_tcore.count(g) && _psolver->is_group_active(g)) {
+        _psolver->deactivate_group(g);
+        off.push_back(g);
+      }
+    return off.size() > n_off;
+  };
+  auto still_unsat = [&](void) {
+    _psolver->init_run();
+    SATRes outcome = solve();
+    _note_call("ctrim", gid);
+    if (outcome == SAT_False) { _tcore = _psolver->get_group_unsat_core(); }
+    _psolver->reset_run();
+    return outcome == SAT_False;
+  };
+  LINT cl = pcfg->get_core_trim_cl();
+  if (cl != _conf_limit) { _psolver->set_max_conflicts(cl); }
+
+  // re-solve with the core only
+  for (unsigned r = 0; r < pcfg->get_core_trim(); ++r) {
+    if (!drop_outside() || !still_unsat())
+      break;
+  }
+  // deletion pass
+  if (pcfg->get_core_trim_del()) {
+    std::vector<GID> cands;
+    if ((rr_gid != gid_Undef) && _tcore.count(rr_gid)) { cands.push_back(rr_gid); }
+    for (GID g : _tcore) {
+      if (cands.size() >= pcfg->get_core_trim_del()) { break; }
+      if (g != rr_gid) { cands.push_back(g); }
+    }
+    for (GID g : cands) {
+      if (!_tcore.count(g))
+        continue;
+      _psolver->deactivate_group(g);
+      if (still_unsat()) {
+        off.push_back(g);
+        drop_outside();
+      } else
+        _psolver->activate_group(g);
+    }
+  }
+  DBG(cout << "=SATChecker::trim_core(): core of " << gid << " trimmed to "
+      << _tcore.size() << " groups" << endl;);
+
+  // back to where we started
+  for (GID g : off)
+    _psolver->activate_group(g);
+  if (cl != _conf_limit) { _psolver->set_max_conflicts(_conf_limit); }
+  _psolver->init_run();
+}
+
+
 // TODO: what's the best way to do this ? Again lots of repeated code ...
 
 /* The variable-based version of sync_solver()
@@ -976,18 +1196,18 @@ void SATChecker::vrefine(const MUSData& md, GIDSet& unnec_gids, GIDSet& ft_gids,
 
   // put all unremoved and not known to be necessary groups that are not in the
   // group core into unnec_gids
-  GIDSet& gcore = _psolver->get_group_unsat_core();
+  DenseGIDSet& gcore = _psolver->get_group_unsat_core();
   NDBG(cout << "SATChecker::vrefine(): gcore " << gcore << endl;);
   // compute variable core -- i.e. set of variable groups that appear in the
   // clauses of the core;
   GIDSet vgcore;
   bool is_clean = true;
-  for (GIDSet::iterator pgid = gcore.begin(); pgid != gcore.end(); ++pgid) {
+  for (DenseGIDSet::iterator pgid = gcore.begin(); pgid != gcore.end(); ++pgid) {
     if (*pgid == rr_gid) {
       is_clean = false;
       continue;
     }
-    BasicClauseVector& gcl = gs.gclauses(*pgid);
+    ClauseRange gcl = gs.gclauses(*pgid);
     assert(gcl.size() == 1);
     BasicClause* cl = *gcl.begin();
     assert(!cl->removed());
@@ -999,12 +1219,15 @@ void SATChecker::vrefine(const MUSData& md, GIDSet& unnec_gids, GIDSet& ft_gids,
       << ((is_clean) ? "clean" : "tainted") << endl;);
   // if the core is clean, the refinment is safe and we add variables outside the
   // core into unnec_gids; otherwise, just fast-track them
+  size_t old_size = unnec_gids.size();
   for (vgset_iterator pvgid = gs.vgbegin(); pvgid != gs.vgend(); ++pvgid) {
     if ((*pvgid != 0) && !md.r(*pvgid) && !md.nec(*pvgid)) {
       if (vgcore.find(*pvgid) == vgcore.end())
         (is_clean ? unnec_gids : ft_gids).insert(*pvgid);
     }
   }
+  _rec.core_size = vgcore.size();
+  _rec.refined = unnec_gids.size() - old_size;
   // note that the invariant of vgcore.size() + unnec_gids.size() == remaining 
   // group count does not hold anymore, because there might be necessary, but not
   // finalized groups (i.e. they will appear in the core, even though they are
@@ -1032,15 +1255,10 @@ namespace {
   template <class A>
   int do_occslist(OccsList& occs, LINT lit, A& act) 
   {
-    BasicClauseList& cp = occs.clauses(lit);
-    for (BasicClauseList::iterator pcl = cp.begin(); pcl != cp.end(); ) {
-      if ((*pcl)->removed()) { 
-        pcl = cp.erase(pcl); continue; 
-      }
-      int rval = act.process((*pcl)->get_grp_id());
+    for (BasicClause* cl : occs.clauses(lit)) {
+      int rval = act.process(cl->get_grp_id());
       if (rval)
         return rval;
-      ++pcl;
     }
     return 0;
   }
@@ -1110,23 +1328,12 @@ namespace {
     VarVector& vars = gs.vgvars(vgid);
     OccsList& occs = gs.occs_list();
     for (VarVector::const_iterator pvar = vars.begin(); pvar != vars.end(); ++pvar) {
-      BasicClauseList& cp = occs.clauses(*pvar);
-      for (BasicClauseList::iterator pcl = cp.begin(); pcl != cp.end(); ) {
-        if (!(*pcl)->removed()) {
-          (*pcl)->mark_removed();
-          if (gs.has_occs_list())
-            gs.occs_list().update_active_sizes(*pcl);
-        }
-        pcl = cp.erase(pcl);
-      }
-      BasicClauseList& cn = occs.clauses(-*pvar);
-      for (BasicClauseList::iterator pcl = cn.begin(); pcl != cn.end(); ) {
-        if (!(*pcl)->removed()) {
-          (*pcl)->mark_removed();
-          if (gs.has_occs_list())
-            gs.occs_list().update_active_sizes(*pcl);
+      for (LINT lit : { (LINT)*pvar, -(LINT)*pvar }) {
+        for (BasicClause* cl : occs.clauses(lit)) {
+          cl->mark_removed();
+          occs.update_active_sizes(cl);
         }
-        pcl = cp.erase(pcl);
+        occs.clear(lit);
       }
     }
   }
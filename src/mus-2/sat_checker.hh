@@ -15,6 +15,7 @@
 #ifndef _SAT_CHECKER_HH
 #define _SAT_CHECKER_HH
 
+#include <chrono>
 #include "basic_group_set.hh"
 #include "check_group_status.hh"
 #include "check_group_status_chunk.hh"
@@ -27,8 +28,12 @@
 #include "solver_config.hh"     // NOTE: two versions of this; take from wraps-2/
 #include "solver_factory.hh"
 #include "solver_wrapper.hh"
+#include "telemetry.hh"
 #include "trim_group_set.hh"
 #include "worker.hh"
+#ifdef MULTI_THREADED
+#include "rusage_mt.hh"
+#endif
 
 
 //#define STATS 1
@@ -61,9 +66,11 @@ public:
       _psolver(&_sfact.instance(config)) {
     // initialize the solver
     _psolver->init_all();
+    _init_telemetry();
   }
 
   virtual ~SATChecker(void) {
+    _flush_record();
     _psolver->reset_all();
     _sfact.release();
   }
@@ -116,6 +123,20 @@ public:
    */
   MUSer2::SATSolverWrapper& solver(void) { return *_psolver; }
 
+  /* Takes out the learnt clauses of the SAT solver that still hold for the
+   * current groups of md into lcls (the solver has to be set up to keep them,
+   * see SATSolverConfig::get_share_learnts()). A learnt clause might depend on
+   * the groups that are final in the solver without saying so, hence nothing
+   * is taken out once a group other than g0 has been finalized.
+   */
+  void export_learnts(const MUSData& md, std::vector<MUSer2::GroupLearnt>& lcls);
+
+  /* Gives the learnt clauses taken out of another checker (on the same
+   * variables) to this one; they go into the SAT solver once it has been
+   * loaded with the groups. The clauses of the groups missing here are dropped.
+   */
+  void import_learnts(const std::vector<MUSer2::GroupLearnt>& lcls);
+
   // statistics
 
   /* Returns the number of actual calls to SAT solver
@@ -127,6 +148,18 @@ public:
   double sat_time(void) const { return _sat_time; }
   double sat_time_sat(void) const { return _sat_time_sat; }
   double sat_time_unsat(void) const { return _sat_time - _sat_time_sat; }
+
+  // telemetry
+
+  /* Adds n to the number of groups found necessary by the rotation of the
+   * model from the last SAT call (goes into the telemetry record of the call)
+   */
+  void note_rotated(unsigned n) { _rec.rotated += n; }
+
+  /* Writes out the telemetry record of the last SAT call (otherwise, this is
+   * done at the next call, or on destruction)
+   */
+  void flush_telemetry(void) { _flush_record(); }
   
 public:
 
@@ -158,9 +191,27 @@ protected:
    * The third parameter, rr_gid, if not gid_Undef, specifies the gid of the group
    * used for redundancy removal trick -- if the core contains rr_gid, then the
    * refinement cannot be used safely, in this cases unnec_gids stays empty.
+   * The last parameter, if not nullptr, is the core to use instead of the one
+   * from the SAT solver (e.g. a trimmed one).
    */
-  void refine(const MUSData& md, GIDSet& unnec_gids, GID rr_gid = gid_Undef);
+  void refine(const MUSData& md, DenseGIDSet& unnec_gids, GID rr_gid = gid_Undef,
+              const DenseGIDSet* pcore = nullptr);
   void vrefine(const MUSData& md, GIDSet& unnec_vgids, GIDSet& ft_vgids, GID rr_gid = gid_Undef); // TEMP ?
+
+  /* Trims the group core of the last (UNSAT) call to gid with cheap, conflict
+   * limited calls, as configured (see ToolConfig::get_core_trim()); the result
+   * is in _tcore. Should be called between _psolver->init_run() and
+   * _psolver->reset_run(), the solver is left in the same state.
+   */
+  void trim_core(const MUSData& md, GID gid, GID rr_gid = gid_Undef);
+
+  /* Compacts the clause database of the SAT solver once enough groups have
+   * been deleted from it (see SATSolverWrapper::set_compaction()): in place if
+   * the solver knows how, otherwise by rebuilding it from md, in which case
+   * the learnt clauses that still hold are carried over. Should be called
+   * right after sync_solver(); no locking is done in this method.
+   */
+  void compact_solver(const MUSData& md);
   
 protected:
 
@@ -179,6 +230,21 @@ protected:
 
   GID _aux_long_gid = gid_Undef;// GID of the "long" clause (chunking support)
 
+  LINT _conf_limit = -1;       // the limits currently set in the solver; they
+  float _cpu_limit = 0;        // stay there until changed, so only the changes
+  float _wc_limit = 0;         // are passed on
+
+  DenseGIDSet _tcore;          // the trimmed core (see trim_core())
+
+  IntVector _seed;             // the model of the last SAT outcome, to seed the
+                               // phases from (if asked for)
+
+  bool _seed_due = false;      // true if the phases need to be seeded, i.e. the
+                               // solver has had other outcomes since _seed
+
+  std::vector<MUSer2::GroupLearnt> _lcls_in; // imported learnts, to be added
+                               // once the solver is loaded
+
   unsigned _sat_calls = 0;     // number of calls to SAT solver
 
   double _sat_time = 0;        // total SAT solving time (for stats)
@@ -187,15 +253,47 @@ protected:
 
   double _sat_timer = 0;        // used for timing
 
-  void _start_sat_timer(void) { _sat_timer = RUSAGE::read_cpu_time(); }
+  // in multi-threaded mode the time is per-thread
+#ifndef MULTI_THREADED
+  static double _read_cpu_time(void) { return RUSAGE::read_cpu_time(); }
+#else
+  static double _read_cpu_time(void) { return RUSAGE::read_cpu_time_thread(); }
+#endif
+
+  void _start_sat_timer(void) { _sat_timer = _read_cpu_time(); }
 
   void _stop_sat_timer(SATRes outcome) {
-    _sat_timer = RUSAGE::read_cpu_time() - _sat_timer;
+    _sat_timer = _read_cpu_time() - _sat_timer;
     _sat_time += _sat_timer;
     if (outcome == SAT_True)
       _sat_time_sat += _sat_timer;
   }
 
+  // telemetry: the record of a call is written out at the next call (or in
+  // the destructor), so that the callers can add to it in the meantime
+
+  bool _tlm = false;           // true if telemetry is on
+
+  SATCallRecord _rec;          // the record of the last call
+
+  bool _rec_pending = false;   // true if _rec has not been written out
+
+  std::chrono::steady_clock::time_point _wall_timer; // used for timing
+
+  void _init_telemetry(void);
+
+  void _start_record(void);
+
+  void _stop_record(SATRes outcome);
+
+  /* Tags the record of the last call with the work item and the group */
+  void _note_call(const char* kind, GID gid = gid_Undef) {
+    _rec.kind = kind; _rec.gid = gid; }
+
+  void _flush_record(void) {
+    if (_rec_pending) { Telemetry::Instance().write(_rec); _rec_pending = false; }
+  }
+
 };
 
 #endif /* _SAT_CHECKER_HH */
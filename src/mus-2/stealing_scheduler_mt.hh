@@ -0,0 +1,275 @@
+/*----------------------------------------------------------------------------*\
+ * File:        stealing_scheduler_mt.hh
+ *
+ * Description: Class declaration and implementation of a work-stealing group
+ *              scheduler for multi-threaded environment.
+ *
+ * Author:      agent
+ *
+ *                                                     Copyright (c) 2026, agent
+ \*----------------------------------------------------------------------------*/
+
+#ifndef _STEALING_SCHEDULER_MT_HH
+#define _STEALING_SCHEDULER_MT_HH 1
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "basic_group_set.hh"
+#include "group_scheduler.hh"
+#include "mus_data_mt.hh"
+
+/*----------------------------------------------------------------------------*\
+ * Class:  WSDeque
+ *
+ * Purpose: A lock-free work-stealing deque of GIDs (Chase-Lev, with the C11
+ *          memory orderings of Le et al, PPoPP 2013). The owner pushes and
+ *          takes at the bottom, anyone can steal from the top.
+ *
+ * Notes:
+ *      1. The buffer grows as needed (by the owner); the old buffers are kept
+ *         until the deque is gone, as thieves may still be reading them.
+ *
+\*----------------------------------------------------------------------------*/
+
+class WSDeque {
+
+public:
+
+  WSDeque(size_t capacity = 64) {
+    _bufs.emplace_back(new Buffer(std::max<size_t>(capacity, 2)));
+    _buf.store(_bufs.back().get(), std::memory_order_relaxed);
+  }
+
+  /** Owner only: adds gid at the bottom */
+  void push(GID gid) {
+    int64_t b = _bottom.load(std::memory_order_relaxed);
+    int64_t t = _top.load(std::memory_order_acquire);
+    Buffer* a = _buf.load(std::memory_order_relaxed);
+    if (b - t > (int64_t)a->size - 1)
+      a = grow(a, t, b);
+    a->put(b, gid);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(b + 1, std::memory_order_relaxed);
+  }
+
+  /** Owner only: takes the gid at the bottom; false if empty */
+  bool take(GID& gid) {
+    int64_t b = _bottom.load(std::memory_order_relaxed) - 1;
+    Buffer* a = _buf.load(std::memory_order_relaxed);
+    _bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = _top.load(std::memory_order_relaxed);
+    bool res = (t <= b);
+    if (res) {
+      gid = a->get(b);
+      if (t == b) { // the last one -- race against thieves
+        res = _top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                           std::memory_order_relaxed);
+        _bottom.store(b + 1, std::memory_order_relaxed);
+      }
+    } else
+      _bottom.store(b + 1, std::memory_order_relaxed);
+    return res;
+  }
+
+  /** Anyone: takes the gid at the top; returns 1 if done, 0 if the deque is
+   * empty, and -1 if lost a race (worth a retry) */
+  int steal(GID& gid) {
+    int64_t t = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = _bottom.load(std::memory_order_acquire);
+    if (t >= b)
+      return 0;
+    Buffer* a = _buf.load(std::memory_order_acquire);
+    gid = a->get(t);
+    if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed))
+      return -1;
+    return 1;
+  }
+
+private:
+
+  struct Buffer {
+    Buffer(size_t s) : size(s), items(new std::atomic<GID>[s]) {}
+    GID get(int64_t i) const { return items[i % size].load(std::memory_order_relaxed); }
+    void put(int64_t i, GID gid) { items[i % size].store(gid, std::memory_order_relaxed); }
+    size_t size;
+    std::unique_ptr<std::atomic<GID>[]> items;
+  };
+
+  Buffer* grow(Buffer* a, int64_t t, int64_t b) {
+    Buffer* na = new Buffer(2 * a->size);
+    for (int64_t i = t; i < b; ++i)
+      na->put(i, a->get(i));
+    _bufs.emplace_back(na);
+    _buf.store(na, std::memory_order_release);
+    return na;
+  }
+
+  std::atomic<int64_t> _top { 0 };            // next to steal
+
+  std::atomic<int64_t> _bottom { 0 };         // next free slot
+
+  std::atomic<Buffer*> _buf;                  // current buffer
+
+  std::vector<std::unique_ptr<Buffer> > _bufs; // all buffers (owner only)
+
+};
+
+
+/*----------------------------------------------------------------------------*\
+ * Class:  StealingSchedulerMT
+ *
+ * Purpose: Work-stealing scheduler for multithreaded environments: the groups
+ *          are split into blocks, one per worker (in the order of
+ *          LinearSchedulerMT), and each worker takes the groups from its own
+ *          deque; a worker whose deque is empty steals from the far end of the
+ *          deques of the others. No locks are taken on the way.
+ *
+ * Notes:
+ *      1. The groups that are fasttracked (e.g. from model rotation, which
+ *         makes them likely to be necessary) go to the near end of the deque
+ *         of the calling worker, and so are taken next; the rescheduled groups
+ *         go into the second deque of the calling worker, which is only looked
+ *         at once there is nothing else to do (or to steal).
+ *      2. fasttrack() and reschedule() are expected to be called by the
+ *         workers (i.e. the threads that call next_group()); for others, there
+ *         is a separate queue with a mutex.
+ *      3. The groups found necessary or removed are flagged, and skipped when
+ *         they come up.
+ *
+\*----------------------------------------------------------------------------*/
+
+class StealingSchedulerMT : public GroupScheduler {
+
+public:
+
+  /** In principle an instance of MUSData and total number of workers is enough */
+  StealingSchedulerMT(MUSData& md, unsigned num_workers = 1, bool reverse = false)
+    : GroupScheduler(md, num_workers), _now(num_workers), _later(num_workers) {
+    BasicGroupSet& gs = md.gset();
+    // the flags are for reasonably dense GIDs only
+    if (gs.max_gid() <= 4 * (GID)gs.gsize() + 1024)
+      _settled = std::vector<std::atomic<char> >(gs.max_gid() + 1);
+    // the order of LinearSchedulerMT, split into blocks; the deques are
+    // filled from the far end, so that the workers go in that order
+    std::vector<GID> order;
+    for (gset_iterator pg = gs.gbegin(); pg != gs.gend(); ++pg)
+      if (*pg != 0) { order.push_back(*pg); }
+    if (!reverse)
+      std::reverse(order.begin(), order.end());
+    size_t bsize = order.size() / _num_workers + 1;
+    for (unsigned id = 0; id < _num_workers; ++id) {
+      size_t beg = std::min(order.size(), id * bsize);
+      size_t end = std::min(order.size(), beg + bsize);
+      for (size_t i = end; i > beg; --i)
+        _now[id].push(order[i - 1]);
+    }
+  }
+
+  /** Returns true and sets the next group id for a given worker ID
+   * [0,num_workers) if there's more groups; otherwise false
+   */
+  virtual bool next_group(GID& next_gid, unsigned worker_id) {
+    caller().psched = this;
+    caller().id = worker_id;
+    // own deque first, then the others, then the rescheduled ones
+    while (_now[worker_id].take(next_gid))
+      if (!settled(next_gid)) { return true; }
+    while (steal_from(_now, worker_id, next_gid))
+      if (!settled(next_gid)) { return true; }
+    while (_later[worker_id].take(next_gid) || steal_from(_later, worker_id, next_gid)
+           || take_orphan(next_gid))
+      if (!settled(next_gid)) { return true; }
+    return false;
+  }
+
+  /** This allows users to re-schedule a group ID check - the invariant is that
+   * after this call next_group will give out the gid at some point. Note that
+   * the workers that found the queues empty may have finished already, but
+   * the worker that re-schedules will pick the group up itself.
+   */
+  virtual void reschedule(GID gid) {
+    if (caller().psched == this)
+      _later[caller().id].push(gid);
+    else
+      add_orphan(gid);
+  }
+
+  /** This allows to push some gids to the front (if this makes sense)
+   */
+  virtual void fasttrack(GID gid) {
+    if (caller().psched == this)
+      _now[caller().id].push(gid);
+    else
+      add_orphan(gid);
+  }
+
+  /** The groups with known status are skipped from now on */
+  virtual void update_removed(GID gid) { set_settled(gid); }
+  virtual void update_necessary(GID gid) { set_settled(gid); }
+
+private:
+
+  /* Steals from the deques in qs of the workers other than worker_id; false
+   * if all of them are empty */
+  bool steal_from(std::vector<WSDeque>& qs, unsigned worker_id, GID& gid) {
+    bool retry = true;
+    while (retry) {
+      retry = false;
+      for (unsigned i = 1; i < _num_workers; ++i) {
+        int res = qs[(worker_id + i) % _num_workers].steal(gid);
+        if (res == 1) { return true; }
+        if (res == -1) { retry = true; }
+      }
+    }
+    return false;
+  }
+
+  bool settled(GID gid) const {
+    return (gid < _settled.size()) && _settled[gid].load(std::memory_order_relaxed);
+  }
+
+  void set_settled(GID gid) {
+    if (gid < _settled.size()) { _settled[gid].store(1, std::memory_order_relaxed); }
+  }
+
+  void add_orphan(GID gid) {
+    std::lock_guard<std::mutex> lk(_mtx);
+    _orphans.push_back(gid);
+  }
+
+  bool take_orphan(GID& gid) {
+    std::lock_guard<std::mutex> lk(_mtx);
+    if (_orphans.empty())
+      return false;
+    gid = _orphans.front();
+    _orphans.pop_front();
+    return true;
+  }
+
+  std::vector<WSDeque> _now;        // per worker: groups to check
+
+  std::vector<WSDeque> _later;      // per worker: rescheduled groups
+
+  std::vector<std::atomic<char> > _settled; // per gid: 1 if the status is known
+
+  std::deque<GID> _orphans;         // groups from threads other than workers
+
+  std::mutex _mtx;                  // protects _orphans
+
+  /* The scheduler the calling thread works for, and its worker id */
+  struct Caller { StealingSchedulerMT* psched = nullptr; unsigned id = 0; };
+  static Caller& caller(void) { static thread_local Caller c; return c; }
+
+};
+
+#endif // _STEALING_SCHEDULER_MT_HH
+
+/*----------------------------------------------------------------------------*/
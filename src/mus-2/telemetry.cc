@@ -0,0 +1,87 @@
+/*----------------------------------------------------------------------------*\
+ * File:        telemetry.cc
+ *
+ * Description: Implementation of per-call SAT telemetry.
+ *
+ * Author:      agent
+ *
+ *                                                    Copyright (c) 2026, agent
+\*----------------------------------------------------------------------------*/
+
+#include <cinttypes>
+#include "globals.hh"
+#include "telemetry.hh"
+
+#ifndef MULTI_THREADED
+#define TLM_LOCK
+#else
+#define TLM_LOCK std::lock_guard<std::mutex> lock(_mtx)
+#endif
+
+namespace {
+
+  const size_t out_buf_size = 1 << 20;  // output buffer
+
+  const char* outcome_str(SATRes res) {
+    return (res == SAT_True) ? "SAT" : ((res == SAT_False) ? "UNSAT" : "UNKNOWN");
+  }
+
+}
+
+/* The instance */
+Telemetry& Telemetry::Instance(void)
+{
+  static Telemetry tlm;
+  return tlm;
+}
+
+/* Opens the output file; does nothing if the output is already open */
+void Telemetry::open(const char* path)
+{
+  TLM_LOCK;
+  if (_out != NULL)
+    return;
+  if ((_out = fopen(path, "w")) == NULL)
+    tool_abort("unable to open the telemetry file");
+  setvbuf(_out, NULL, _IOFBF, out_buf_size);
+}
+
+/* Writes out a record; the line is formatted outside of the lock */
+void Telemetry::write(const SATCallRecord& rec)
+{
+  char gid[24], core[24], line[512];
+  if (rec.gid == gid_Undef)
+    snprintf(gid, sizeof(gid), "null");
+  else
+    snprintf(gid, sizeof(gid), "%" PRIu64, (uint64_t)rec.gid);
+  if (rec.core_size < 0)
+    snprintf(core, sizeof(core), "null");
+  else
+    snprintf(core, sizeof(core), "%" PRId64, (int64_t)rec.core_size);
+  int len = snprintf(line, sizeof(line),
+                     "{\"worker\":%u,\"call\":%u,\"kind\":\"%s\",\"gid\":%s,"
+                     "\"outcome\":\"%s\",\"cpu\":%.6f,\"wall\":%.6f,"
+                     "\"conflicts\":%" PRIu64 ",\"decisions\":%" PRIu64 ","
+                     "\"propagations\":%" PRIu64 ",\"core\":%s,"
+                     "\"refined\":%u,\"rotated\":%u,\"db_clauses\":%" PRIu64 "}\n",
+                     rec.worker, rec.call, rec.kind, gid,
+                     outcome_str(rec.outcome), rec.cpu_time, rec.wall_time,
+                     (uint64_t)rec.conflicts, (uint64_t)rec.decisions,
+                     (uint64_t)rec.propagations, core,
+                     rec.refined, rec.rotated, (uint64_t)rec.db_clauses);
+  TLM_LOCK;
+  if (_out != NULL)
+    fwrite(line, 1, len, _out);
+}
+
+/* Flushes and closes the output */
+void Telemetry::close(void)
+{
+  TLM_LOCK;
+  if (_out != NULL) {
+    fclose(_out);
+    _out = NULL;
+  }
+}
+
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,91 @@
+/*----------------------------------------------------------------------------*\
+ * File:        telemetry.hh
+ *
+ * Description: Per-call SAT telemetry: a record for each call to the SAT
+ *              solver, written out as a line of JSON (JSON lines format).
+ *
+ * Author:      agent
+ *
+ * Notes:
+ *      1. MT-safe: records are formatted by the callers, and written out
+ *         under a lock, one line at a time.
+ *      2. The output is block-buffered, and is flushed on close() (or at
+ *         exit) -- cheap enough to be left on.
+ *
+ *                                                    Copyright (c) 2026, agent
+\*----------------------------------------------------------------------------*/
+
+#ifndef _TELEMETRY_HH
+#define _TELEMETRY_HH
+
+#include <cstdio>
+#ifdef MULTI_THREADED
+#include <mutex>
+#endif
+#include "basic_clause.hh"
+#include "solver_utils.hh"
+
+/*----------------------------------------------------------------------------*\
+ * Struct:  SATCallRecord
+ *
+ * Purpose: Telemetry of a single SAT solver call.
+\*----------------------------------------------------------------------------*/
+
+struct SATCallRecord {
+  const char* kind = "";        // the work item that made the call
+  unsigned worker = 0;          // ID of the worker
+  unsigned call = 0;            // number of the call in the worker
+  GID gid = gid_Undef;          // the group being checked (if any)
+  SATRes outcome = SAT_NoRes;
+  double cpu_time = 0;          // seconds
+  double wall_time = 0;         // seconds
+  ULINT conflicts = 0;          // in this call (0 if the solver does not tell)
+  ULINT decisions = 0;
+  ULINT propagations = 0;
+  ULINT db_clauses = 0;         // in the solver after the call
+  LINT core_size = -1;          // size of the group core (-1 = not taken)
+  unsigned refined = 0;         // groups found unnecessary by the core
+  unsigned rotated = 0;         // groups found necessary by model rotation
+};
+
+/*----------------------------------------------------------------------------*\
+ * Class:  Telemetry
+ *
+ * Purpose: The (single) sink of SATCallRecords.
+\*----------------------------------------------------------------------------*/
+
+class Telemetry {
+
+public:
+
+  static Telemetry& Instance(void);
+
+  /* Opens the output file; does nothing if the output is already open */
+  void open(const char* path);
+
+  /* True if the records are written out */
+  bool enabled(void) const { return _out != NULL; }
+
+  /* Writes out a record */
+  void write(const SATCallRecord& rec);
+
+  /* Flushes and closes the output */
+  void close(void);
+
+private:
+
+  Telemetry(void) {}
+
+  ~Telemetry(void) { close(); }
+
+  FILE* _out = NULL;                    // the output
+
+#ifdef MULTI_THREADED
+  std::mutex _mtx;                      // guards _out
+#endif
+
+};
+
+#endif /* _TELEMETRY_HH */
+
+/*----------------------------------------------------------------------------*/
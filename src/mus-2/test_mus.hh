@@ -15,6 +15,7 @@
 #include <sstream>
 #include "basic_group_set.hh"
 #include "mus_data.hh"
+#include "solver_wrapper.hh"
 #include "work_item.hh"
 
 /*----------------------------------------------------------------------------*\
@@ -35,7 +36,8 @@ public:     // Lifecycle
   enum Result { UNKNOWN = 0, UNSAT_MU, UNSAT_NOTMU, SAT };
 
   TestMUS(MUSData& md)       // note that the reference is not constant
-    : _md(md), _result(UNKNOWN), _cpu_time(0), _sat_calls(0), _rot_groups(0) {}
+    : _md(md), _result(UNKNOWN), _cpu_time(0), _sat_calls(0), _rot_groups(0),
+      _plcls(nullptr) {}
 
   virtual ~TestMUS(void) {};
 
@@ -43,6 +45,14 @@ public: // Parameters
 
   MUSData& md(void) const { return _md; }
 
+  /* Learnt clauses to start the SAT solver of the tester with; these must not
+   * depend on any of the necessary groups being final (see
+   * SATChecker::export_learnts()). 0 means none.
+   */
+  const std::vector<MUSer2::GroupLearnt>* learnts(void) const { return _plcls; }
+
+  void set_learnts(const std::vector<MUSer2::GroupLearnt>* plcls) { _plcls = plcls; }
+
 public: // Result
   
   Result result(void) const { return _result; }
@@ -91,6 +101,8 @@ protected:
 
   unsigned _unnec_groups;       // number of unnecessary groups (if UNSAT_NONMU)
 
+  const std::vector<MUSer2::GroupLearnt>* _plcls; // learnt clauses (or 0)
+
 };
 
 #endif /* _COMPUTE_MUS_HH */
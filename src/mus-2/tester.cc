@@ -77,6 +77,8 @@ bool Tester::process(TestMUS& tm)
   // now testing ...
   MUSData test_md(test_gs);
   SATChecker schecker(_imgr, test_config);
+  if (tm.learnts() != nullptr)
+    schecker.import_learnts(*tm.learnts());
   CheckUnsat cu(test_md);
   if (schecker.process(cu) && cu.completed()) {
     if (!cu.is_unsat()) {
@@ -88,11 +90,11 @@ bool Tester::process(TestMUS& tm)
       ComputeMUS cm(test_md);
       if (mex.process(cm) && cm.completed()) {
         // now the original instance is MUS if all groups are necessary
-        tm._result = ((test_md.nec_gids().size() == md.nec_gids().size()) 
+        tm._result = ((test_md.num_necessary() == md.num_necessary()) 
                       ? TestMUS::UNSAT_MU : TestMUS::UNSAT_NOTMU);
         tm._sat_calls = mex.sat_calls();
         tm._rot_groups = mex.rot_groups();
-        tm._unnec_groups = md.nec_gids().size() - test_md.nec_gids().size();
+        tm._unnec_groups = md.num_necessary() - test_md.num_necessary();
         tm.set_completed();
       }
     }
@@ -141,7 +143,7 @@ bool Tester::process(TestIrr& ti)
     // now the original instance is irredundant if all groups are necessary; if
     // if not we're done
     ti._sat_calls = mex.sat_calls();
-    ti._red_groups = md.nec_gids().size() - test_md.nec_gids().size();
+    ti._red_groups = md.num_necessary() - test_md.num_necessary();
     if (ti._red_groups != 0) {
       ti._result = TestIrr::RED;
       ti.set_completed();
@@ -265,11 +267,11 @@ bool Tester::process(TestVMUS& tm)
       ComputeMUS cm(test_md);
       if (mex.process(cm) && cm.completed()) {
         // now the original instance is MUS if all variable groups are necessary
-        tm._result = ((test_md.nec_gids().size() == md.nec_gids().size()) 
+        tm._result = ((test_md.num_necessary() == md.num_necessary()) 
                       ? TestVMUS::UNSAT_VMU : TestVMUS::UNSAT_NOTVMU);
         tm._sat_calls = mex.sat_calls();
         tm._rot_groups = mex.rot_groups();
-        tm._unnec_groups = md.nec_gids().size() - test_md.nec_gids().size();
+        tm._unnec_groups = md.num_necessary() - test_md.num_necessary();
         tm.set_completed();
       }
     }
@@ -290,8 +292,8 @@ namespace {
   /** Helper to add clauses to test group set */
   void add_clauses(BasicGroupSet& gs, BasicGroupSet& test_gs, GID gid) 
   {
-    BasicClauseVector& gi = gs.gclauses(gid);
-    for (BasicClauseVector::iterator pcl = gi.begin(); pcl != gi.end(); ++pcl) {
+    ClauseRange gi = gs.gclauses(gid);
+    for (crange_iterator pcl = gi.begin(); pcl != gi.end(); ++pcl) {
       BasicClause* ocl = *pcl;
       vector<LINT> lits(ocl->asize());
       copy(ocl->abegin(), ocl->aend(), lits.begin());
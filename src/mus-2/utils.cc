@@ -112,10 +112,10 @@ int Utils::num_tl_clause(const IntVector& ass, const BasicClause* cl)
  * -1 for UNSAT, 0 for undetermined. A set is SAT iff all clauses are SAT, a set
  * is UNSAT iff at least one clause is UNSAT, undetermined otherwise
  */
-int Utils::tv_group(const IntVector& ass, const BasicClauseVector& clauses)
+int Utils::tv_group(const IntVector& ass, const ClauseRange& clauses)
 {
   unsigned sat_count = 0;
-  for (cvec_citerator pcl = clauses.begin(); pcl != clauses.end(); ++pcl) {
+  for (crange_iterator pcl = clauses.begin(); pcl != clauses.end(); ++pcl) {
     int tv = tv_clause(ass, *pcl);
     if (tv == -1)
       return -1;
@@ -128,7 +128,7 @@ int Utils::tv_group(const IntVector& ass, const BasicClauseVector& clauses)
  * the given clause vector, and adds it as a group 'out_gid' to the group-set
  * 'out-gs'.
  */
-void Utils::make_neg_group(const BasicClauseVector& cls,
+void Utils::make_neg_group(const ClauseRange& cls,
                            BasicGroupSet& out_gs, GID out_gid, IDManager& imgr)
 {
   DBG(PRINT_PTR_ELEMENTS(cls, "Source clauses: "););
@@ -68,13 +68,13 @@ namespace Utils {
    * -1 for UNSAT, 0 for undetermined. A set is SAT iff all clauses are SAT, a set
    * is UNSAT iff at least one clause is UNSAT, undetermined otherwise
    */
-  int tv_group(const IntVector& ass, const BasicClauseVector& clauses);
+  int tv_group(const IntVector& ass, const ClauseRange& clauses);
 
   /* Creates a group which represents the CNF of a negation of the clauses in
    * the given clause vector, and adds it as a group 'out_gid' to the group-set
    * 'out-gs'.
    */
-  void make_neg_group(const BasicClauseVector& cls,
+  void make_neg_group(const ClauseRange& cls,
                       BasicGroupSet& out_gs, GID out_gid, IDManager& imgr);
 
   /** This is a class that knows to generate the cartesian product of the literals
@@ -352,16 +352,14 @@ void VESimplifier::reconstruct_solution(SimplifyVE& sv)
          pcl != to_remove.end(); ++pcl) {
       BasicClause* cl = *pcl;
       cl->mark_removed();
-      md.nec_gids().erase(cl->get_grp_id());
-      md.r_gids().insert(cl->get_grp_id());
+      md.set_removed(cl->get_grp_id());
       curr_lvl.erase(cl);
     }
     for (vector<BasicClause*>::iterator pcl = to_insert.begin(); 
          pcl != to_insert.end(); ++pcl) {
       BasicClause* cl = *pcl;
       cl->unmark_removed();
-      md.nec_gids().insert(cl->get_grp_id());
-      md.r_gids().erase(cl->get_grp_id());
+      md.set_necessary(cl->get_grp_id());
       curr_lvl.insert(cl);
     }
   }
@@ -417,7 +415,7 @@ namespace {
     ++r_clauses;
     GID gid = c->get_grp_id();
     if (gs.a_count(gid) == 0) {
-      md.r_gids().insert(gid);
+      md.set_removed(gid);
       md.r_list().push_front(gid);      
       r_groups++;
     }
@@ -449,22 +447,15 @@ namespace {
     for (CLiterator pl = pmin_l+1; pl != c->aend(); ++pl)
       if (occs.active_size(*pl) < occs.active_size(*pmin_l))
         pmin_l = pl;
-    BasicClauseList& clauses = occs.clauses(*pmin_l);
-    for (BasicClauseList::iterator pcl = clauses.begin(); pcl != clauses.end(); ) {
-      NDBG(cout << "  checking "; (*pcl)->dump(););
-      if ((*pcl)->removed()) { // already removed (lazily), remove from list
-        NDBG(cout << " already removed." << endl;);
-        pcl = clauses.erase(pcl);
-        continue;
-      }
-      if (sv.sub_lim() >= 0 && (*pcl)->asize() > (unsigned)sv.sub_lim()) {
+    for (BasicClause* cl : occs.clauses(*pmin_l)) { // skips removed clauses
+      NDBG(cout << "  checking "; cl->dump(););
+      if (sv.sub_lim() >= 0 && cl->asize() > (unsigned)sv.sub_lim()) {
         NDBG(cout << " aborted, clause is too long." << endl;);
-      } else if (subsumes(c, *pcl)) { // subsumed - add to the list
+      } else if (subsumes(c, cl)) { // subsumed - add to the list
         NDBG(cout << " subsumed, adding to the list.";);
-        sub.push_back(*pcl);
+        sub.push_back(cl);
       }
       NDBG(cout << endl;);
-      ++pcl;
     }       
     // done    
     NDBG(cout << "-calculate_subsumed(): done." << endl;);
@@ -544,12 +535,9 @@ namespace {
   void remove_all(SimplifyVE& sv, LINT l)
   {
     BasicGroupSet& gs = sv.md().gset();
-    BasicClauseList& cp = gs.occs_list().clauses(l);
-    for (BasicClauseList::iterator pcl = cp.begin(); pcl != cp.end(); ) {
-      if (!(*pcl)->removed())
-        remove_clause(sv, *pcl);
-      pcl = cp.erase(pcl);
-    }
+    for (BasicClause* cl : gs.occs_list().clauses(l))
+      remove_clause(sv, cl);
+    gs.occs_list().clear(l);
     assert(gs.occs_list().active_size(l) == 0);
   }
            
@@ -581,13 +569,7 @@ namespace {
         LINT lit = *uc->abegin();
         remove_all(sv, lit);
         NDBG(cout << "removed satisfied, " << endl;);
-        BasicClauseList& cls = occs.clauses(-lit);
-        for (BasicClauseList::iterator pcl = cls.begin(); pcl != cls.end(); ) {
-          if ((*pcl)->removed()) { // already removed (lazily), tidy up the list
-            pcl = cls.erase(pcl);
-            continue;
-          }
-          BasicClause* cl = *pcl;
+        for (BasicClause* cl : occs.clauses(-lit)) {
           NDBG(cout << "    propagating through " << *cl << ":" << flush;);
           vector<LINT> lits;
           for (CLiterator plit = cl->abegin(); plit != cl->aend(); ++plit)
@@ -621,9 +603,9 @@ namespace {
           }
           // drop the clause
           remove_clause(sv, cl);
-          pcl = cls.erase(pcl);
           NDBG(cout << " removed strengthened." << endl;);
         }
+        occs.clear(-lit);
         assert(gs.occs_list().active_size(lit) == 0);
         assert(gs.occs_list().active_size(-lit) == 0);
         sv.trace().push_back(abs(lit));
@@ -664,37 +646,24 @@ namespace {
     if (!(occs.active_size(v) && occs.active_size(-v))) { 
       LINT pure_lit = occs.active_size(v) ? (LINT)v : -(LINT)v;
       // remove and put all variables on the queue
-      BasicClauseList& cls = occs.clauses(pure_lit);
-      for (BasicClauseList::iterator pcl = cls.begin(); pcl != cls.end(); ) {
-        if (!(*pcl)->removed()) {
-          for (CLiterator plit = (*pcl)->abegin(); plit != (*pcl)->aend(); ++plit)
-            if (*plit != pure_lit)
-              vheap.update(abs(*plit));
-          remove_clause(sv, *pcl);
-        }
-        pcl = cls.erase(pcl);
+      for (BasicClause* cl : occs.clauses(pure_lit)) {
+        for (CLiterator plit = cl->abegin(); plit != cl->aend(); ++plit)
+          if (*plit != pure_lit)
+            vheap.update(abs(*plit));
+        remove_clause(sv, cl);
       }
+      occs.clear(pure_lit);
       ++r_vars;
       return true;
     }
     // ok, not pure, do the work ...
-    BasicClauseList& cls1 = occs.clauses(v);
-    BasicClauseList& cls2 = occs.clauses(-v);
     SimplifyVE::DerivData& dd = sv.dd();
     int gain = occs.active_size(v) + occs.active_size(-v);
     SimplifyVE::DerivData local_dd; // potential resolvents
-    for (BasicClauseList::iterator pcl1 = cls1.begin(); pcl1 != cls1.end(); ) {
-      if ((*pcl1)->removed()) { // already removed (lazily), tidy up the list
-        pcl1 = cls1.erase(pcl1);
-        continue;
-      }
-      for (BasicClauseList::iterator pcl2 = cls2.begin(); pcl2 != cls2.end(); ) {
-        if ((*pcl2)->removed()) { // already removed (lazily), tidy up the list
-          pcl2 = cls2.erase(pcl2);
-          continue;
-        }
+    for (BasicClause* cl1 : occs.clauses(v)) {
+      for (BasicClause* cl2 : occs.clauses(-v)) {
         // ok, got the clauses, try them ...
-        BasicClause *cl1 = (*pcl1), *cl2 = (*pcl2), *res = resolve(sv, cl1, cl2, v);
+        BasicClause* res = resolve(sv, cl1, cl2, v);
         NDBG(cout << "  trying " << *cl1 << " with " << *cl2 << " got ";
             if (res == NULL) 
               cout << "tautology" << endl; 
@@ -743,9 +712,7 @@ namespace {
             }
           }
         }
-        ++pcl2;
       }
-      ++pcl1;
     }
     NDBG(cout << "=eliminate_var(): got up to " << local_dd.size() 
         << " new resolvents" << endl;);
@@ -839,12 +806,8 @@ namespace {
       NDBG(cout << "  checking literal " << *pl << endl;);
       *pl = -*pl; // flip      
       cc->update_abstr(); 
-      BasicClauseList& cls = gs.occs_list().clauses(*pl);
-      for (BasicClauseList::iterator pcl = cls.begin(); pcl != cls.end(); ) {
-        if ((*pcl)->removed()) {
-          pcl = cls.erase(pcl);
-          continue;
-        }
+      OccsList::range cls = gs.occs_list().clauses(*pl);
+      for (OccsList::iterator pcl = cls.begin(); pcl != cls.end(); ++pcl) {
         if (subsumes(cc, *pcl)) {
           NDBG(cout << "  found self-resolvent " << **pcl << flush);
           // make resolvent from the candidate
@@ -876,9 +839,6 @@ namespace {
           remove_subsumed(sv, res);
           NDBG(cout << " removed subsumed." << endl;);
           assert((*pcl)->removed()); // should be removed
-          pcl = cls.erase(pcl); // remove from occlist
-        } else {
-          ++pcl;
         }
       }
       *pl = -*pl; // restore
@@ -106,7 +106,7 @@ void VMUSExtractionAlgDel::operator()(void)
                  pvgid != rm.nec_gids().end(); ++pvgid) {
               // double-check check if not necessary already and not gid 0
               if (*pvgid && !_md.nec(*pvgid)) {
-                _md.nec_gids().insert(*pvgid);
+                _md.set_necessary(*pvgid);
                 _md.f_list().push_front(*pvgid);
                 if (*pvgid != vgid)
                   r_count++;
@@ -116,12 +116,13 @@ void VMUSExtractionAlgDel::operator()(void)
               cout_pref << "wrkr-" << _id << " " << r_count
                         << " variable groups are necessary due to rotation." << endl;
             _rot_groups += r_count;
+            _schecker.note_rotated(r_count);
           }
           rm.reset();
         } else {
           // no model rotation -- just take care of the necessary group:        
           // put into MUSData
-          _md.nec_gids().insert(vgid);
+          _md.set_necessary(vgid);
           // note that for variables can cannot always finalize the clauses --
           // the clauses can only be made final if all variables are necessary;
           // thus, the semantics of f_list() are different here
@@ -135,7 +136,7 @@ void VMUSExtractionAlgDel::operator()(void)
         // mark each group as removed
         GIDSet& uvgids = wi.unnec_vgids();
         for (GIDSetIterator pvgid = uvgids.begin(); pvgid != uvgids.end(); ++pvgid) {
-          _md.r_gids().insert(*pvgid);
+          _md.set_removed(*pvgid);
           _md.r_list().push_front(*pvgid);
           // the clauses will be marked as removed (and update counts in the occlist) 
           // after they are actually removed from the solver (in SATChecker)
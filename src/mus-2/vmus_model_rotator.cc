@@ -55,7 +55,7 @@ namespace {
   // Checks whether a given assignment satisfies a set of clauses; return 1 for SAT, -1
   // for UNSAT, 0 for undetermined. A set is SAT iff all clauses are SAT, a set
   // is UNSAT iff at least one clause is UNSAT, undetermined otherwise
-  int tv_group(const IntVector& ass, const BasicClauseVector& clauses);
+  int tv_group(const IntVector& ass, const ClauseRange& clauses);
 
   // Collects all clauses with variable var that are falsified by the given 
   // assignment
@@ -98,10 +98,17 @@ bool VMUSModelRotator::process(RotateModel& rm)
   rot_queue.push(rot_queue_entry(rm.gid()));
   // a copy of the original model -- will be used as working assignment.
   IntVector curr_ass(orig_model);
+  start_points(orig_model);
   while (!rot_queue.empty()) {
     rot_queue_entry& e = rot_queue.front();
     GID vgid = e._vgid;
     DBG(cout << "Rotating vgid=" << vgid;);
+    // skip the points visited already (in this or an earlier call)
+    if (seen_point(RotationCache::gid_key(vgid), e._delta)) {
+      DBG(cout << ", visited already." << endl;);
+      rot_queue.pop();
+      continue;
+    }
 
     // update working assignment and its hash (don't forget to restore)
     DBG(cout << ", delta: ";);
@@ -235,10 +242,10 @@ namespace {
   // Checks whether a given assignment satisfies a set of clauses; return 1 for SAT, -1
   // for UNSAT, 0 for undetermined. A set is SAT iff all clauses are SAT, a set
   // is UNSAT iff at least one clause is UNSAT, undetermined otherwise
-  int tv_group(const IntVector& ass, const BasicClauseVector& clauses)
+  int tv_group(const IntVector& ass, const ClauseRange& clauses)
   {
     unsigned sat_count = 0;
-    for (cvec_citerator pcl = clauses.begin(); pcl != clauses.end(); ++pcl) {
+    for (crange_iterator pcl = clauses.begin(); pcl != clauses.end(); ++pcl) {
       int tv = tv_clause(ass, *pcl);
       if (tv == -1)
         return -1;
@@ -261,24 +268,12 @@ namespace {
                      HashedClauseSet& f_clauses) 
   {
     OccsList& o_list = gs.occs_list();
-    BasicClauseList& cp = o_list.clauses(var);
-    for (BasicClauseList::iterator pcl = cp.begin(); pcl != cp.end(); ) {
-      if ((*pcl)->removed()) { 
-        pcl = cp.erase(pcl); continue; 
-      }
-      if (tv_clause(ass, *pcl) == -1)
-        f_clauses.insert(*pcl);
-      ++pcl;
-    }
-    BasicClauseList& cn = o_list.clauses(-var);
-    for (BasicClauseList::iterator pcl = cn.begin(); pcl != cn.end(); ) {
-      if ((*pcl)->removed()) { 
-        pcl = cp.erase(pcl); continue; 
-      }
-      if (tv_clause(ass, *pcl) == -1)
-        f_clauses.insert(*pcl);
-      ++pcl;
-    }
+    for (BasicClause* cl : o_list.clauses(var))
+      if (tv_clause(ass, cl) == -1)
+        f_clauses.insert(cl);
+    for (BasicClause* cl : o_list.clauses(-var))
+      if (tv_clause(ass, cl) == -1)
+        f_clauses.insert(cl);
   }
 
 } // anonymous namespace
@@ -37,9 +37,9 @@ using namespace std;
 \*----------------------------------------------------------------------------*/
 //jpms:ec
 
-template<class B>
+template<class B, class L>
 static
-void read_gcnf_clause(B& in, ULINT& clgrp, ULINT& mxid, vector<LINT>& lits) {
+void read_gcnf_clause(B& in, ULINT& clgrp, ULINT& mxid, L& lits) {
   read_left_bracket(in);   // Parse left bracket
   clgrp = FMTUtils::parseInt(in);    // Read clause group
   read_right_bracket(in);  // Parse right bracket
@@ -49,11 +49,37 @@ void read_gcnf_clause(B& in, ULINT& clgrp, ULINT& mxid, vector<LINT>& lits) {
   for (;;){
     parsed_lit = FMTUtils::parseInt(in);
     if (parsed_lit == 0) break;
-    if (fabs(parsed_lit) > mxid) { mxid = fabs(parsed_lit); }
+    if ((ULINT)abs(parsed_lit) > mxid) { mxid = abs(parsed_lit); }
     lits.push_back(parsed_lit);
   }
 }
 
+/** Reads the 'p' line of a GCNF file; the current character is expected to
+ * be 'p'.
+ */
+template<class B, class CSet>
+static void read_gcnf_preamble(B& in, CSet& cldb) {
+  ++in;
+  // Either read 2 or 3 integers, depending on new line
+  FMTUtils::skipTabSpace(in);
+  string fmt = FMTUtils::readString(in);
+  if (fmt != "gcnf") {
+	cerr << "PARSE ERROR! Unexpected int: " << fmt << endl; exit(3); }
+  FMTUtils::skipTabSpace(in);
+  LINT intcnt = 1;
+  while (*in != '\n' && *in != '\r') {
+	XLINT ival = FMTUtils::parseLongInt(in);
+	if (intcnt == 1) { cldb.set_num_vars(ToLint(ival)); }
+	else if (intcnt == 2) { cldb.set_num_cls(ToLint(ival)); }
+	else if (intcnt == 3) { cldb.set_num_grp(ival); }
+	else {
+	  LINT lval = ToLint(ival);
+	  fprintf(stderr, "PARSE ERROR! Unexpected int: %ld\n",
+		  (long int)lval); exit(3);
+	} ++intcnt; FMTUtils::skipTabSpace(in); }
+  ++in;
+}
+
 /** Template parameters: B - input stream, CSet - the clause set to populate
  */
 template<class B, class CSet>
@@ -61,34 +87,16 @@ static void parse_gcnf_file(B& in, IDManager& imgr, CSet& cldb) {
   ULINT mnid = 1;
   ULINT mxid = 1;
   ULINT clid = 0;   // index of the clause in the input
-  vector<LINT> lits;
+  typename CSet::LitBuffer lits(cldb);
   for (;;){
 	FMTUtils::skipWhitespace(in);
     if (*in == EOF)
       break;
     else if (*in == 'c')
        FMTUtils::skipLine(in);
-    else if (*in == 'p') {
-      ++in;
-      // Either read 2 or 3 integers, depending on new line
-      FMTUtils::skipTabSpace(in);
-      string fmt = FMTUtils::readString(in);
-      if (fmt != "gcnf") {
-	cerr << "PARSE ERROR! Unexpected int: " << fmt << endl; exit(3); }
-      FMTUtils::skipTabSpace(in);
-      LINT intcnt = 1;
-      while (*in != '\n' && *in != '\r') {
-	XLINT ival = FMTUtils::parseLongInt(in);
-	if (intcnt == 1) { cldb.set_num_vars(ToLint(ival)); }
-	else if (intcnt == 2) { cldb.set_num_cls(ToLint(ival)); }
-	else if (intcnt == 3) { cldb.set_num_grp(ival); }
-	else {
-	  LINT lval = ToLint(ival);
-	  fprintf(stderr, "PARSE ERROR! Unexpected int: %ld\n",
-		  (long int)lval); exit(3);
-	} ++intcnt; FMTUtils::skipTabSpace(in); }
-      ++in;
-    } else {
+    else if (*in == 'p')
+      read_gcnf_preamble(in, cldb);
+    else {
       ULINT clgrp;
       read_gcnf_clause(in, clgrp, mxid, lits);
       ++clid;
@@ -133,6 +141,8 @@ public:
 			     IDManager& imgr, CSet& cldb) {
     StreamBuffer in(input_stream);
     parse_gcnf_file(in, imgr, cldb); }
+  inline void load_gcnf_file(MappedBuffer& in, IDManager& imgr, CSet& cldb) {
+    parse_gcnf_file(in, imgr, cldb); }
 };
 // definition of GroupCNFParser, for backward compatibility
 typedef GroupCNFParserTmpl<BasicClauseSet> GroupCNFParser;
@@ -0,0 +1,251 @@
+/*----------------------------------------------------------------------------*\
+ * File:        par_gcnffmt.hh
+ *
+ * Description: Parallel parser for uncompressed CNF and GCNF files. The body
+ *              of the input is split into chunks at line boundaries, the
+ *              chunks are tokenized on separate threads, and the tokens are
+ *              turned into clauses on the calling thread in the input order,
+ *              so that clause and group IDs are exactly as assigned by the
+ *              sequential parsers (cnffmt.hh, gcnffmt.hh).
+ *
+ * Author:      agent
+ *
+ * Notes:
+ *      1. Requires multi-threaded build (std::thread).
+ *      2. The chunks are merged as soon as they are tokenized, i.e. merging
+ *         of the first chunks overlaps with tokenizing of the later ones.
+ *      3. Since a chunk may start in the middle of a clause, the comment
+ *         and preamble lines are recognized at any token boundary; hence, on
+ *         malformed inputs (e.g. a comment inside a clause) the errors may
+ *         be reported differently than by the sequential parsers.
+ *
+ *                                                    Copyright (c) 2026, agent
+\*----------------------------------------------------------------------------*/
+
+#ifndef _PAR_GCNFFMT_H
+#define _PAR_GCNFFMT_H 1
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "globals.hh"
+#include "id_manager.hh"
+#include "fmtutils.hh"
+#include "basic_clause.hh"
+#include "cl_id_manager.hh"
+#include "gcnffmt.hh"
+
+using namespace std;
+
+/** Tokens of a chunk of input: literals and 0s, in the input order; in GCNF
+ * mode group IDs are marked by par_grp_mark, followed by the ID itself.
+ */
+struct ParseChunk {
+  const char* first = NULL;     // the chunk is [first, last)
+  const char* last = NULL;
+  vector<LINT> toks;            // the tokens
+  ULINT mxid = 1;               // max variable in the chunk
+  string err;                   // first error (if any) -- tokenizing stops
+};
+
+static const LINT par_grp_mark = MINLINT;
+
+/* Scans a (signed) integer; on error sets ch.err and returns false */
+static inline bool par_scan_int(MappedBuffer& in, LINT& val, ParseChunk& ch)
+{
+  FMTUtils::skipWhitespace(in);
+  const char*& p = in.pos();
+  const char* e = in.limit();
+  bool neg = false;
+  if ((p < e) && (*p == '-' || *p == '+'))
+    neg = (*p++ == '-');
+  if ((p == e) || (*p < '0' || *p > '9')) {
+    ch.err = "PARSE ERROR! Unexpected char: ";
+    ch.err += (p < e) ? *p : ' ';
+    return false;
+  }
+  val = (LINT)FMTUtils::scanDigits(in);
+  if (neg) val = -val;
+  return true;
+}
+
+/* Tokenizes a chunk; runs on a worker thread, so does not exit on errors */
+static void par_tokenize_chunk(ParseChunk& ch, bool gcnf)
+{
+  MappedBuffer in(ch.first, ch.last);
+  const char*& p = in.pos();
+  const char* e = in.limit();
+  ch.toks.reserve((e - p) / 4);
+  for (;;) {
+    FMTUtils::skipWhitespace(in);
+    if (p == e)
+      break;
+    if (*p == 'c' || *p == 'p') {
+      FMTUtils::skipLine(in);
+    } else if (gcnf && (*p == '{')) {
+      ++p;
+      LINT gid;
+      if (!par_scan_int(in, gid, ch))
+        return;
+      if ((p == e) || (*p != '}')) {
+        ch.err = "PARSE ERROR! Expecting } instead of ";
+        ch.err += (p < e) ? *p : ' ';
+        return;
+      }
+      ++p;
+      ch.toks.push_back(par_grp_mark);
+      ch.toks.push_back(gid);
+    } else {
+      LINT lit;
+      if (!par_scan_int(in, lit, ch))
+        return;
+      if ((ULINT)abs(lit) > ch.mxid) { ch.mxid = abs(lit); }
+      ch.toks.push_back(lit);
+    }
+  }
+}
+
+/** Template parameters: CSet -- the clause set to populate
+ */
+template<class CSet>
+class ParCNFParserTmpl {
+public:
+  /* nthreads = 0 means the number of h/w threads */
+  ParCNFParserTmpl(unsigned nthreads) : _nthreads(nthreads) {
+    if (_nthreads == 0)
+      _nthreads = max(1u, thread::hardware_concurrency());
+  }
+
+  inline void load_cnf_file(MappedBuffer& in, IDManager& imgr, CSet& cldb) {
+    parse_file(in, false, imgr, cldb); }
+
+  inline void load_gcnf_file(MappedBuffer& in, IDManager& imgr, CSet& cldb) {
+    parse_file(in, true, imgr, cldb); }
+
+protected:
+
+  void parse_file(MappedBuffer& in, bool gcnf, IDManager& imgr, CSet& cldb);
+
+  void merge_chunk(ParseChunk& ch, bool gcnf, CSet& cldb,
+                   typename CSet::LitBuffer& lits);
+
+  static void parse_error(const string& msg) {
+    cerr << msg << endl; exit(3); }
+
+  static const size_t min_chunk = 1 << 20;  // bytes per thread, at least
+
+  unsigned _nthreads;
+
+  ULINT _clid = 0;              // index of the clause in the input
+
+  ULINT _clgrp = 0;             // group of the current clause
+
+  bool _open = false;           // true if in the middle of a clause
+
+};
+
+/* The main method: reads the preamble, splits and tokenizes the body, and
+ * merges the chunks
+ */
+template<class CSet>
+void ParCNFParserTmpl<CSet>::parse_file(MappedBuffer& in, bool gcnf,
+                                        IDManager& imgr, CSet& cldb)
+{
+  // the comments and the preamble -- sequentially
+  for (;;) {
+    FMTUtils::skipWhitespace(in);
+    if (*in == 'c')
+      FMTUtils::skipLine(in);
+    else if (*in == 'p') {
+      if (gcnf)
+        read_gcnf_preamble(in, cldb);
+      else
+        FMTUtils::skipLine(in);
+    } else
+      break;
+  }
+  // split the rest at line boundaries
+  const char* first = in.pos();
+  const char* last = in.limit();
+  size_t len = last - first;
+  size_t nchunks = min((size_t)_nthreads, len / min_chunk + 1);
+  vector<ParseChunk> chunks(nchunks);
+  for (size_t k = 0; k < nchunks; ++k) {
+    ParseChunk& ch = chunks[k];
+    ch.first = (k == 0) ? first : chunks[k-1].last;
+    ch.last = last;
+    if (k + 1 < nchunks) {
+      const char* cut = max(ch.first, first + (k + 1) * (len / nchunks));
+      const char* nl = (const char*)memchr(cut, '\n', last - cut);
+      ch.last = (nl == NULL) ? last : nl + 1;
+    }
+  }
+  // tokenize
+  vector<thread> workers;
+  for (ParseChunk& ch : chunks)
+    workers.emplace_back(par_tokenize_chunk, ref(ch), gcnf);
+  // merge in order
+  ULINT mnid = 1;
+  ULINT mxid = 1;
+  typename CSet::LitBuffer lits(cldb);
+  for (size_t k = 0; k < nchunks; ++k) {
+    workers[k].join();
+    if (!chunks[k].err.empty()) {
+      for (size_t j = k + 1; j < nchunks; ++j) { workers[j].join(); }
+      parse_error(chunks[k].err);
+    }
+    merge_chunk(chunks[k], gcnf, cldb, lits);
+    mxid = max(mxid, chunks[k].mxid);
+    vector<LINT>().swap(chunks[k].toks); // release memory
+  }
+  if (_open)
+    parse_error("PARSE ERROR! Unexpected end of file inside a clause");
+  imgr.new_ids(mxid, mnid, mxid);  // Register used IDs
+}
+
+/* Makes clauses out of the tokens of the chunk; the state of the current
+ * clause (_open, _clgrp and the literals in lits) carries over to the next
+ * chunk.
+ */
+template<class CSet>
+void ParCNFParserTmpl<CSet>::merge_chunk(ParseChunk& ch, bool gcnf, CSet& cldb,
+                                         typename CSet::LitBuffer& lits)
+{
+  const vector<LINT>& toks = ch.toks;
+  for (size_t i = 0; i < toks.size(); ++i) {
+    LINT tok = toks[i];
+    if (tok == par_grp_mark) {
+      if (_open)
+        parse_error("PARSE ERROR! Unexpected char: {");
+      _clgrp = (ULINT)toks[++i];
+      _open = true;
+      continue;
+    }
+    if (!_open) {
+      if (gcnf) {
+        cerr << "PARSE ERROR! Expecting { instead of " << tok << endl;
+        exit(3);
+      }
+      _open = true;
+    }
+    if (tok != 0) {
+      lits.push_back(tok);
+      continue;
+    }
+    // the clause is complete -- see cnffmt.hh for the explanation of IDs
+    _open = false;
+    ++_clid;
+    while (ClauseIdManager::Instance()->id() < _clid)
+      ClauseIdManager::Instance()->new_id();
+    BasicClause* ncl = cldb.create_clause(lits);
+    if (ncl != NULL)
+      cldb.set_cl_grp_id(ncl, gcnf ? _clgrp : ncl->get_id());
+  }
+}
+
+#endif /* _PAR_GCNFFMT_H */
+
+/*----------------------------------------------------------------------------*/
@@ -60,6 +60,7 @@ static void parse_vgcnf_file(B& in, IDManager& imgr, CSet& cldb) {
   ULINT mxid = 1;
   ULINT clid = 0;       // clause's index in the input file
   ULINTSet vars, reg_vars; 
+  typename CSet::LitBuffer lits(cldb);
   for (;;){
     FMTUtils::skipWhitespace(in);
     if (*in == EOF)
@@ -99,8 +100,10 @@ static void parse_vgcnf_file(B& in, IDManager& imgr, CSet& cldb) {
         reg_vars.insert(*pvar);
       }
     } else {
-      vector<LINT> lits;
       read_cnf_clause(in, mxid, lits);
+      // remember the variables
+      for (LINT lit : lits)
+        vars.insert((ULINT)abs(lit));
       ++clid;
       // ANTON: for some applications its *essential* that clause id is the same
       // as the index of the clause in the input; if the input file contains 
@@ -111,9 +114,6 @@ static void parse_vgcnf_file(B& in, IDManager& imgr, CSet& cldb) {
       BasicClause* ncl = cldb.create_clause(lits); // fheras: Automatic clause ID
       if (ncl != NULL)
         cldb.set_cl_grp_id(ncl, ncl->get_id());
-      // remember the variables
-      for (vector<LINT>::iterator plit = lits.begin(); plit != lits.end(); ++plit)
-        vars.insert((ULINT)abs(*plit));
     }
   }
   imgr.new_ids(mxid, mnid, mxid);  // Register used IDs
@@ -141,6 +141,8 @@ public:
       IDManager& imgr, CSet& cldb) {
     StreamBuffer in(input_stream);
     parse_vgcnf_file(in, imgr, cldb); }
+  inline void load_vgcnf_file(MappedBuffer& in, IDManager& imgr, CSet& cldb) {
+    parse_vgcnf_file(in, imgr, cldb); }
 };
 
 #endif /* _VGCNFFMT_H */
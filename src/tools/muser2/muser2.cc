@@ -30,6 +30,7 @@
 #include "mus_data.hh"
 #ifdef MULTI_THREADED
 #include "mus_data_mt.hh"
+#include "par_gcnffmt.hh"
 #endif
 #include "mus_extractor.hh"
 #include "simplify_bce.hh"
@@ -70,6 +71,7 @@ namespace {
   ToolConfig config;    // configuration data
   IDManager imgr;       // ID manager
   MUSData* pmd = 0;     // MUSData
+  std::vector<MUSer2::GroupLearnt> lcls; // learnts of the first check (-shl)
 }
 
 /*
@@ -95,6 +97,11 @@ int main(int argc, char** argv)
   if (config.get_verbosity() >= 0) {
     print_header(config, filename);
   }
+#ifdef MULTI_THREADED
+  if (config.get_pipe_mode() && (config.get_pipe_mode_conflict() != nullptr))
+    cout_pref << "WARNING: -pipe is ignored: "
+              << config.get_pipe_mode_conflict() << "." << endl;
+#endif
 
   BasicGroupSet gset(config);
   if (config.get_verbosity() > 0)
@@ -113,10 +120,16 @@ int main(int argc, char** argv)
     cout << ", " << gset.vgsize() << " variable groups, " 
          << gset.vsize() << " variables";
   cout << "." << endl;
+  if (config.get_bin_output_file() != NULL) {
+    ofstream outf(config.get_bin_output_file(), ios::binary);
+    if (!outf || !gset.write_binary(outf))
+      tool_abort("unable to write binary group-set");
+    prt_cfg_cputime("Binary group-set written at ");
+  }
 #ifndef MULTI_THREADED
   MUSData md(gset, config.get_var_mode());
 #else
-  MUSDataMT md(gset);
+  MUSDataMT md(gset, config.get_var_mode());
 #endif
   pmd = &md; // set up the global pointer to be used by utilities
 
@@ -267,12 +280,18 @@ int main(int argc, char** argv)
   } else {
     report("No trimming and no initial (UN)SAT check ...");
   }
+  if (config.get_share_learnts()) {
+    schecker.export_learnts(md, lcls);
+    if (config.get_verbosity() > 0)
+      cout_pref << "Learnt clauses to share: " << lcls.size() << endl;
+  }
   
   // do the MUS or irredundant formula extraction (if asked for)
   if (config.get_mus_mode() || config.get_irr_mode()) {
     // off we go ...
     MUSExtractor mex(imgr, config);
     mex.set_sat_checker(&schecker);     // re-use the checker
+    if (!lcls.empty()) { mex.set_learnts(&lcls); }
     ComputeMUS cm(md);
     if (!mex.process(cm) || !cm.completed())
       tool_abort("extraction failed, see previous error messages.");
@@ -283,18 +302,21 @@ int main(int argc, char** argv)
     cout_pref << "Wall-clock time of extraction only: " 
               << mex.wc_time() << " sec" << endl;
 #endif
-#ifndef MULTI_THREADED // TODO: remove when stats are ok for MT
     cout_pref << "Calls to SAT solver during extraction: "      
               << mex.sat_calls() << endl;
     if (config.get_model_rotate_mode()) {
       cout_pref << "Groups detected by model rotation: "
-                << mex.rot_groups() << " out of " << md.nec_gids().size() << endl;
+                << mex.rot_groups() << " out of " << md.num_necessary() << endl;
     }
     if (config.get_refine_clset_mode()) {
       cout_pref << "Groups removed with refinement: "
-                << mex.ref_groups() << " out of " << md.r_gids().size() << endl;
+                << mex.ref_groups() << " out of " << md.num_removed() << endl;
+    }
+    if (config.get_approx_mode() == 3) {
+      cout_pref << "Hard groups checked without limits: "
+                << mex.tail_groups() << ", SAT time: " << mex.tail_time()
+                << " sec" << endl;
     }
-#endif
   }
 
 #ifdef XPMODE
@@ -357,7 +379,10 @@ int main(int argc, char** argv)
 "  -comp     use competitions output format [default: off]\n" \
 "  -w        write the result instance in default file [default: off]\n" \
 "  -wf FFF   write the result instance in file FFF.[g]cnf [default: no writing]\n" \
+"  -wbin FFF write the input group-set in binary format to FFF; binary files\n" \
+"            are recognized automatically on input [default: no writing]\n" \
 "  -st       print intermediate stats\n" \
+"  -tlm FFF  write a JSON record per SAT solver call into FFF [default: off]\n" \
 "  -test     test the result for correctness [default: off]\n" \
 " Main functionality:\n" \
 "  -var      compute variable-MUSes [SAT 2012] [default: off]\n" \
@@ -369,12 +394,21 @@ int main(int argc, char** argv)
 "  -dich     compute MUS using dichotomic algorithm [TEMP: no groups, vars, MES]\n"     \
 " Optimizations and heuristics:\n" \
 "  -norf     do not refine target clause sets with unsat subsets [default: off]\n" \
+"  -ctrim N  trim the cores used for refinement with up to N rounds of re-solving\n" \
+"            with the groups of the core only [default: 0]\n" \
+"  -ctrim:del N then, try to drop up to N groups of the core one by one [default: 0]\n" \
+"  -ctrim:cl N the conflict limit per call during core trimming, -1 = no limit\n" \
+"            [default: 200]\n" \
+"  -phs      seed the phases of the SAT solver with the model of the last SAT\n" \
+"            outcome, once UNSAT outcomes have come in between [default: off]\n" \
 "  -norot    do not detect necessary clauses using model rotation [default: off]\n" \
 "  -rr       use redundancy removal [default: off; TEMP: do not use with GCNF]\n" \
 "  -rra      use adaptive redundancy removal [default: off; TEMP: do not use with GCNF]\n" \
 "  -emr      use extended model rotation (EMR clauses [AIComm-11], variables [SAT 2012]) [default: off]\n" \
 "  -imr      use specialized model rotation for MES computation [CP 2012] [default: off]\n" \
 "  -bglob    block rotation through globally necessary clauses during rotation [default: off]\n" \
+"  -rcache N remember the points visited by model rotation across SAT calls, in a\n" \
+"            cache of N MB; 0 = off [default: 0]\n" \
 "  -order N  schedule clauses/groups/variables according to some order:\n" \
 "              0 = default (group-id: GMUS: max->min; VGMUS: min->max)\n" \
 "              1 = longest clause/occlist first (sum for groups)\n" \
@@ -401,6 +435,30 @@ int main(int argc, char** argv)
 "  -minisat-gh use the version of Minisat 2.2.0 from github (incr. only) [default: off]\n" \
 "  -minisat-ghs same as above, but with SatElite (incr. only) [default: off]\n" \
 "  -picosat  use the picosat-954 SAT solver [default: off] \n" \
+"  -ipasir L use the IPASIR solver in the shared library L (incr. only, needs a build\n" \
+"            with dl=1) [default: off] \n" \
+"  -cdb R    compact the clause DB of the SAT solver each time fraction R of the\n" \
+"            groups is deleted, 0 = never (incr. only) [default: off]\n" \
+"  -cdbr     compact by rebuilding the SAT solver from the remaining groups, even\n" \
+"            if the solver can remove the satisfied clauses itself [default: off]\n" \
+"  -shl      start the SAT solvers of the tester and of the other threads with the\n" \
+"            clauses learnt during trimming or the initial check [default: off]\n" \
+"\n"
+
+#define TOOL_HELP_MT_SWITCHES \
+" Multi-threading (deletion-based (G)MUS extraction only):\n" \
+"  -nthr N   use N threads, 0 = number of h/w threads [default: 0]\n" \
+"  -pthr N   parse uncompressed CNF/GCNF inputs with N threads, 0 = number of\n" \
+"            h/w threads [default: 1]\n" \
+"  -wsched   use per-thread queues with work stealing to schedule the groups\n" \
+"            [default: off]\n" \
+"  -rthr N   run each recursive model rotation on N threads (per extraction\n" \
+"            thread) [default: 1]\n" \
+"  -pipe     overlap the model rotation with the next SAT check (per extraction\n" \
+"            thread); only with -norf, and without -reorder and approximation\n" \
+"            [default: off]\n" \
+"  -portfolio L race the solvers in the comma-separated list L on each SAT call,\n" \
+"            e.g. glucose,minisat-gh,lingeling (incr. only) [default: off]\n" \
 "\n"
 
 #define TOOL_HELP_EXP_SWITCHES \
@@ -447,11 +505,10 @@ int main(int argc, char** argv)
 "  -bce:ig0  ignore g0 clauses during BCE (unsound, in general) [default: off]\n" \
 "  -ve       simplify instance using VE [default: off; TEMP: do not use with -bcp]\n" \
 " SAT solver control:\n" \
-"  -minisat-hmuc use the proof-tracing version of minisat from Haifa-MUC (nonincr. only) [Ryvchin, Strichman, SAT-2012] [default: off]\n" \
+"  -minisat-hmuc use the proof-tracing version of minisat from Haifa-MUC (incr. mode removes clauses natively) [Ryvchin, Strichman, SAT-2012] [default: off]\n" \
 "  -minisat-abbr use the abbreviating version of minisat (incr. only) [Lagniez, Biere, SAT-2013] [default: off]\n" \
 "  -lingeling use the lingeling-ala solver (incr. only) [default: off] \n" \
 "  -picosat935 use the picosat-935 SAT solver [default: off] \n" \
-"  -ipasir use the attached IPASIR solver library (if compiled in) [default: off] \n" \
 "  -ubcsat12 use UBCSAT 1.2 solver; if set, make sure to set approximation mode [default: off] \n" \
 " Proof-compactor:\n" \
 "  -pc       assume that the input formula is an output of Marijn's proof compactor [default: off]\n" \
@@ -465,10 +522,13 @@ int main(int argc, char** argv)
 "                in MUS\n" \
 "            2 - underapproximation: groups with unknown SAT outcomes are excluded\n" \
 "                from MUS\n" \
-"            3 - rescheduling [TEMP: not implemented yet]: groups with unknown SAT outcomes are rescheduled,\n" \
-"                and the limits for these groups are multiplied by -approx:fact\n" \
+"            3 - rescheduling: groups with unknown SAT outcomes are rescheduled,\n" \
+"                and the limits for these groups are multiplied by -approx:fact;\n" \
+"                once only such groups are left, they are checked without limits\n" \
+"                (so the result is exact)\n" \
 "  -approx:cl N the conflict limit per SAT call, -1 = no limit [default: 1000]\n" \
 "  -approx:tl F.F the CPU limit per SAT call, 0 = no limit [default: 0]\n" \
+"  -approx:wtl F.F the wall-clock limit per SAT call, 0 = no limit [default: 0]\n" \
 "  -approx:fact F.F the factor to multiply the limits by [default: 2.0]\n" \
 ""
 
@@ -477,6 +537,9 @@ namespace {
   void prt_help() {
     cout << TOOL_HELP_HEADER;
     cout << TOOL_HELP_STD_SWITCHES;
+#ifdef MULTI_THREADED
+    cout << TOOL_HELP_MT_SWITCHES;
+#endif
 #ifdef XPMODE
     cout << TOOL_HELP_EXP_SWITCHES;
 #endif
@@ -517,9 +580,20 @@ namespace {
       } else if (!strcmp(argv[i], "-wf")) {
         ++i;
         cfg.set_output_file(argv[i]);
+      } else if (!strcmp(argv[i], "-wbin")) {
+        ++i;
+        cfg.set_bin_output_file(argv[i]);
+      } else if (!strcmp(argv[i], "-tlm")) {
+        ++i;
+        cfg.set_tlm_file(argv[i]);
       }
 #ifdef MULTI_THREADED
       else if (!strcmp(argv[i], "-nthr")) {++i; cfg.set_num_threads(atoi(argv[i]));}
+      else if (!strcmp(argv[i], "-pthr")) {++i; cfg.set_parse_threads(atoi(argv[i]));}
+      else if (!strcmp(argv[i], "-wsched")) { cfg.set_ws_sched_mode(); }
+      else if (!strcmp(argv[i], "-rthr")) {++i; cfg.set_rot_threads(atoi(argv[i]));}
+      else if (!strcmp(argv[i], "-pipe")) { cfg.set_pipe_mode(); }
+      else if (!strcmp(argv[i], "-portfolio")) { cfg.set_portfolio(argv[++i]); }
 #endif
       else if (!strcmp(argv[i], "-ph")) {++i; cfg.set_phase(atoi(argv[i]));}
       else if (!strcmp(argv[i], "-nonincr")) {cfg.unset_incr_mode();}
@@ -531,6 +605,13 @@ namespace {
       else if (!strcmp(argv[i], "-minisat-ghs")) {cfg.set_sat_solver("minisat-ghs");}
       else if (!strcmp(argv[i], "-glucose")) {cfg.set_sat_solver("glucose");}
       else if (!strcmp(argv[i], "-glucoses")) {cfg.set_sat_solver("glucoses");}
+      else if (!strcmp(argv[i], "-ipasir")) {
+        cfg.set_sat_solver("ipasir");
+        cfg.set_ipasir_lib(argv[++i]);
+      }
+      else if (!strcmp(argv[i], "-cdb")) { cfg.set_compact_ratio(atof(argv[++i])); }
+      else if (!strcmp(argv[i], "-cdbr")) { cfg.set_compact_rebuild(); }
+      else if (!strcmp(argv[i], "-shl")) { cfg.set_share_learnts(); }
       //
       else if (!strcmp(argv[i], "-trim")) {++i; cfg.set_trim_iter(atoi(argv[i]));}
       else if (!strcmp(argv[i], "-tprct")) {++i; cfg.set_trim_percent(atoi(argv[i]));}
@@ -538,6 +619,10 @@ namespace {
       //
       else if (!strcmp(argv[i], "-nomus")) {cfg.unset_mus_mode();}
       else if (!strcmp(argv[i], "-norf")) {cfg.unset_refine_clset_mode();}
+      else if (!strcmp(argv[i], "-ctrim")) {cfg.set_core_trim(atoi(argv[++i]));}
+      else if (!strcmp(argv[i], "-ctrim:del")) {cfg.set_core_trim_del(atoi(argv[++i]));}
+      else if (!strcmp(argv[i], "-ctrim:cl")) {cfg.set_core_trim_cl(atoi(argv[++i]));}
+      else if (!strcmp(argv[i], "-phs")) {cfg.set_phase_seed_mode();}
       else if (!strcmp(argv[i], "-norot")) {cfg.unset_model_rotate_mode();}
       else if (!strcmp(argv[i], "-ichk")) {cfg.set_init_unsat_chk();}
       else if (!strcmp(argv[i], "-test")) {cfg.set_test_mode();}
@@ -549,6 +634,7 @@ namespace {
       else if (!strcmp(argv[i], "-irr")) {cfg.set_irr_mode();}
       else if (!strcmp(argv[i], "-imr")) {cfg.set_imr_mode();}
       else if (!strcmp(argv[i], "-bglob")) { cfg.set_iglob_mode(false); }
+      else if (!strcmp(argv[i], "-rcache")) { ++i; cfg.set_rcache_size(atoi(argv[i])); }
       else if (!strcmp(argv[i], "-chunk")) { cfg.set_chunk_mode(); ++i; cfg.set_chunk_size(atoi(argv[i]));}
       else if (!strcmp(argv[i], "-ins")) {cfg.set_ins_mode();}  
       else if (!strcmp(argv[i], "-dich")) {cfg.set_dich_mode();}  
@@ -561,9 +647,6 @@ namespace {
       else if (!strcmp(argv[i], "-minisat-abbr")) {cfg.set_sat_solver("minisat-abbr");}
       else if (!strcmp(argv[i], "-lingeling")) {cfg.set_sat_solver("lingeling");}
       else if (!strcmp(argv[i], "-picosat935")) {cfg.set_sat_solver("picosat935");}
-#ifdef IPASIR_LIB
-      else if (!strcmp(argv[i], "-ipasir")) {cfg.set_sat_solver("ipasir");}
-#endif
       else if (!strcmp(argv[i], "-ubcsat12")) {cfg.set_sat_solver("ubcsat12"); cfg.set_sls_mode(); cfg.unset_incr_mode(); }
       else if (!strcmp(argv[i], "-rwidth")) {++i; cfg.set_rotation_width(atoi(argv[i]));}
       else if (!strcmp(argv[i], "-intelmr")) { cfg.set_intelmr_mode(); }
@@ -587,7 +670,8 @@ namespace {
       else if (!strcmp(argv[i], "-approx")) { cfg.set_approx_mode(atoi(argv[++i])); }
       else if (!strcmp(argv[i], "-approx:cl")) { cfg.set_approx_conf_lim(atoi(argv[++i])); }
       else if (!strcmp(argv[i], "-approx:tl")) { cfg.set_approx_cpu_lim(atof(argv[++i])); }
-      else if (!strcmp(argv[i], "-approx:fact")) { cfg.set_approx_fact(atoi(argv[++i])); }
+      else if (!strcmp(argv[i], "-approx:wtl")) { cfg.set_approx_wc_lim(atof(argv[++i])); }
+      else if (!strcmp(argv[i], "-approx:fact")) { cfg.set_approx_fact(atof(argv[++i])); }
       else if (!strcmp(argv[i], "-param1")) { cfg.set_param1(atoi(argv[++i]));}
       else if (!strcmp(argv[i], "-param2")) { cfg.set_param2(atoi(argv[++i]));}
       else if (!strcmp(argv[i], "-param3")) { cfg.set_param3(atoi(argv[++i]));}
@@ -604,21 +688,12 @@ namespace {
     return NULL;
   }
 
-  //jpms:bc
-  /*----------------------------------------------------------------------------*\
-   * Purpose: Load CNF or GCNF file.
-   \*----------------------------------------------------------------------------*/
-  //jpms:ec
-
-  void load_file(const char* fname, ToolConfig& config, IDManager& imgr,
-                 BasicGroupSet& gset) {
-    gzFile in = gzopen(fname, "rb");
-    if (in == Z_NULL) {
-      string msg("Unable to open file: ");
-      msg += fname;
-      tool_abort(msg.c_str());
-    }
-    assert(in != Z_NULL);
+  /* Parses the input in the format given by the configuration; In is either
+   * gzFile or MappedBuffer
+   */
+  template<class In>
+  void load_input(In& in, ToolConfig& config, IDManager& imgr,
+                  BasicGroupSet& gset) {
     if (!config.get_grp_mode()) {
       if (config.get_pc_mode()) {
         PCCNFParserTmpl<BasicGroupSet> parser;
@@ -636,7 +711,50 @@ namespace {
         parser.load_vgcnf_file(in, imgr, gset);
       }
     }
-    gzclose(in);
+  }
+
+  //jpms:bc
+  /*----------------------------------------------------------------------------*\
+   * Purpose: Load CNF or GCNF file.
+   \*----------------------------------------------------------------------------*/
+  //jpms:ec
+
+  void load_file(const char* fname, ToolConfig& config, IDManager& imgr,
+                 BasicGroupSet& gset) {
+    // uncompressed regular files are mapped into memory; the rest (gzipped
+    // files, pipes) go through zlib
+    MappedBuffer min(fname);
+    if (min.ok() && BasicGroupSet::is_binary(min.pos(), min.limit() - min.pos())) {
+      if (config.get_pc_mode() || (config.get_var_mode() && config.get_grp_mode()))
+        tool_abort("binary group-sets cannot be used with -pc or -var -grp");
+      if (!gset.load_binary(fname))
+        tool_abort("invalid binary group-set file");
+      ULINT mnid = 1, mxid = max(gset.max_var(), (ULINT)1);
+      imgr.new_ids(mxid, mnid, mxid);  // as the parsers do
+    } else
+#ifdef MULTI_THREADED
+    if (min.ok() && (config.get_parse_threads() != 1)
+        && !config.get_pc_mode() && !config.get_var_mode()) {
+      ParCNFParserTmpl<BasicGroupSet> parser(config.get_parse_threads());
+      if (config.get_grp_mode())
+        parser.load_gcnf_file(min, imgr, gset);
+      else
+        parser.load_cnf_file(min, imgr, gset);
+    } else
+#endif
+    if (min.ok()) {
+      load_input(min, config, imgr, gset);
+    } else {
+      gzFile in = gzopen(fname, "rb");
+      if (in == Z_NULL) {
+        string msg("Unable to open file: ");
+        msg += fname;
+        tool_abort(msg.c_str());
+      }
+      assert(in != Z_NULL);
+      load_input(in, config, imgr, gset);
+      gzclose(in);
+    }
     gset.set_init_size(gset.size());
     gset.set_init_gsize(gset.gsize());
   }
@@ -723,9 +841,9 @@ namespace {
     if (!config.get_var_mode()) { // clause mode
       if (config.get_mus_mode() || config.get_irr_mode()) {
         unsigned init_size = gset.init_gsize() - (config.get_grp_mode() && gset.has_g0()); // g0 is counted
-        unsigned curr_size = init_size - md.r_gids().size();
+        unsigned curr_size = init_size - md.num_removed();
         if (config.get_pc_mode()) { --init_size; --curr_size; }
-        assert(interrupted || (curr_size == md.nec_gids().size()));
+        assert(interrupted || (curr_size == md.num_necessary()));
         cout_pref << (config.get_mus_mode() ? "MUS" : "Irredundant subformula") 
                   << ((interrupted || md.pot_nec_gids().size()) ? "(over-approximation)" : "") << " size: "
                   << curr_size << " out of " << init_size
@@ -739,8 +857,8 @@ namespace {
     } else { // variable mode
       if (config.get_mus_mode()) {
         unsigned init_size = gset.vgsize();
-        unsigned curr_size = init_size - md.r_gids().size();
-        assert(interrupted || (curr_size == md.nec_gids().size()));
+        unsigned curr_size = init_size - md.num_removed();
+        assert(interrupted || (curr_size == md.num_necessary()));
         // compute induced formula size
         unsigned if_size = 0;
         for (cvec_iterator pcl = gset.begin(); pcl != gset.end(); ++pcl)
@@ -769,6 +887,7 @@ namespace {
     if (!config.get_var_mode()) {
       if (config.get_mus_mode()) {
         TestMUS tm(md);
+        if (!lcls.empty()) { tm.set_learnts(&lcls); }
         Tester mt(imgr, config);
         report("Testing the computed MUS ...");
         if (!mt.process(tm) || !tm.completed())
@@ -15,7 +15,9 @@
 
 #include "solver_factory.hh"
 #include "solver_wrapper_gincr.hh"
+#include "solver_wrapper_gnative.hh"
 #include "solver_wrapper_gnonincr.hh"
+#include "solver_wrapper_portfolio.hh"
 #include "solver_wrapper_gsls.hh"
 
 /*----------------------------------------------------------------------------*\
@@ -28,8 +30,19 @@ MUSer2::SATSolverWrapper& MUSer2::SATSolverFactory::instance(SATSolverConfig& co
 {
   if (_solver != nullptr) { return *_solver; }
 
-  if (config.get_incr_mode()) { // in incremental mode
-    _solver = new SATSolverWrapperGrpIncr(_imgr, _ll_fact.instance_ref(config));
+  if (config.get_incr_mode() && (config.get_portfolio() != nullptr)) {
+#ifdef MULTI_THREADED
+    _solver = new SATSolverWrapperPortfolio(_imgr, config);
+#else
+    tool_abort("the portfolio of SAT solvers needs a multi-threaded build");
+#endif
+  } else if (config.get_incr_mode()) { // in incremental mode
+    SATSolverLowLevelWrapper& llwrap = _ll_fact.instance_ref(config);
+    // solvers that remove clauses by themselves do without selectors
+    if (llwrap.is_deleting())
+      _solver = new SATSolverWrapperGrpNative(_imgr, llwrap);
+    else
+      _solver = new SATSolverWrapperGrpIncr(_imgr, llwrap);
   } else {
     if (config.get_sls_mode()) {
       _solver = new SATSolverWrapperGrpSLS(_imgr, _sls_fact.instance_ref(config));
@@ -40,5 +53,7 @@ MUSer2::SATSolverWrapper& MUSer2::SATSolverFactory::instance(SATSolverConfig& co
   if (_solver == nullptr)
     tool_abort("invalid SAT solver configuration in group solver factory");
   _solver->set_verbosity(config.get_verbosity());
+  _solver->set_compaction(config.get_compact_ratio(), config.get_compact_rebuild());
+  _solver->set_keep_learnts(config.get_share_learnts());
   return *_solver;
 }
@@ -34,6 +34,15 @@ namespace MUSer2 {
 
 class SATSolverFactory;
 
+/* A learnt clause in a solver-independent form: the literals over problem
+ * variables, and the groups whose activation literals are in the clause (i.e.
+ * the clause holds whenever one of these groups is inactive).
+ */
+struct GroupLearnt {
+  IntVector lits;
+  GIDVector gids;
+};
+
 //jpms:bc
 /*----------------------------------------------------------------------------*\
  * Class: SATSolverWrapper
@@ -72,6 +81,12 @@ public: // The main interface methods -- this is the minimal set of methods that
 
 public: // Additional non-mandatory functionality
 
+  /** Asks the solve() that is running in another thread to stop; it then
+   * returns SAT_NoRes, unless the solver does not know how to stop, in which
+   * case the call is finished (see SATSolverLowLevelWrapper::interrupt())
+   */
+  virtual void interrupt(void) { }
+
   /** Returns true if this solver knows to do preprocessing; if this is overriden,
    * then preprocess() should be implemented.
    */
@@ -132,6 +147,12 @@ public: // Configuration methods
     throw std::logic_error("method is not implemented");
   }
 
+  /* Sets the wall-clock timeout per call in seconds. 0 = no timeout
+   */
+  virtual void set_wc_timeout(float to) {
+    throw std::logic_error("method is not implemented");
+  }
+
   /** Some incremental solvers implement optimizations that require the knowledge
    * of which variables are selectors. This method allows to set the largest
    * variable ID of problem variables (i.e. everything above that is a selector)
@@ -152,7 +173,7 @@ public:   // Access result of SAT solver call
   }
 
   /* Returns the reference to the group unsat core */
-  virtual GIDSet& get_group_unsat_core(void) {
+  virtual DenseGIDSet& get_group_unsat_core(void) {
     throw std::logic_error("method is not implemented");
   }
 
@@ -277,8 +298,50 @@ public: // Manipulate local copy of clause set on a group basis; most of the wra
     throw std::logic_error("method is not implemented");
   }
 
+public: // Maintenance of the clause database (optional)
+
+  /* Sets up compaction of the clause database: it is due once the fraction
+   * ratio of the groups has been deleted since the last compaction (0 = never);
+   * rebuild = true means that the solver will be rebuilt rather than compacted
+   * in place, and so should keep the clauses it learns for get_learnts()
+   */
+  virtual void set_compaction(float ratio, bool rebuild) { }
+
+  /* True when the clause database is due for compaction */
+  virtual bool compaction_due(void) { return false; }
+
+  /* Compacts the clause database in place, if the solver knows how (e.g. by
+   * removing the clauses of the deleted groups as satisfied); returns false
+   * if it does not, in which case the solver has to be rebuilt
+   */
+  virtual bool compact(void) { return false; }
+
+  /* Makes the solver keep the clauses it learns for get_learnts(), so that
+   * they can be given to other instances (e.g. to start them warm)
+   */
+  virtual void set_keep_learnts(bool keep) { }
+
+  /* Moves the learnt clauses kept by the solver that still hold for the current
+   * groups into lcls; clauses with variables above max_var that are not
+   * activation literals are dropped
+   */
+  virtual void get_learnts(std::vector<GroupLearnt>& lcls, ULINT max_var) { }
+
+  /* Adds learnt clauses taken out of another instance by get_learnts() */
+  virtual void add_learnts(const std::vector<GroupLearnt>& lcls) { }
+
 public:  // Miscellaneous (stats, printing, etc)
 
+  /* The number of conflicts, decisions and propagations in the underlying
+   * solver so far (cumulative over all calls); 0 if not known */
+  virtual ULINT nconflicts(void) { return 0; }
+  virtual ULINT ndecisions(void) { return 0; }
+  virtual ULINT npropagations(void) { return 0; }
+
+  /* The number of clauses in the underlying solver's database (including the
+   * learnt ones, if the solver tells); 0 if not known */
+  virtual ULINT ndbclauses(void) { return 0; }
+
   /* Prints CNF into the specified output stream */
   virtual void print_cnf(FILE* o_stream) {
     throw std::logic_error("method is not implemented");
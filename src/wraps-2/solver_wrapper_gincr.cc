@@ -20,18 +20,22 @@ using namespace std;
 
 //#define DBG(x) x
 
+constexpr LINT SATSolverWrapperGrpIncr::a_none;
+constexpr GID SATSolverWrapperGrpIncr::gid_Del;
+
 /* Initialize all internal data structures */
 void SATSolverWrapperGrpIncr::init_all(void)
 {
-  gcore.clear(); g2a_map.clear(); a2g_map.clear();
-  maxgid = 0; isvalid = false;
+  gcore.clear(); g2a.clear(); g2p.clear(); a2g.clear(); assumps.clear();
+  ngroups = ndeleted = 0; maxgid = 0; has_g0 = isvalid = false;
 }
 
 /* Clean up all internal data structures */
 void SATSolverWrapperGrpIncr::reset_all(void)
 {
   llwrap.reset_solver();
-  gcore.clear(); g2a_map.clear(); a2g_map.clear(); isvalid = false;
+  gcore.clear(); g2a.clear(); g2p.clear(); a2g.clear(); assumps.clear();
+  ngroups = ndeleted = 0; has_g0 = isvalid = false;
 }
 
 /* Initialize data structures for SAT run */
@@ -62,13 +66,11 @@ void SATSolverWrapperGrpIncr::add_clause(BasicClause* cl)
   GID gid = cl->get_grp_id();
   if (gid) {
     // make new indicator, if needed
-    auto p = g2a_map.find(gid);
-    if (p != end(g2a_map)) {
-      aid = labs(p->second);
+    if (exists_group(gid)) {
+      aid = labs(g2a[gid]);
     } else {
       aid = (cl->get_slit()) ? cl->get_slit() : imgr.new_id();
-      g2a_map.insert({ gid, -aid });
-      a2g_map.insert({ aid, gid });
+      register_group(gid, aid);
     }
   }
   DBG(cout << "Adding clause "; cl->dump(); cout << "slit=" << cl->get_slit() << ", alit: " << aid << endl;);
@@ -112,9 +114,8 @@ void SATSolverWrapperGrpIncr::add_group(BasicGroupSet& gset, GID gid, bool final
         solver_add_clause(cl, aid);
         added = true;
       }
-    if (aid && added) {
-      g2a_map.insert({ gid, -aid });
-      a2g_map.insert({ aid, gid });
+    if (aid && added && !exists_group(gid)) {
+      register_group(gid, aid);
       DBG(cout << "Added group gid " << gid << ", alit=" << aid << endl;);
     }
     update_maxgid(gid);
@@ -125,68 +126,127 @@ void SATSolverWrapperGrpIncr::add_group(BasicGroupSet& gset, GID gid, bool final
 /* Activates (non-final) group */
 void SATSolverWrapperGrpIncr::activate_group(GID gid)
 {
-  auto p = g2a_map.find(gid);
-  assert(p != end(g2a_map)); // exists
-  assert(p->second > 0); // not final, not active
-  p->second = -p->second;
-  DBG(cout << "Act. gid " << gid << " (alit " << labs(p->second) << ")" << endl;);
+  LINT& alit = group_alit(gid);
+  assert(alit > 0); // not final, not active
+  alit = -alit;
+  assumps[g2p[gid]] = alit;
+  DBG(cout << "Act. gid " << gid << " (alit " << labs(alit) << ")" << endl;);
 }
 
 /* Deactivates (non-final) group */
 void SATSolverWrapperGrpIncr::deactivate_group(GID gid)
 {
-  auto p = g2a_map.find(gid);
-  assert(p != end(g2a_map)); // exists
-  assert(p->second < 0); // not final, active
-  p->second = -p->second;
-  DBG(cout << "Deact. gid " << gid << " (alit " << labs(p->second) << ")" << endl;);
+  LINT& alit = group_alit(gid);
+  assert(alit < 0); // not final, active
+  alit = -alit;
+  assumps[g2p[gid]] = alit;
+  DBG(cout << "Deact. gid " << gid << " (alit " << labs(alit) << ")" << endl;);
 }
 
 /* Returns true if either final, or non-final and active */
 bool SATSolverWrapperGrpIncr::is_group_active(GID gid)
 {
-  auto p = g2a_map.find(gid);
-  assert(p != end(g2a_map)); // exists
-  return (p->second <= 0);
+  return (group_alit(gid) <= 0);
 }
 
 /* Removes (non-final) group */
 void SATSolverWrapperGrpIncr::del_group(GID gid)
 {
-  auto p = g2a_map.find(gid);
-  assert(p != g2a_map.end()); // exists
-  if (p->second)
-    solver_assert_unit_clause(labs(p->second));  // assert assumption literal
-  DBG(cout << "Del. gid " << gid << " (alit " << labs(p->second) << ")" << endl;);
-  a2g_map.erase(labs(p->second));
-  g2a_map.erase(p);
+  LINT& alit = group_alit(gid);
+  if (alit) {
+    solver_assert_unit_clause(labs(alit));  // assert assumption literal
+    drop_assumption(gid);
+    a2g[labs(alit)] = gid_Del;
+  }
+  DBG(cout << "Del. gid " << gid << " (alit " << labs(alit) << ")" << endl;);
+  alit = a_none;
+  --ngroups;
+  ++ndeleted;
 }
 
 /* Finalizes a group */
 void SATSolverWrapperGrpIncr::make_group_final(GID gid)
 {
-  auto p = g2a_map.find(gid);
-  assert(p != g2a_map.end()); // exists
-  solver_assert_unit_clause(-labs(p->second));  // Cancel assumption literal
-  DBG(cout << "Fin. gid " << gid << " (alit " << labs(p->second) << ")" << endl;);
-  p->second = 0;
+  LINT& alit = group_alit(gid);
+  solver_assert_unit_clause(-labs(alit));  // Cancel assumption literal
+  DBG(cout << "Fin. gid " << gid << " (alit " << labs(alit) << ")" << endl;);
+  if (alit)
+    drop_assumption(gid);
+  alit = 0;
 }
 
 /* True if group is final */
 bool SATSolverWrapperGrpIncr::is_group_final(GID gid)
 {
-  auto p = g2a_map.find(gid);
-  assert(p != g2a_map.end()); // exists
-  return p->second == 0;
+  return group_alit(gid) == 0;
 }
 
 /* Returns the activation literal for group -- setting to true makes the
  * group inactive; 0 means the group has been finalized. */
 LINT SATSolverWrapperGrpIncr::get_group_activation_lit(GID gid)
 {
-  auto p = g2a_map.find(gid);
-  assert(p != g2a_map.end()); // exists
-  return labs(p->second);
+  return labs(group_alit(gid));
+}
+
+/* Removes satisfied clauses, if the solver knows how */
+bool SATSolverWrapperGrpIncr::compact(void)
+{
+  if (!llwrap.is_simplifying())
+    return false;
+  llwrap.simplify();
+  ndeleted = 0;
+  return true;
+}
+
+/* Moves the learnt clauses that still hold into lcls: the activation literals
+ * of the deleted groups are true, and those of the final groups are false; a
+ * literal of another variable above max_var (e.g. an auxiliary literal of
+ * the chunk) might not mean anything outside of this solver, so the clauses
+ * with those are dropped.
+ */
+void SATSolverWrapperGrpIncr::get_learnts(vector<MUSer2::GroupLearnt>& lcls,
+                                          ULINT max_var)
+{
+  vector<IntVector> raw;
+  llwrap.get_learnts(raw);
+  MUSer2::GroupLearnt gl;
+  for (IntVector& cl : raw) {
+    gl.lits.clear(); gl.gids.clear();
+    bool keep = true;
+    for (LINT lit : cl) {
+      ULINT var = labs(lit);
+      GID gid = (var < a2g.size()) ? a2g[var] : gid_Undef;
+      if (gid == gid_Undef) {
+        keep = (var <= max_var);
+        gl.lits.push_back(lit);
+      } else if (gid == gid_Del) {
+        keep = (lit < 0);       // true literal -- drop clause
+      } else if (exists_group(gid) && (labs(g2a[gid]) == (LINT)var)) {
+        keep = (lit > 0);       // the live activation literal
+        gl.gids.push_back(gid);
+      } else {
+        keep = (lit > 0);       // the group is final -- false literal
+      }
+      if (!keep) { break; }
+    }
+    if (keep) { lcls.push_back(gl); }
+  }
+  DBG(cout << "Took out " << lcls.size() << " of " << raw.size()
+           << " learnt clauses" << endl;);
+}
+
+/* Adds learnt clauses taken out of another instance */
+void SATSolverWrapperGrpIncr::add_learnts(const vector<MUSer2::GroupLearnt>& lcls)
+{
+  for (const MUSer2::GroupLearnt& gl : lcls) {
+    _clits = gl.lits;
+    bool sat = false;
+    for (GID gid : gl.gids) {
+      if (!exists_group(gid)) { sat = true; break; }  // deleted since
+      if (g2a[gid]) { _clits.push_back(labs(g2a[gid])); }
+    }
+    if (!sat) { llwrap.add_final_clause(_clits); }
+  }
 }
 
 /// most important stuff is in the helpers ...
@@ -197,17 +257,47 @@ SATRes SATSolverWrapperGrpIncr::solve(const IntVector* assump)
   if (!isvalid)
     throw std::logic_error("Solver interface is in invalid state.");
   llwrap.clear_assumptions();
-  for (auto p = begin(g2a_map); p != end(g2a_map); ++p)
-    if (p->second) { llwrap.set_assumption(abs(p->second), p->second > 0); }
+  llwrap.set_assumptions(assumps);
   if (assump != nullptr) { llwrap.set_assumptions(*const_cast<IntVector*>(assump)); }
   SATRes res = llwrap.solve();
   if (res == SAT_False) {
     IntVector& core = llwrap.get_unsat_core();
-    for (auto a : core) { assert(a2g_map.count(a)); gcore.insert(a2g_map[a]); }
+    gcore.reserve(maxgid);
+    for (auto a : core) {
+      assert(((ULINT)a < a2g.size()) && (a2g[a] != gid_Undef));
+      gcore.insert(a2g[a]);
+    }
   }
   return res;
 }
 
+/* Registers a new (active) group with the assumption variable aid */
+void SATSolverWrapperGrpIncr::register_group(GID gid, ULINT aid)
+{
+  if (gid >= g2a.size()) {
+    g2a.resize(gid + 1, a_none);
+    g2p.resize(gid + 1);
+  }
+  if (aid >= a2g.size())
+    a2g.resize(aid + 1, gid_Undef);
+  g2a[gid] = -(LINT)aid;
+  g2p[gid] = assumps.size();
+  assumps.push_back(-(LINT)aid);
+  a2g[aid] = gid;
+  ++ngroups;
+}
+
+/* Takes the assumption of the group out of the assumption array; the last
+ * assumption takes its place */
+void SATSolverWrapperGrpIncr::drop_assumption(GID gid)
+{
+  ULINT pos = g2p[gid];
+  LINT last = assumps.back();
+  assumps[pos] = last;
+  g2p[a2g[labs(last)]] = pos;
+  assumps.pop_back();
+}
+
 /* Add a clause to solver, with associated assumption (0 means no assumption)
  */
 void SATSolverWrapperGrpIncr::solver_add_clause(BasicClause* cl, ULINT alit)
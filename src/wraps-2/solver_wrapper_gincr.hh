@@ -8,6 +8,14 @@
  * Author:      antonb
  *
  * Notes:
+ *      1. The assumptions of the non-final groups are kept in a persistent
+ *         array that is updated by the group operations, so that solve() does
+ *         not have to visit every group; the maps between groups and the
+ *         assumption variables are dense vectors indexed by GID and by
+ *         variable, respectively.
+ *      2. Deleted groups leave their clauses in the solver (satisfied by the
+ *         activation literal); see set_compaction() for how to get rid of
+ *         them.
  *
  *                                              Copyright (c) 2013, Anton Belov
 \*----------------------------------------------------------------------------*/
@@ -15,7 +23,8 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <limits>
+#include <vector>
 #include "solver_wrapper.hh"
 #include "solver_ll_wrapper.hh"
 
@@ -78,6 +87,9 @@ public: // Additional non-mandatory functionality
    */
   virtual double get_activity(ULINT var) override { return llwrap.get_activity(var); }
 
+  /* Asks the running solve() to stop */
+  virtual void interrupt(void) override { llwrap.interrupt(); }
+
 public: // Configuration methods
 
   /* Verbosity -- usually passed to solver */
@@ -107,6 +119,18 @@ public: // Configuration methods
     llwrap.set_max_conflicts(max_conflicts);
   }
 
+  /* Sets the timeout per call in seconds. 0 = no timeout
+   */
+  virtual void set_timeout(float to) override {
+    llwrap.set_timeout(to);
+  }
+
+  /* Sets the wall-clock timeout per call in seconds. 0 = no timeout
+   */
+  virtual void set_wc_timeout(float to) override {
+    llwrap.set_wc_timeout(to);
+  }
+
   /** Some incremental solvers implement optimizations that require the knowledge
    * of which variables are selectors. This method allows to set the largest
    * variable ID of problem variables (i.e. everything above that is a selector)
@@ -124,7 +148,7 @@ public:   // Access result of SAT solver call
   virtual void get_model(IntVector& rmodel) override { llwrap.get_model(rmodel);}
 
   /* Returns the reference to the group unsat core */
-  virtual GIDSet& get_group_unsat_core(void) override { return gcore; }
+  virtual DenseGIDSet& get_group_unsat_core(void) override { return gcore; }
 
 public: // Implemented non-group interface
 
@@ -144,7 +168,7 @@ public: // Implemented non-group interface
 public: // Implemented group interface
 
   /* Number of groups (including 0) */
-  virtual LINT gsize(void) override { return g2a_map.size() + has_g0; }
+  virtual LINT gsize(void) override { return ngroups + has_g0; }
 
   /* Maximum GID ever used in the solver */
   virtual GID max_gid(void) override { return maxgid; }
@@ -158,7 +182,9 @@ public: // Implemented group interface
   virtual void add_group(BasicGroupSet& gset, GID gid, bool final = false) override;
 
   /* True if group exists in the solver */
-  virtual bool exists_group(GID gid) override { return g2a_map.count(gid); }
+  virtual bool exists_group(GID gid) override {
+    return (gid < g2a.size()) && (g2a[gid] != a_none);
+  }
 
   /* Activates (non-final) group */
   virtual void activate_group(GID gid) override;
@@ -182,8 +208,44 @@ public: // Implemented group interface
    * group inactive; 0 means the group has been finalized. */
   virtual LINT get_group_activation_lit(GID gid) override;
 
+public: // Maintenance of the clause database
+
+  /* Sets up compaction of the clause database */
+  virtual void set_compaction(float ratio, bool rebuild) override {
+    cratio = ratio;
+    crebuild = rebuild && (ratio > 0);
+    llwrap.set_keep_learnts(crebuild || keep_learnts);
+  }
+
+  /* Makes the solver keep the clauses it learns for get_learnts() */
+  virtual void set_keep_learnts(bool keep) override {
+    keep_learnts = keep;
+    llwrap.set_keep_learnts(crebuild || keep_learnts);
+  }
+
+  /* True when the fraction cratio of groups has been deleted since the last
+   * compaction */
+  virtual bool compaction_due(void) override {
+    return (cratio > 0) && (ndeleted > 0) && (ndeleted >= cratio * (ngroups + ndeleted));
+  }
+
+  /* Removes satisfied clauses, if the solver knows how */
+  virtual bool compact(void) override;
+
+  /* Moves the learnt clauses that still hold into lcls */
+  virtual void get_learnts(std::vector<MUSer2::GroupLearnt>& lcls,
+                           ULINT max_var) override;
+
+  /* Adds learnt clauses taken out of another instance */
+  virtual void add_learnts(const std::vector<MUSer2::GroupLearnt>& lcls) override;
+
 public:  // Miscellaneous (stats, printing, etc)
 
+  virtual ULINT nconflicts(void) override { return llwrap.nconflicts(); }
+  virtual ULINT ndecisions(void) override { return llwrap.ndecisions(); }
+  virtual ULINT npropagations(void) override { return llwrap.npropagations(); }
+  virtual ULINT ndbclauses(void) override { return llwrap.ncls(); }
+
   /** Access to the underlying SAT solver.
    */
   virtual void* get_raw_solver_ptr(void) override {
@@ -203,6 +265,18 @@ protected: // helpers
   void solver_assert_unit_clause(LINT lit);
 
   void update_maxgid(GID gid) { if (gid > maxgid) { maxgid = gid; } }
+
+  /* Registers a new (active) group with the assumption variable aid */
+  void register_group(GID gid, ULINT aid);
+
+  /* Takes the assumption of the group out of the assumption array */
+  void drop_assumption(GID gid);
+
+  /* Returns the assumption literal of an existing group (see g2a) */
+  LINT& group_alit(GID gid) {
+    assert(exists_group(gid));
+    return g2a[gid];
+  }
   
 protected:
 
@@ -210,14 +284,37 @@ protected:
 
   SATSolverLowLevelWrapper& llwrap;  // low-level incremental wrapper
 
-  std::unordered_map<GID,LINT> g2a_map; // map from group IDs to assumptions;
+  static constexpr LINT a_none = std::numeric_limits<LINT>::min();
+
+  std::vector<LINT> g2a;            // map from group IDs to assumptions;
                                     // 0 means the group is final
                                     // <0 means the group is active
                                     // >0 means the group is inactive
+                                    // a_none means no such group
+
+  std::vector<ULINT> g2p;           // position of the group's assumption in
+                                    // assumps (non-final groups only)
+
+  static constexpr GID gid_Del = gid_Undef - 1;
+
+  std::vector<GID> a2g;             // map from assumption vars to GID
+                                    // (gid_Undef if not an assumption,
+                                    // gid_Del if the group is deleted)
+
+  IntVector assumps;                // assumption literals of all non-final
+                                    // groups, as passed to the solver
+
+  ULINT ngroups = 0;                // number of groups (excluding g0)
+
+  ULINT ndeleted = 0;               // groups deleted since last compaction
+
+  float cratio = 0;                 // compaction ratio (0 = never)
+
+  bool crebuild = false;            // true if compacting by rebuilding
 
-  std::unordered_map<ULINT,GID> a2g_map; // map from assumptions to GID
+  bool keep_learnts = false;        // true if learnts are kept for others
 
-  GIDSet gcore;                     // group core
+  DenseGIDSet gcore;                // group core
 
   GID maxgid = 0;                   // maximum group id (ever used)
 
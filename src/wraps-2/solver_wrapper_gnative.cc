@@ -0,0 +1,262 @@
+//jpms:bc
+/*----------------------------------------------------------------------------*\
+ * File:        solver_wrapper_gnative.cc
+ *
+ * Description: An implementation of an adapter class that provides an
+ *              incremental group-based interface to an instance of
+ *              SATSolverLowLevelWrapper with native clause removal.
+ *
+ * Author:      agent
+ *
+ * Notes:
+ *
+ *                                                    Copyright (c) 2026, agent
+\*----------------------------------------------------------------------------*/
+//jpms:ec
+
+#include "solver_wrapper_gnative.hh"
+
+using namespace std;
+
+//#define DBG(x) x
+
+/* Initialize all internal data structures */
+void SATSolverWrapperGrpNative::init_all(void)
+{
+  gcore.clear(); gstate.clear(); g2c.clear(); c2g.clear(); fgids.clear();
+  acids.clear();
+  ngroups = 0; maxgid = 0; has_g0 = isvalid = false;
+}
+
+/* Clean up all internal data structures */
+void SATSolverWrapperGrpNative::reset_all(void)
+{
+  llwrap.reset_solver();
+  gcore.clear(); gstate.clear(); g2c.clear(); c2g.clear(); fgids.clear();
+  acids.clear();
+  ngroups = 0; has_g0 = isvalid = false;
+}
+
+/* Initialize data structures for SAT run */
+void SATSolverWrapperGrpNative::init_run(void)
+{
+  if (isvalid) { throw std::logic_error("Solver interface is in invalid state."); }
+  llwrap.init_run();
+  gcore.clear();
+  isvalid = true;
+}
+
+/* Clean up data structures from SAT run */
+void SATSolverWrapperGrpNative::reset_run(void)
+{
+  if (!isvalid) { throw std::logic_error("Solver interface is in invalid state."); }
+  llwrap.reset_run();
+  isvalid = false;
+}
+
+/* This assumes that the GID of the clause is set correctly. This method
+ * will not check if the clause is marked as removed. Group 0 clauses are
+ * added as final.
+ */
+void SATSolverWrapperGrpNative::add_clause(BasicClause* cl)
+{
+  GID gid = cl->get_grp_id();
+  if (gid && !exists_group(gid))
+    register_group(gid);
+  DBG(cout << "Adding clause "; cl->dump(); cout << endl;);
+  solver_add_clause(cl, gid);
+  update_maxgid(gid);
+}
+
+/* Adds a final clause (non-removable) */
+void SATSolverWrapperGrpNative::add_final_clause(BasicClause* cl)
+{
+  DBG(cout << "Adding final clause "; cl->dump(); cout << endl;);
+  solver_add_clause(cl);
+}
+
+/* Adds a final unit clause (non-removable) */
+void SATSolverWrapperGrpNative::add_final_unit_clause(LINT lit)
+{
+  DBG(cout << "Adding final unit " << lit << endl;);
+  _clits.resize(1);
+  _clits[0] = lit;
+  llwrap.add_final_clause(_clits);
+}
+
+/* Adds all groups in the groupset */
+void SATSolverWrapperGrpNative::add_groups(BasicGroupSet& gset, bool g0final)
+{
+  for_each(gset.gbegin(), gset.gend(), [&](GID gid) {
+    add_group(gset, gid, (gid == 0) && g0final); });
+  update_maxgid(gset.max_gid());
+}
+
+/* Adds a single group from the groupset; if final = true the group is
+ * added as final right away (and is not registered, as with the other
+ * incremental wrapper).
+ */
+void SATSolverWrapperGrpNative::add_group(BasicGroupSet& gset, GID gid, bool final)
+{
+  if (gset.a_count(gid)) {
+    for (auto cl : gset.gclauses(gid))
+      if (!cl->removed()) {
+        if (!final && !exists_group(gid)) { register_group(gid); }
+        solver_add_clause(cl, final ? 0 : gid);
+      }
+    DBG(cout << "Added group gid " << gid << (final ? " (final)" : "") << endl;);
+    update_maxgid(gid);
+  }
+  if (!gid && final) { has_g0 = true; }
+}
+
+/* Activates (non-final) group */
+void SATSolverWrapperGrpNative::activate_group(GID gid)
+{
+  char& st = group_state(gid);
+  assert(st == g_Inactive);
+  if (!g2c[gid].empty()) { llwrap.bind_clauses(g2c[gid]); }
+  st = g_Active;
+  DBG(cout << "Act. gid " << gid << endl;);
+}
+
+/* Deactivates (non-final) group */
+void SATSolverWrapperGrpNative::deactivate_group(GID gid)
+{
+  char& st = group_state(gid);
+  assert(st == g_Active);
+  if (!g2c[gid].empty()) { llwrap.unbind_clauses(g2c[gid]); }
+  st = g_Inactive;
+  DBG(cout << "Deact. gid " << gid << endl;);
+}
+
+/* Returns true if either final, or non-final and active */
+bool SATSolverWrapperGrpNative::is_group_active(GID gid)
+{
+  return group_state(gid) != g_Inactive;
+}
+
+/* Removes (non-final) group; the solver takes out the clauses of the group
+ * together with the clauses learnt from them */
+void SATSolverWrapperGrpNative::del_group(GID gid)
+{
+  char& st = group_state(gid);
+  if ((st != g_Final) && !g2c[gid].empty())
+    llwrap.remove_clauses(g2c[gid]);
+  DBG(cout << "Del. gid " << gid << endl;);
+  IntVector().swap(g2c[gid]);
+  fgids.erase(gid);
+  st = g_None;
+  --ngroups;
+}
+
+/* Finalizes a group; its clauses stay in the solver (bound, if needed),
+ * unless the group has a falsified clause, in which case the instance is
+ * UNSAT for good */
+void SATSolverWrapperGrpNative::make_group_final(GID gid)
+{
+  char& st = group_state(gid);
+  if ((st == g_Inactive) && !g2c[gid].empty())
+    llwrap.bind_clauses(g2c[gid]);
+  if (fgids.count(gid)) {
+    _clits.clear();
+    llwrap.add_final_clause(_clits);
+  }
+  st = g_Final;
+  DBG(cout << "Fin. gid " << gid << endl;);
+}
+
+/* True if group is final */
+bool SATSolverWrapperGrpNative::is_group_final(GID gid)
+{
+  return group_state(gid) == g_Final;
+}
+
+/// most important stuff is in the helpers ...
+
+/* Solve the current set of clauses instance */
+SATRes SATSolverWrapperGrpNative::solve(const IntVector* assump)
+{
+  if (!isvalid)
+    throw std::logic_error("Solver interface is in invalid state.");
+  // an active group with a falsified clause is a core by itself
+  for (GID gid : fgids)
+    if (group_state(gid) != g_Inactive) {
+      DBG(cout << "Group " << gid << " is falsified, skipping the call" << endl;);
+      gcore.insert(gid);
+      return SAT_False;
+    }
+  // add extra assumptions as removable units
+  bool falsified = false;
+  if (assump != nullptr) {
+    _clits.resize(1);
+    for (LINT lit : *assump) {
+      _clits[0] = lit;
+      LINT cid = llwrap.add_removable_clause(_clits);
+      if (cid >= 0) {
+        acids.push_back(cid);
+        if ((ULINT)cid >= c2g.size()) { c2g.resize(cid + 1, gid_Undef); }
+        c2g[cid] = gid_Undef;
+      } else if (cid == SATSolverLowLevelWrapper::cid_False) {
+        falsified = true;
+        break;
+      }
+    }
+  }
+  SATRes res = falsified ? SAT_False : llwrap.solve();
+  if ((res == SAT_False) && !falsified) {
+    IntVector& core = llwrap.get_unsat_core();
+    gcore.reserve(maxgid);
+    for (auto cid : core) {
+      assert((ULINT)cid < c2g.size());
+      if (c2g[cid] != gid_Undef) { gcore.insert(c2g[cid]); }
+    }
+  }
+  if (!acids.empty()) {
+    llwrap.remove_clauses(acids);
+    acids.clear();
+  }
+  return res;
+}
+
+/* Add a clause of the (existing) group gid to the solver; gid = 0 means
+ * the clause is final */
+void SATSolverWrapperGrpNative::solver_add_clause(BasicClause* cl, GID gid)
+{
+  if (gid == 0) {
+    llwrap.add_final_clause(cl);
+    DBG(cout << "Added final clause: "; cl->dump(); cout << endl;);
+    return;
+  }
+  _clits.assign(cl->abegin(), cl->aend());
+  LINT cid = llwrap.add_removable_clause(_clits);
+  if (cid >= 0) {
+    g2c[gid].push_back(cid);
+    if ((ULINT)cid >= c2g.size()) { c2g.resize(cid + 1, gid_Undef); }
+    c2g[cid] = gid;
+    if (gstate[gid] == g_Inactive) {
+      _clits.assign(1, cid);
+      llwrap.unbind_clauses(_clits);
+    }
+  } else if (cid == SATSolverLowLevelWrapper::cid_False) {
+    fgids.insert(gid);
+    if (gstate[gid] == g_Final) {
+      _clits.clear();
+      llwrap.add_final_clause(_clits);
+    }
+  }
+  DBG(cout << "Added clause: "; cl->dump(); cout << ", cid: " << cid << endl;);
+}
+
+/* Registers a new (active) group */
+void SATSolverWrapperGrpNative::register_group(GID gid)
+{
+  if (gid >= gstate.size()) {
+    gstate.resize(gid + 1, g_None);
+    g2c.resize(gid + 1);
+  }
+  gstate[gid] = g_Active;
+  ++ngroups;
+}
+
+/*----------------------------------------------------------------------------*/
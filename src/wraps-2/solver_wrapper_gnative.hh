@@ -0,0 +1,243 @@
+//jpms:bc
+/*----------------------------------------------------------------------------*\
+ * File:        solver_wrapper_gnative.hh
+ *
+ * Description: An adapter class that provides an incremental group-based
+ *              interface to an instance of SATSolverLowLevelWrapper that
+ *              knows to disable and remove clauses natively.
+ *
+ * Author:      agent
+ *
+ * Notes:
+ *      1. No selector variables and no assumptions are used: the clauses of
+ *         the non-final groups are added as removable clauses, and the group
+ *         operations map directly onto unbind/bind/remove in the solver. The
+ *         clauses learnt from the clauses of a deleted group go away with
+ *         them, so there is no need for compaction.
+ *      2. The extra assumptions passed to solve() are emulated by removable
+ *         unit clauses that are removed right after the call.
+ *      3. A clause that is falsified at the top-level by the final clauses
+ *         cannot be given to the solver; its group is remembered instead, and
+ *         solve() reports UNSAT with the core made of this group alone while
+ *         the group is active.
+ *
+ *                                                    Copyright (c) 2026, agent
+\*----------------------------------------------------------------------------*/
+//jpms:ec
+
+#pragma once
+
+#include <vector>
+#include "solver_wrapper.hh"
+#include "solver_ll_wrapper.hh"
+
+/*----------------------------------------------------------------------------*\
+ * Class: SATSolverWrapperGrpNative
+ *
+ * Purpose: A group-based wrapper around SATSolverLowLevelWrapper with native
+ *          clause removal (see SATSolverLowLevelWrapper::is_deleting()).
+ *
+\*----------------------------------------------------------------------------*/
+
+class SATSolverWrapperGrpNative : public MUSer2::SATSolverWrapper {
+
+  friend class MUSer2::SATSolverFactory;
+
+protected:  // Constructor/destructor
+
+  SATSolverWrapperGrpNative(IDManager& _imgr, SATSolverLowLevelWrapper& _llwrap)
+    : MUSer2::SATSolverWrapper(_imgr), llwrap(_llwrap) {}
+
+  virtual ~SATSolverWrapperGrpNative(void) {}
+
+public: // Implementation of the main interface methods
+
+  /* Initialize all internal data structures */
+  virtual void init_all(void) override;
+
+  /* Clean up all internal data structures */
+  virtual void reset_all(void) override;
+
+  /* Initialize data structures for SAT run */
+  virtual void init_run(void) override;
+
+  /* Clean up data structures from SAT run */
+  virtual void reset_run(void) override;
+
+  /* Solve the current set of clauses instance */
+  virtual SATRes solve(void) override { return solve(nullptr); }
+
+  /* Solve the current set of clauses with extra assumptions; the assumptions
+   * are added as removable unit clauses for the duration of the call.
+   */
+  virtual SATRes solve(const IntVector& assum) override { return solve(&assum); }
+
+  /* Asks the running solve() to stop */
+  virtual void interrupt(void) override { llwrap.interrupt(); }
+
+public: // Configuration methods
+
+  /* Verbosity -- usually passed to solver */
+  virtual void set_verbosity(int verb) override { llwrap.set_verbosity(verb); }
+
+  /* Sets the default phase: 0 - false, 1 - true, 2 - random */
+  virtual void set_phase(LINT phase) override { llwrap.set_def_phase(phase); }
+
+  /* Sets the preferred phase for a particular variable: 0 - false, 1 - true
+   */
+  virtual void set_phase(ULINT var, LINT phase) override {
+    llwrap.set_polarity(var, (bool)phase);
+  }
+
+  /* Sets the maximum number of conflicts per call. Note that this affects
+   * completeness. -1 = no maximum.
+   */
+  virtual void set_max_conflicts(LINT max_conflicts) override {
+    llwrap.set_max_conflicts(max_conflicts);
+  }
+
+  /* Sets the timeout per call in seconds. 0 = no timeout
+   */
+  virtual void set_timeout(float to) override {
+    llwrap.set_timeout(to);
+  }
+
+  /* Sets the wall-clock timeout per call in seconds. 0 = no timeout
+   */
+  virtual void set_wc_timeout(float to) override {
+    llwrap.set_wc_timeout(to);
+  }
+
+public:   // Access result of SAT solver call
+
+  /* Returns the reference to the model (r/w) */
+  virtual IntVector& get_model(void) override { return llwrap.get_model(); }
+
+  /* Makes a copy of the model (resized as needed) */
+  virtual void get_model(IntVector& rmodel) override { llwrap.get_model(rmodel);}
+
+  /* Returns the reference to the group unsat core */
+  virtual DenseGIDSet& get_group_unsat_core(void) override { return gcore; }
+
+public: // Implemented non-group interface
+
+  /* This assumes that the GID of the clause is set correctly. This method
+   * will not check if the clause is marked as removed. Group 0 clauses are
+   * added as final.
+   */
+  virtual void add_clause(BasicClause* cl) override;
+
+  /* Adds a final clause (non-removable) */
+  virtual void add_final_clause(BasicClause* cl) override;
+
+  /* Adds a final unit clause (non-removable) */
+  virtual void add_final_unit_clause(LINT lit) override;
+
+public: // Implemented group interface
+
+  /* Number of groups (including 0) */
+  virtual LINT gsize(void) override { return ngroups + has_g0; }
+
+  /* Maximum GID ever used in the solver */
+  virtual GID max_gid(void) override { return maxgid; }
+
+  /* Adds all groups in the groupset */
+  virtual void add_groups(BasicGroupSet& gset, bool g0final = true) override;
+
+  /* Adds a single group from the groupset; if final = true the group is
+   * added as final right away.
+   */
+  virtual void add_group(BasicGroupSet& gset, GID gid, bool final = false) override;
+
+  /* True if group exists in the solver */
+  virtual bool exists_group(GID gid) override {
+    return (gid < gstate.size()) && (gstate[gid] != g_None);
+  }
+
+  /* Activates (non-final) group */
+  virtual void activate_group(GID gid) override;
+
+  /* Deactivates (non-final) group */
+  virtual void deactivate_group(GID gid) override;
+
+  /* Returns true if either final, or non-final and active */
+  virtual bool is_group_active(GID gid) override;
+
+  /* Removes (non-final) group */
+  virtual void del_group(GID gid) override;
+
+  /* Finalizes a group */
+  virtual void make_group_final(GID gid) override;
+
+  /* True if group is final */
+  virtual bool is_group_final(GID gid) override;
+
+public:  // Miscellaneous (stats, printing, etc)
+
+  virtual ULINT nconflicts(void) override { return llwrap.nconflicts(); }
+  virtual ULINT ndecisions(void) override { return llwrap.ndecisions(); }
+  virtual ULINT npropagations(void) override { return llwrap.npropagations(); }
+  virtual ULINT ndbclauses(void) override { return llwrap.ncls(); }
+
+  /** Access to the underlying SAT solver.
+   */
+  virtual void* get_raw_solver_ptr(void) override {
+    return llwrap.get_raw_solver_ptr();
+  }
+
+protected: // helpers
+
+  /* Runs the solve() method and processes the results */
+  SATRes solve(const IntVector* assump);
+
+  /* Add a clause of the (existing) group gid to the solver; gid = 0 means
+   * the clause is final */
+  void solver_add_clause(BasicClause* cl, GID gid = 0);
+
+  /* Registers a new (active) group */
+  void register_group(GID gid);
+
+  void update_maxgid(GID gid) { if (gid > maxgid) { maxgid = gid; } }
+
+  /* Returns the state of an existing group */
+  char& group_state(GID gid) {
+    assert(exists_group(gid));
+    return gstate[gid];
+  }
+
+protected:
+
+  bool isvalid = false;
+
+  SATSolverLowLevelWrapper& llwrap;  // low-level incremental wrapper
+
+  enum : char { g_None = 0, g_Active, g_Inactive, g_Final };
+
+  std::vector<char> gstate;         // map from group IDs to their states
+
+  std::vector<IntVector> g2c;       // map from group IDs to the ids of their
+                                    // removable clauses
+
+  std::vector<GID> c2g;             // map from clause ids to GIDs (gid_Undef
+                                    // for the units of extra assumptions)
+
+  GIDSet fgids;                     // groups with clauses falsified at the
+                                    // top-level (see Note 3)
+
+  IntVector acids;                  // ids of the units of extra assumptions
+
+  ULINT ngroups = 0;                // number of groups (excluding g0)
+
+  DenseGIDSet gcore;                // group core
+
+  GID maxgid = 0;                   // maximum group id (ever used)
+
+  bool has_g0 = false;              // true when g0 has been added as final
+
+private:
+
+  IntVector _clits;                 // vector for literals
+
+};
+
+/*----------------------------------------------------------------------------*/
@@ -37,6 +37,7 @@ void SATSolverWrapperGrpNonIncr::reset_all(void)
 void SATSolverWrapperGrpNonIncr::init_run(void)
 {
   if (isvalid) { throw std::logic_error("Solver interface is in invalid state."); }
+  gcore.clear();
   isvalid = true;
 }
 
@@ -186,7 +187,7 @@ void SATSolverWrapperGrpNonIncr::solver_add_clause(BasicClause* cl, bool final)
   // make a copy (often not really created, due to the clause registry), and
   // insert a copy instead
   BasicClauseSet& cs = (final && gid != 0) ? f_cset : cset;
-  BasicClause* new_cl = cs.create_clause(cs.get_cl_lits(cl));
+  BasicClause* new_cl = cs.create_clause(cl->size(), cl->lits());
   cs.set_cl_grp_id(new_cl, gid);
   DBG(cout << "Added " << (final ? "final " : "") << "clause " << cl; cl->dump();
       cout << "size=" << f_cset.size();
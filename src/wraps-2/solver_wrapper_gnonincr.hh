@@ -102,7 +102,7 @@ public: // Configuration methods
   /* Sets the preferred phase for a particular variable: 0 - false, 1 - true
    */
   virtual void set_phase(ULINT var, LINT phase) override {
-    llwrap.set_phase(var, phase);
+    llwrap.set_polarity(var, (bool)phase);
   }
 
   /* Sets the maximum number of conflicts per call. Note that this affects
@@ -121,7 +121,7 @@ public:   // Access result of SAT solver call
   virtual void get_model(IntVector& rmodel) override { llwrap.get_model(rmodel);}
 
   /* Returns the reference to the group unsat core */
-  virtual GIDSet& get_group_unsat_core(void) override { return gcore; }
+  virtual DenseGIDSet& get_group_unsat_core(void) override { return gcore; }
 
 public: // Implemented non-group interface
 
@@ -222,7 +222,7 @@ protected:
 
   std::vector<LINT> units;                  // extra units
 
-  GIDSet gcore;                             // group core
+  DenseGIDSet gcore;                        // group core
 
   GID maxgid = 0;                           // maximum group id (ever used)
 
@@ -37,6 +37,7 @@ void SATSolverWrapperGrpSLS::reset_all(void)
 void SATSolverWrapperGrpSLS::init_run(void)
 {
   if (isvalid) { throw std::logic_error("Solver interface is in invalid state."); }
+  gcore.clear();
   llwrap.set_verbosity(verbosity);
   llwrap.set_weighted(false);
   llwrap.set_max_tries(10);
@@ -191,7 +192,7 @@ void SATSolverWrapperGrpSLS::solver_add_clause(BasicClause* cl, bool final)
   // make a copy (often not really created, due to the clause registry), and
   // insert a copy instead
   BasicClauseSet& cs = (final && gid != 0) ? f_cset : cset;
-  BasicClause* new_cl = cs.create_clause(cs.get_cl_lits(cl));
+  BasicClause* new_cl = cs.create_clause(cl->size(), cl->lits());
   cs.set_cl_grp_id(new_cl, gid);
   DBG(cout << "Added " << (final ? "final " : "") << "clause "; cl->dump();
       cout << ", f_cset size=" << f_cset.size();
@@ -88,7 +88,7 @@ public:   // Access result of SAT solver call
   virtual void get_model(IntVector& rmodel) override { rmodel = _model; }
 
   /* Returns the reference to the group unsat core */
-  virtual GIDSet& get_group_unsat_core(void) override { return gcore; }
+  virtual DenseGIDSet& get_group_unsat_core(void) override { return gcore; }
 
 public: // Implemented non-group interface
 
@@ -189,7 +189,7 @@ protected:
 
   std::vector<LINT> units;                  // extra units
 
-  GIDSet gcore;                             // group core
+  DenseGIDSet gcore;                        // group core
 
   GID maxgid = 0;                           // maximum group id (ever used)
 
@@ -0,0 +1,150 @@
+//jpms:bc
+/*----------------------------------------------------------------------------*\
+ * File:        solver_wrapper_portfolio.cc
+ *
+ * Description: Implementation of the portfolio SAT solver wrapper.
+ *
+ * Author:      agent
+ *
+ * Notes:       see the header.
+ *
+ *                                                    Copyright (c) 2026, agent
+\*----------------------------------------------------------------------------*/
+//jpms:ec
+
+#ifdef MULTI_THREADED
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "solver_wrapper_portfolio.hh"
+
+using namespace std;
+
+//#define DBG(x) x
+
+namespace {
+
+  /* The configuration of one of the solvers of the portfolio: the same as
+   * the configuration of the portfolio, except for the solver itself.
+   */
+  class MemberConfig : public SATSolverConfig {
+  public:
+    MemberConfig(SATSolverConfig& config, const string& solver)
+      : _config(config), _solver(solver) {}
+    virtual bool chk_sat_solver(const char* solver) { return _solver == solver; }
+    virtual bool get_incr_mode(void) { return true; }
+    virtual int get_verbosity(void) { return _config.get_verbosity(); }
+    virtual bool get_grp_mode(void) { return _config.get_grp_mode(); }
+    virtual bool get_trace_enabled(void) { return _config.get_trace_enabled(); }
+    virtual const char* get_ipasir_lib(void) { return _config.get_ipasir_lib(); }
+    virtual float get_compact_ratio(void) { return _config.get_compact_ratio(); }
+    virtual bool get_compact_rebuild(void) { return _config.get_compact_rebuild(); }
+    virtual bool get_share_learnts(void) { return _config.get_share_learnts(); }
+    virtual const SATSolverStop* get_stop(void) { return _config.get_stop(); }
+  protected:
+    SATSolverConfig& _config;
+    string _solver;
+  };
+
+} // anonymous namespace
+
+/* Makes the solvers listed in config.get_portfolio() */
+SATSolverWrapperPortfolio::SATSolverWrapperPortfolio(IDManager& _imgr,
+                                                     SATSolverConfig& config)
+  : MUSer2::SATSolverWrapper(_imgr)
+{
+  string names(config.get_portfolio());
+  for (size_t pos = 0; pos < names.size() + 1; ) {
+    size_t end = names.find(',', pos);
+    if (end == string::npos) { end = names.size(); }
+    MemberConfig mconfig(config, names.substr(pos, end - pos));
+    _facts.push_back(new MUSer2::SATSolverFactory(_imgr));
+    _solvers.push_back(&_facts.back()->instance(mconfig));
+    DBG(cout << "Portfolio solver " << names.substr(pos, end - pos) << endl;);
+    pos = end + 1;
+  }
+  if (_solvers.size() < 2)
+    tool_abort("the portfolio needs at least two SAT solvers");
+  _res.resize(_solvers.size(), SAT_NoRes);
+  _done.resize(_solvers.size(), 0);
+  for (unsigned i = 0; i < _solvers.size(); ++i)
+    _threads.emplace_back(&SATSolverWrapperPortfolio::serve, this, i);
+}
+
+SATSolverWrapperPortfolio::~SATSolverWrapperPortfolio(void)
+{
+  {
+    lock_guard<mutex> lk(_mtx);
+    _quit = true;
+  }
+  _cv_start.notify_all();
+  for (thread& t : _threads)
+    t.join();
+  for (MUSer2::SATSolverFactory* pf : _facts)
+    delete pf;
+}
+
+/* Runs all solvers in their threads, and takes the first one that comes
+ * back with an answer; the others are interrupted, over and over again until
+ * they are back (an interrupt that arrives before a solver gets going is
+ * dropped by it). If none of the solvers has an answer (e.g. because of the
+ * limits), the outcome of the first one is returned.
+ */
+SATRes SATSolverWrapperPortfolio::solve(const IntVector* assump)
+{
+  unsigned n = _solvers.size();
+  unique_lock<mutex> lk(_mtx);
+  _assump = assump;
+  fill(_res.begin(), _res.end(), SAT_NoRes);
+  fill(_done.begin(), _done.end(), 0);
+  _ndone = 0;
+  _first = -1;
+  ++_call;
+  _cv_start.notify_all();
+  _cv_done.wait(lk, [&]() { return (_first != -1) || (_ndone == n); });
+  while (_ndone < n) {
+    for (unsigned i = 0; i < n; ++i)
+      if (!_done[i]) { _solvers[i]->interrupt(); }
+    _cv_done.wait_for(lk, chrono::milliseconds(1));
+  }
+  _winner = (_first == -1) ? 0 : _first;
+  DBG(cout << "Portfolio: solver " << _winner << " won, result "
+           << _res[_winner] << endl;);
+  return _res[_winner];
+}
+
+/* Thread main of the i-th solver: runs it on each call, until the portfolio
+ * is gone
+ */
+void SATSolverWrapperPortfolio::serve(unsigned i)
+{
+  unsigned call = 0;
+  while (true) {
+    const IntVector* assump;
+    {
+      unique_lock<mutex> lk(_mtx);
+      _cv_start.wait(lk, [&]() { return _quit || (_call != call); });
+      if (_quit)
+        return;
+      call = _call;
+      assump = _assump;
+    }
+    SATRes r = (assump == nullptr) ? _solvers[i]->solve()
+      : _solvers[i]->solve(*assump);
+    lock_guard<mutex> lk(_mtx);
+    _res[i] = r;
+    _done[i] = 1;
+    ++_ndone;
+    if ((_first == -1) && ((r == SAT_True) || (r == SAT_False)))
+      _first = i;
+    _cv_done.notify_all();
+  }
+}
+
+#endif // MULTI_THREADED
+
+/*----------------------------------------------------------------------------*/
@@ -0,0 +1,266 @@
+//jpms:bc
+/*----------------------------------------------------------------------------*\
+ * File:        solver_wrapper_portfolio.hh
+ *
+ * Description: A group-based SAT solver wrapper that races several
+ *              incremental SAT solvers against each other on each call.
+ *
+ * Author:      agent
+ *
+ * Notes:
+ *      1. Each solver sits behind its own group wrapper (as made by
+ *         SATSolverFactory), and all of the changes to the clauses and groups
+ *         go to all of them; hence, the group states are always the same.
+ *      2. Each solver has its own thread, started with the portfolio and
+ *         kept until it is gone, so a solver is always run on the same
+ *         thread (some solvers keep per-thread state). On each call the
+ *         solvers run in their threads; the first one to come back with an
+ *         answer wins, and the rest are interrupted (see
+ *         SATSolverWrapper::interrupt()). The model and the core are taken
+ *         from the winner.
+ *      3. Multi-threaded builds only (MULTI_THREADED).
+ *
+ *                                                    Copyright (c) 2026, agent
+\*----------------------------------------------------------------------------*/
+//jpms:ec
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "solver_config.hh"
+#include "solver_factory.hh"
+#include "solver_wrapper.hh"
+
+/*----------------------------------------------------------------------------*\
+ * Class: SATSolverWrapperPortfolio
+ *
+ * Purpose: A group-based wrapper that runs a portfolio of SAT solvers.
+ *
+\*----------------------------------------------------------------------------*/
+
+class SATSolverWrapperPortfolio : public MUSer2::SATSolverWrapper {
+
+  friend class MUSer2::SATSolverFactory;
+
+protected:  // Constructor/destructor
+
+  /* Makes the solvers listed in config.get_portfolio() */
+  SATSolverWrapperPortfolio(IDManager& _imgr, SATSolverConfig& config);
+
+  virtual ~SATSolverWrapperPortfolio(void);
+
+public: // Implementation of the main interface methods
+
+  virtual void init_all(void) override { each([](Solver& s) { s.init_all(); }); }
+
+  virtual void reset_all(void) override { each([](Solver& s) { s.reset_all(); }); }
+
+  virtual void init_run(void) override { each([](Solver& s) { s.init_run(); }); }
+
+  virtual void reset_run(void) override { each([](Solver& s) { s.reset_run(); }); }
+
+  /* Solve the current set of clauses instance */
+  virtual SATRes solve(void) override { return solve(nullptr); }
+
+  /* Solve the current set of clauses with extra assumptions */
+  virtual SATRes solve(const IntVector& assum) override { return solve(&assum); }
+
+  /* Asks the running solve() to stop */
+  virtual void interrupt(void) override { each([](Solver& s) { s.interrupt(); }); }
+
+public: // Configuration methods
+
+  virtual void set_verbosity(int verb) override {
+    each([&](Solver& s) { s.set_verbosity(verb); });
+  }
+
+  virtual void set_phase(LINT phase) override {
+    each([&](Solver& s) { s.set_phase(phase); });
+  }
+
+  virtual void set_phase(ULINT var, LINT phase) override {
+    each([&](Solver& s) { s.set_phase(var, phase); });
+  }
+
+  virtual void set_max_conflicts(LINT max_conflicts) override {
+    each([&](Solver& s) { s.set_max_conflicts(max_conflicts); });
+  }
+
+  virtual void set_timeout(float to) override {
+    each([&](Solver& s) { s.set_timeout(to); });
+  }
+
+  virtual void set_wc_timeout(float to) override {
+    each([&](Solver& s) { s.set_wc_timeout(to); });
+  }
+
+  virtual void set_max_problem_var(ULINT pvar) override {
+    each([&](Solver& s) { s.set_max_problem_var(pvar); });
+  }
+
+public:   // Access result of SAT solver call (from the last winner)
+
+  virtual IntVector& get_model(void) override { return winner().get_model(); }
+
+  virtual void get_model(IntVector& rmodel) override { winner().get_model(rmodel); }
+
+  virtual DenseGIDSet& get_group_unsat_core(void) override {
+    return winner().get_group_unsat_core();
+  }
+
+public: // Non-group interface
+
+  virtual void add_clause(BasicClause* cl) override {
+    each([&](Solver& s) { s.add_clause(cl); });
+  }
+
+  virtual void add_final_clause(BasicClause* cl) override {
+    each([&](Solver& s) { s.add_final_clause(cl); });
+  }
+
+  virtual void add_final_unit_clause(LINT lit) override {
+    each([&](Solver& s) { s.add_final_unit_clause(lit); });
+  }
+
+public: // Group interface
+
+  virtual LINT gsize(void) override { return first().gsize(); }
+
+  virtual GID max_gid(void) override { return first().max_gid(); }
+
+  virtual void add_groups(BasicGroupSet& gset, bool g0final = true) override {
+    each([&](Solver& s) { s.add_groups(gset, g0final); });
+  }
+
+  virtual void add_group(BasicGroupSet& gset, GID gid, bool final = false) override {
+    each([&](Solver& s) { s.add_group(gset, gid, final); });
+  }
+
+  virtual bool exists_group(GID gid) override { return first().exists_group(gid); }
+
+  virtual void activate_group(GID gid) override {
+    each([&](Solver& s) { s.activate_group(gid); });
+  }
+
+  virtual void deactivate_group(GID gid) override {
+    each([&](Solver& s) { s.deactivate_group(gid); });
+  }
+
+  virtual bool is_group_active(GID gid) override { return first().is_group_active(gid); }
+
+  virtual void del_group(GID gid) override {
+    each([&](Solver& s) { s.del_group(gid); });
+  }
+
+  virtual void make_group_final(GID gid) override {
+    each([&](Solver& s) { s.make_group_final(gid); });
+  }
+
+  virtual bool is_group_final(GID gid) override { return first().is_group_final(gid); }
+
+public: // Maintenance of the clause database
+
+  virtual void set_compaction(float ratio, bool rebuild) override {
+    each([&](Solver& s) { s.set_compaction(ratio, rebuild); });
+  }
+
+  virtual bool compaction_due(void) override { return first().compaction_due(); }
+
+  /* Compacts all solvers in place; false if any one of them could not */
+  virtual bool compact(void) override {
+    bool done = true;
+    each([&](Solver& s) { done = s.compact() && done; });
+    return done;
+  }
+
+  /* The learnt clauses are taken from the first solver only, as the others
+   * would mostly repeat them */
+  virtual void set_keep_learnts(bool keep) override { first().set_keep_learnts(keep); }
+
+  virtual void get_learnts(std::vector<MUSer2::GroupLearnt>& lcls, ULINT max_var) override {
+    first().get_learnts(lcls, max_var);
+  }
+
+  virtual void add_learnts(const std::vector<MUSer2::GroupLearnt>& lcls) override {
+    each([&](Solver& s) { s.add_learnts(lcls); });
+  }
+
+public:  // Miscellaneous (stats, printing, etc)
+
+  /* The work done by all of the solvers */
+  virtual ULINT nconflicts(void) override {
+    return sum([](Solver& s) { return s.nconflicts(); });
+  }
+  virtual ULINT ndecisions(void) override {
+    return sum([](Solver& s) { return s.ndecisions(); });
+  }
+  virtual ULINT npropagations(void) override {
+    return sum([](Solver& s) { return s.npropagations(); });
+  }
+  virtual ULINT ndbclauses(void) override {
+    return sum([](Solver& s) { return s.ndbclauses(); });
+  }
+
+  /* Access to the first solver */
+  virtual void* get_raw_solver_ptr(void) override { return first().get_raw_solver_ptr(); }
+
+protected: // helpers
+
+  typedef MUSer2::SATSolverWrapper Solver;
+
+  /* Races the solvers */
+  SATRes solve(const IntVector* assump);
+
+  /* Thread main of the i-th solver: runs it on each call */
+  void serve(unsigned i);
+
+  template<class F> void each(F f) { for (Solver* ps : _solvers) { f(*ps); } }
+
+  template<class F> ULINT sum(F f) {
+    ULINT res = 0;
+    for (Solver* ps : _solvers) { res += f(*ps); }
+    return res;
+  }
+
+  Solver& first(void) { return *_solvers[0]; }
+
+  Solver& winner(void) { return *_solvers[_winner]; }
+
+protected:
+
+  std::vector<MUSer2::SATSolverFactory*> _facts; // a factory per solver
+
+  std::vector<Solver*> _solvers;    // the solvers (from _facts)
+
+  unsigned _winner = 0;             // index of the winner of the last call
+
+  // the threads, and the state of the current call (protected by _mtx)
+
+  std::vector<std::thread> _threads; // a thread per solver
+
+  std::mutex _mtx;
+
+  std::condition_variable _cv_start; // a new call is there (or quit)
+
+  std::condition_variable _cv_done; // a solver is done with the call
+
+  unsigned _call = 0;               // number of the current call
+
+  const IntVector* _assump = nullptr; // the assumptions of the current call
+
+  std::vector<SATRes> _res;         // per solver: the outcome of the call
+
+  std::vector<char> _done;          // per solver: 1 if done with the call
+
+  unsigned _ndone = 0;              // the solvers done with the call
+
+  int _first = -1;                  // the first solver with an answer
+
+  bool _quit = false;               // tells the threads to finish
+
+};
+
+/*----------------------------------------------------------------------------*/
@@ -10,45 +10,138 @@
 \*----------------------------------------------------------------------------*/
 //jpms:ec
 
-#ifdef IPASIR_LIB
-
 #include <algorithm>
+#include <climits>
+#include <map>
+#include <string>
 #include "globals.hh"
 #include "IPASIR_ll_wrapper.hh"
+#ifdef MULTI_THREADED
+#include <atomic>
+#include <mutex>
+#endif
+#ifdef IPASIR_DL // loading libraries at run-time
+#include <dlfcn.h>
+#endif
+
+#ifdef IPASIR_LIB // the solver linked in at build time
+extern "C" {
+#include "ipasir.h"
+}
+#endif
 
 using namespace std;
 
 //#define DBG(x) x
 
-static const int abs_max(const unsigned int a, const int b)
+static int abs_max(const int a, const int b)
 {
   const int abs_b = (b >= 0) ? b : -b;
   return a > abs_b ? a : abs_b;
 }
 
+namespace {
+
+  /* Prints the warning once per run */
+  void warn_once(const char* msg)
+  {
+#ifdef MULTI_THREADED
+    static atomic<bool> warned(false);
+    if (warned.exchange(true)) { return; }
+#else
+    static bool warned = false;
+    if (warned) { return; }
+    warned = true;
+#endif
+    cout << "WARNING: " << msg << endl;
+  }
+
+#ifdef IPASIR_DL
+  /* Looks up a symbol in the library; aborts if it is not there, unless
+   * optional */
+  template<class F>
+  void lookup(void* handle, const char* path, const char* name, F& fn,
+              bool optional = false)
+  {
+    fn = reinterpret_cast<F>(dlsym(handle, name));
+    if ((fn == nullptr) && !optional) {
+      cout << "ERROR: " << name << "() is missing in " << path << endl;
+      tool_abort("invalid IPASIR library");
+    }
+  }
+#endif
+
+}
+
+/* Loads the library (once per path) */
+const IPASIRLib& IPASIRLib::load(const char* path)
+{
+  static map<string, IPASIRLib> libs;
+#ifdef MULTI_THREADED
+  static mutex libs_mtx;
+  lock_guard<mutex> lock(libs_mtx);
+#endif
+  string key = (path == nullptr) ? "" : path;
+  auto pl = libs.find(key);
+  if (pl != libs.end())
+    return pl->second;
+  IPASIRLib lib;
+  if (path == nullptr) {
+#ifdef IPASIR_LIB
+    lib.signature = ipasir_signature;
+    lib.init = ipasir_init;
+    lib.release = ipasir_release;
+    lib.add = ipasir_add;
+    lib.assume = ipasir_assume;
+    lib.solve = ipasir_solve;
+    lib.val = ipasir_val;
+    lib.failed = ipasir_failed;
+    lib.set_terminate = ipasir_set_terminate;
+    lib.set_learn = ipasir_set_learn;
+#else
+    tool_abort("no IPASIR library is given, and none is compiled in");
+#endif
+  } else {
+#ifdef IPASIR_DL
+    void* handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+      cout << "ERROR: " << dlerror() << endl;
+      tool_abort("unable to load IPASIR library");
+    }
+    lookup(handle, path, "ipasir_signature", lib.signature);
+    lookup(handle, path, "ipasir_init", lib.init);
+    lookup(handle, path, "ipasir_release", lib.release);
+    lookup(handle, path, "ipasir_add", lib.add);
+    lookup(handle, path, "ipasir_assume", lib.assume);
+    lookup(handle, path, "ipasir_solve", lib.solve);
+    lookup(handle, path, "ipasir_val", lib.val);
+    lookup(handle, path, "ipasir_failed", lib.failed);
+    lookup(handle, path, "ipasir_set_terminate", lib.set_terminate);
+    lookup(handle, path, "ipasir_set_learn", lib.set_learn, true);
+#else
+    tool_abort("loading IPASIR libraries at run-time needs a build with dl=1");
+#endif
+  }
+  return libs.insert(make_pair(key, lib)).first->second;
+}
+
 // Constructor.
-IPASIRLowLevelWrapper::IPASIRLowLevelWrapper(IDManager& _imgr) :
-  SATSolverLowLevelWrapper(_imgr)
+IPASIRLowLevelWrapper::IPASIRLowLevelWrapper(IDManager& _imgr,
+                                             const IPASIRLib& _lib) :
+  SATSolverLowLevelWrapper(_imgr), lib(_lib)
 {
-  solver = ipasir_init();
+  solver = lib.init();
 }
 
 IPASIRLowLevelWrapper::~IPASIRLowLevelWrapper(void)
 {
-  if (solver != nullptr) { ipasir_release(solver); solver = nullptr; max_var = 0;}
+  if (solver != nullptr) { lib.release(solver); solver = nullptr; max_var = 0;}
 }
 
 void IPASIRLowLevelWrapper::init_run(void)
 {
   assert(!isvalid);
   model.clear(); ucore.clear(); isvalid = true;
-
-#if 0
-  ipasir_set_verbosity(solver, max((int)verbosity - 10, 0));
-  // phases in picosat: 0 = false, 1 = true, 2 = Jeroslow-Wang (default), 3 = random
-  if (phase != 3)
-    ipasir_set_global_default_phase(solver, (phase == 2) ? 3 : phase);
-#endif
 }
 
 void IPASIRLowLevelWrapper::reset_run(void)
@@ -61,25 +154,58 @@ void IPASIRLowLevelWrapper::reset_solver(void)
 {
   DBG(cout << "[IPASIR] reset solver" << endl;);
   if (solver != nullptr) {
-    ipasir_release(solver);
+    lib.release(solver);
     max_var = 0;
-    solver = ipasir_init();
+    added_clauses = 0;
+    kept.clear();
+    solver = lib.init();
   }
   assumps.clear(); model.clear(); ucore.clear(); isvalid = false;
 }
 
+void IPASIRLowLevelWrapper::set_phase(ULINT var, LINT ph)
+{
+  warn_once("IPASIR has no phases, the phase settings are ignored");
+}
+
+void IPASIRLowLevelWrapper::set_max_conflicts(LINT mconf)
+{
+  if (lib.set_learn != nullptr) { max_confls = mconf; }
+  else if (mconf != -1) {
+    warn_once("the IPASIR library has no ipasir_set_learn(), the conflict "
+              "limits are ignored");
+  }
+}
+
 SATRes IPASIRLowLevelWrapper::solve(void)
 {
   assert(solver != nullptr && isvalid);
   DBG(cout << "[IPASIR] hitting the SAT solver (#cls = " << ncls()
            << ", #vars = " << nvars() << ", #assum = " << assumps.size()
            << ")" << endl;);
-  DBG(cout << "[pisosat] assumptions:";
+  DBG(cout << "[IPASIR] assumptions:";
       for (int a : assumps) { cout << " " << a; } cout << endl;);
-  for (int a : assumps) { ipasir_assume(solver, a); max_var = abs_max(max_var, a); }
+  for (int a : assumps) { lib.assume(solver, a); max_var = abs_max(max_var, a); }
+  // the limits: the terminate callback is always there, as interrupt() can
+  // come at any time; the learn callback is installed only when needed, as
+  // it is not free in some solvers
+  learnt = 0;
+  term_calls = 0;
+  start_call();
+  if (timeout != 0.0f) { stop_time = read_cputime() + timeout; }
+  lib.set_terminate(solver, this, terminate_cb);
+  if (lib.set_learn != nullptr) {
+    if (max_confls != -1)
+      lib.set_learn(solver, this, INT_MAX, learn_cb);
+    else if (keep_learnts)
+      lib.set_learn(solver, this, max_kept_len, learn_cb);
+    else
+      lib.set_learn(solver, nullptr, 0, nullptr);
+  }
   if (verbosity >= 10) { prt_std_cputime("c ", "Running SAT solver ..."); }
-  int status = ipasir_solve(solver);    // No limit on decisions
+  int status = lib.solve(solver);
   if (verbosity >= 10) { prt_std_cputime("c ", "Done running SAT solver ... "); }
+  if (status == 0) { return SAT_NoRes; } // terminated due to the limits
   if (status != 10 && status != 20) { return SAT_Abort; }
   if (status == 10 && need_model) { handle_sat_outcome(); }
   else if (status == 20 && need_core) { handle_unsat_outcome(); }
@@ -91,7 +217,7 @@ void IPASIRLowLevelWrapper::handle_sat_outcome(void)
   model.resize(nvars()+1);
   for(int i = 1; i < (int)nvars() + 1; ++i)
   {
-    int v = ipasir_val(solver, i);
+    int v = lib.val(solver, i);
     model[i] = v > 0 ? 1 : -1;
   }
   DBG(cout << "[IPASIR] model: ";
@@ -104,16 +230,16 @@ void IPASIRLowLevelWrapper::handle_unsat_outcome(void)
 {
   assert(ucore.size() == 0);
   for (int a : assumps)
-    if (ipasir_failed(solver, a)) { ucore.push_back(abs(a)); }
+    if (lib.failed(solver, a)) { ucore.push_back(abs(a)); }
   DBG(cout << "[IPASIR] core assumptions: ";
       for (LINT v : ucore) cout << v << " "; cout << endl;);
 }
 
 void IPASIRLowLevelWrapper::_add_clause(ULINT svar, Literator pbegin, Literator pend)
 {
-  if (svar) { ipasir_add(solver, -svar); max_var = abs_max(max_var, svar); }
-  for_each(pbegin, pend, [&](int lit) { ipasir_add(solver, lit); max_var = abs_max(max_var, lit); });
-  ipasir_add(solver, 0);
+  if (svar) { lib.add(solver, -svar); max_var = abs_max(max_var, svar); }
+  for_each(pbegin, pend, [&](int lit) { lib.add(solver, lit); max_var = abs_max(max_var, lit); });
+  lib.add(solver, 0);
   ++ added_clauses;
   DBG(cout << "[IPASIR] added " << (svar ? "" : "final ") << "clause ";
       if (svar) { cout << "[svar = " << svar << "] "; }
@@ -121,6 +247,43 @@ void IPASIRLowLevelWrapper::_add_clause(ULINT svar, Literator pbegin, Literator
       cout << "0" << endl;);
 }
 
-#endif
+/* Returns non-0 when the limits of the current call are exceeded, or the
+ * call is to stop; the CPU time is checked only every so often, as the
+ * solvers call this a lot */
+int IPASIRLowLevelWrapper::terminate_cb(void* state)
+{
+  IPASIRLowLevelWrapper* w = static_cast<IPASIRLowLevelWrapper*>(state);
+  if ((w->max_confls != -1) && (w->learnt >= w->max_confls))
+    return 1;
+  if ((w->timeout != 0.0f) && ((++w->term_calls & 0xff) == 0)
+      && (read_cputime() >= w->stop_time))
+    return 1;
+  return w->stop_requested();
+}
+
+/* Counts the learnt clauses, and keeps the short ones if asked to */
+void IPASIRLowLevelWrapper::learn_cb(void* state, int* clause)
+{
+  IPASIRLowLevelWrapper* w = static_cast<IPASIRLowLevelWrapper*>(state);
+  ++w->learnt;
+  if (!w->keep_learnts || (w->kept.size() >= max_kept_lits))
+    return;
+  int len = 0;
+  while (clause[len] && (len <= max_kept_len)) { ++len; }
+  if (len <= max_kept_len)
+    w->kept.insert(w->kept.end(), clause, clause + len + 1);
+}
+
+/* Moves the kept learnt clauses into lcls */
+void IPASIRLowLevelWrapper::get_learnts(std::vector<IntVector>& lcls)
+{
+  IntVector lits;
+  for (int lit : kept) {
+    if (lit) { lits.push_back(lit); continue; }
+    lcls.push_back(lits);
+    lits.clear();
+  }
+  kept.clear();
+}
 
 /*----------------------------------------------------------------------------*/
@@ -6,23 +6,57 @@
  *
  * Author:      nmanthey
  *
+ * Notes:
+ *      1. The solver is either linked in at build time (IPASIR_LIB), or,
+ *         in builds with dl=1 (IPASIR_DL), loaded at run-time from a shared
+ *         library (see IPASIRLib::load()).
+ *      2. IPASIR has no conflict budget; the conflict limit is approximated by
+ *         the number of learnt clauses reported by the ipasir_set_learn()
+ *         callback, and enforced, together with the CPU limit, through the
+ *         ipasir_set_terminate() callback. Libraries without ipasir_set_learn()
+ *         can only be limited in CPU time (a warning is printed).
+ *
  *                                          Copyright (c) 2017, Norbert Manthey
 \*----------------------------------------------------------------------------*/
 //jpms:ec
 
 #pragma once
 
-#ifdef IPASIR_LIB
-
 #include "solver_ll_wrapper.hh"
 
-// use IPASIR, if selected
-extern "C" {
-#include "ipasir.h"
-}
-
 class SATSolverLLFactory;
 
+//jpms:bc
+/*----------------------------------------------------------------------------*\
+ * Class: IPASIRLib
+ *
+ * Purpose: The entry points of an IPASIR solver library.
+ *
+ \*----------------------------------------------------------------------------*/
+//jpms:ec
+
+struct IPASIRLib {
+
+  const char* (*signature)(void);
+  void* (*init)(void);
+  void (*release)(void* solver);
+  void (*add)(void* solver, int lit_or_zero);
+  void (*assume)(void* solver, int lit);
+  int (*solve)(void* solver);
+  int (*val)(void* solver, int lit);
+  int (*failed)(void* solver, int lit);
+  void (*set_terminate)(void* solver, void* state, int (*terminate)(void* state));
+  void (*set_learn)(void* solver, void* state, int max_length,
+                    void (*learn)(void* state, int* clause)); // might be NULL
+
+  /** Returns the entry points of the library at path; the library is opened
+   * on the first call, and stays loaded. NULL path refers to the solver that
+   * was linked in at build time (if any). Aborts on failure.
+   */
+  static const IPASIRLib& load(const char* path);
+
+};
+
 //jpms:bc
 /*----------------------------------------------------------------------------*\
  * Class: IPASIRLowLevelWrapper
@@ -47,28 +81,27 @@ public:
 
   virtual void reset_solver(void);  // Clean up all internal data structures
 
-  virtual ULINT nvars(void) { return (ULINT) max_var; } // Picosat954::picosat_variables(solver) + 1; }
+  virtual ULINT nvars(void) { return (ULINT) max_var; }
 
-  virtual ULINT ncls(void) { return (ULINT) added_clauses; } // Picosat954::picosat_added_original_clauses(solver); }
+  virtual ULINT ncls(void) { return (ULINT) added_clauses; }
 
   // Config
 
-  void set_phase(ULINT var, LINT ph) {
-//    if (ph) { Picosat954::picosat_set_default_phase_lit(solver, var, ph); }
-  }
+  /** Not in IPASIR -- warns (once), and does nothing */
+  virtual void set_phase(ULINT var, LINT ph);
 
-  virtual void set_max_conflicts(LINT mconf) {
-    tool_abort("set_max_conflicts() is not implemented in this solver.");
-  }
+  /** Without ipasir_set_learn() in the library warns (once), and ignores
+   * the limit */
+  virtual void set_max_conflicts(LINT mconf);
 
-  virtual void set_random_seed(ULINT seed) {
-//    Picosat954::picosat_set_seed(solver, (unsigned)seed);
-  }
+  virtual void set_timeout(float to) { timeout = to; }
+
+  virtual void set_random_seed(ULINT seed) { } // not in IPASIR
 
   // Handle assumptions
 
   virtual void set_assumption(ULINT svar, LINT sval) {
-    DBG(cout<<"[picosat] set assumption: " << svar << " w/ value: " << sval << endl);
+    DBG(cout<<"[IPASIR] set assumption: " << svar << " w/ value: " << sval << endl);
     assumps.push_back(sval ? (int)svar : -(int)svar);
   }
 
@@ -82,7 +115,7 @@ public:
   // Add/remove clauses or clause sets
 
   virtual void add_clause(ULINT svar, IntVector& litvect) {
-    _add_clause(svar, litvect.begin(), litvect.end());
+    _add_clause(svar, litvect.data(), litvect.data() + litvect.size());
   }
 
   virtual void add_clause(ULINT svar, BasicClause* cl) {
@@ -91,21 +124,19 @@ public:
 
   // Additional functionality (optional)
 
-  /** Removes the specified percentage (0-100) of less active learned clauses
-   * from the underlying solver.
-   */
-  virtual void remove_learned(int pct) {
-//     Picosat954::picosat_remove_learned(solver, pct);
-  }
+  /** Not in IPASIR -- does nothing */
+  virtual void remove_learned(int pct) { }
 
-  /** If implemented, allows to clean up some of the state in the underlying
-   * solver, e.g. activity scores, stored phases, etc. This is solver-dependent.
-   */
-  virtual void cleanup_solver(void) {
-//    Picosat954::picosat_reset_phases(solver);
-//    Picosat954::picosat_reset_scores(solver);
+  /** Not in IPASIR -- does nothing */
+  virtual void cleanup_solver(void) { }
+
+  /** Keeps the short learnt clauses; needs ipasir_set_learn() in the library */
+  virtual void set_keep_learnts(bool keep) {
+    keep_learnts = keep && (lib.set_learn != nullptr);
   }
 
+  virtual void get_learnts(std::vector<IntVector>& lcls);
+
   // Raw access (optional)
 
   virtual void* get_raw_solver_ptr(void) { return solver; }
@@ -114,7 +145,7 @@ protected:
 
   // Constructor/destructor
 
-  IPASIRLowLevelWrapper(IDManager& _imgr);
+  IPASIRLowLevelWrapper(IDManager& _imgr, const IPASIRLib& _lib);
 
   virtual ~IPASIRLowLevelWrapper(void);
 
@@ -128,8 +159,16 @@ protected:
 
   void _add_clause(ULINT svar, Literator pbegin, Literator pend);
 
+  // Callbacks
+
+  static int terminate_cb(void* state);
+
+  static void learn_cb(void* state, int* clause);
+
 protected:
 
+  const IPASIRLib& lib;
+
   void* solver = nullptr;
 
   // IPASIR does not count itself
@@ -138,8 +177,22 @@ protected:
 
   std::vector<int> assumps;
 
-};
+  float timeout = 0.0f;         // CPU limit per call (0 = no limit)
+
+  double stop_time = 0.0;       // the thread CPU time to stop at
+
+  LINT learnt = 0;              // clauses learnt during this call
+
+  unsigned term_calls = 0;      // calls to terminate_cb() during this call
+
+  bool keep_learnts = false;    // if true, learn_cb() keeps short clauses
 
-#endif
+  std::vector<int> kept;        // kept learnt clauses, 0-terminated
+
+  static const int max_kept_len = 10;         // longest clause to keep
+
+  static const size_t max_kept_lits = 1 << 22; // no more clauses after that
+
+};
 
 /*----------------------------------------------------------------------------*/
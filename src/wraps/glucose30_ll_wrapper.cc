@@ -76,6 +76,9 @@ SATRes Glucose30LowLevelWrapperTmpl<S>::solve(void)
         cout << (sign(assumps[i]) ? "-" : "") << var(assumps[i]) << " ";
       cout << endl;);
   if (verbosity >= 10) { prt_std_cputime("c ", "Running SAT solver ..."); }
+  start_call();
+  solver->clearInterrupt();
+  solver->setTermCallback(watched() ? this : nullptr, watched() ? terminate_cb : nullptr);
   if (max_confls == -1)
     solver->budgetOff();
   else
@@ -163,6 +166,27 @@ void Glucose30LowLevelWrapperTmpl<S>::_add_clause(ULINT svar, Literator pbegin,
   clits.clear();
 }
 
+/* Takes out the top-level units and the short learnt clauses currently in
+ * the solver (i.e. the ones that survived the clause DB reductions) */
+template<class S>
+void Glucose30LowLevelWrapperTmpl<S>::get_learnts(std::vector<IntVector>& lcls)
+{
+  if (!keep_learnts)
+    return;
+  vec<Lit> lits;
+  solver->copyLearnts(lits, max_kept_len);
+  IntVector cl;
+  for (int i = 0; i < lits.size(); ++i) {
+    if (lits[i] != lit_Undef) {
+      cl.push_back(sign(lits[i]) ? -var(lits[i]) : var(lits[i]));
+      continue;
+    }
+    lcls.push_back(cl);
+    cl.clear();
+  }
+  DBG(cout << "[glucose30] took out " << lcls.size() << " learnt clauses" << endl;);
+}
+
 // this is to instantiate the templates -- allows to keep in the implementation
 // in .cc file; if you need another type, add it here
 template class Glucose30LowLevelWrapperTmpl<Solver>;
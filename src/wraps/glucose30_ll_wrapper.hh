@@ -58,6 +58,12 @@ public:
 
   ULINT ncls() { return (ULINT) (solver->nClauses()+solver->nLearnts()); }
 
+  ULINT nconflicts() { return (ULINT) solver->conflicts; }
+
+  ULINT ndecisions() { return (ULINT) solver->decisions; }
+
+  ULINT npropagations() { return (ULINT) solver->propagations; }
+
   // Config
 
   virtual void set_phase(ULINT var, LINT ph) {
@@ -93,7 +99,7 @@ public:
   // Add/remove clauses or clause sets
 
   virtual void add_clause(ULINT svar, IntVector& litvect) {
-    _add_clause(svar, litvect.begin(), litvect.end());
+    _add_clause(svar, litvect.data(), litvect.data() + litvect.size());
   }
 
   virtual void add_clause(ULINT svar, BasicClause* cl) {
@@ -110,6 +116,22 @@ public:
 
   virtual void unfreeze_var(ULINT var);
 
+  // Simplification (see solver_ll_wrapper.hh)
+
+  virtual bool is_simplifying(void) { return true; }
+
+  virtual void simplify(void) { solver->simplify(); }
+
+  /** The solver keeps its learnt clauses anyway; this only enables
+   * get_learnts() */
+  virtual void set_keep_learnts(bool keep) { keep_learnts = keep; }
+
+  virtual void get_learnts(std::vector<IntVector>& lcls);
+
+  // Interruption (see solver_ll_wrapper.hh)
+
+  virtual void interrupt(void) { solver->interrupt(); }
+
   // Raw access (optional)
 
   virtual void* get_raw_solver_ptr(void) { return solver; }
@@ -152,6 +174,10 @@ protected:
 
   Glucose::vec<Glucose::Lit> assumps;
 
+  bool keep_learnts = false;                    // if true, get_learnts() works
+
+  static const int max_kept_len = 10;           // longest clause to take out
+
 };
 
 /*----------------------------------------------------------------------------*\
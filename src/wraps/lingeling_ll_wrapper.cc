@@ -24,6 +24,7 @@ LingelingLowLevelWrapper::LingelingLowLevelWrapper(IDManager& _imgr) :
 {
   solver = lglinit();
   lglsetopt(solver, "simplify", 0);
+  lglseterm(solver, terminate_cb, this); // interrupt() and the limits
 }
 
 LingelingLowLevelWrapper::~LingelingLowLevelWrapper(void)
@@ -54,6 +55,7 @@ void LingelingLowLevelWrapper::reset_solver(void)
     lglrelease(solver);
     solver = lglinit();
     lglsetopt(solver, "simplify", 0);
+    lglseterm(solver, terminate_cb, this); // interrupt() and the limits
   }
   assumps.clear(); model.clear(); ucore.clear(); isvalid = false;
 }
@@ -68,11 +70,13 @@ SATRes LingelingLowLevelWrapper::solve(void)
       for (int a : assumps) { cout << " " << a; } cout << endl;);
   for (int a : assumps) { lglassume(solver, a); }
   if (verbosity >= 10) { prt_std_cputime("c ", "Running SAT solver ..."); }
+  start_call();
   int status = lglsat(solver);
   if (verbosity >= 10) {
     prt_std_cputime("c ", "Done running SAT solver ... ");
     if (verbosity >= 20) { lglstats(solver); }
   }
+  if (status == 0) { return SAT_NoRes; } // stopped (see stop_requested())
   if (status != 10 && status != 20) { return SAT_Abort; }
   if (status == 10 && need_model) { handle_sat_outcome(); }
   else if (status == 20 && need_core) { handle_unsat_outcome(); }
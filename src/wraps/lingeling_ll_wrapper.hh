@@ -47,11 +47,17 @@ public:
 
   virtual ULINT ncls(void) { return num_cls; }
 
+  virtual ULINT nconflicts(void) { return (ULINT) LingelingALA::lglgetconfs(solver); }
+
+  virtual ULINT ndecisions(void) { return (ULINT) LingelingALA::lglgetdecs(solver); }
+
+  virtual ULINT npropagations(void) { return (ULINT) LingelingALA::lglgetprops(solver); }
+
   // Config
 
   void set_phase(ULINT var, LINT ph) {
-    if ((ph == 0) || (ph == 1))
-      LingelingALA::lglsetphase(solver, ph ? var : -var);
+    if ((ph == -1) || (ph == 0) || (ph == 1))
+      LingelingALA::lglsetphase(solver, (ph > 0) ? var : -var);
     else if (ph == 3)
       LingelingALA::lglresetphase(solver, var);
   }
@@ -81,7 +87,7 @@ public:
   // Add/remove clauses or clause sets
 
   virtual void add_clause(ULINT svar, IntVector& litvect) {
-    _add_clause(svar, litvect.begin(), litvect.end());
+    _add_clause(svar, litvect.data(), litvect.data() + litvect.size());
   }
 
   virtual void add_clause(ULINT svar, BasicClause* cl) {
@@ -75,6 +75,9 @@ SATRes MinisatAbbrLowLevelWrapperTmpl<S>::solve(void) //// STOPPED HERE
         cout << (sign(assumps[i]) ? "-" : "") << var(assumps[i]) << " ";
       cout << endl;);
   if (verbosity >= 10) { prt_std_cputime("c ", "Running SAT solver ..."); }
+  start_call();
+  solver->clearInterrupt();
+  solver->setTermCallback(watched() ? this : nullptr, watched() ? terminate_cb : nullptr);
   if (max_confls == -1)
     solver->budgetOff();
   else
@@ -58,6 +58,12 @@ public:
 
   ULINT ncls() { return (ULINT) (solver->nClauses()+solver->nLearnts()); }
 
+  ULINT nconflicts() { return (ULINT) solver->conflicts; }
+
+  ULINT ndecisions() { return (ULINT) solver->decisions; }
+
+  ULINT npropagations() { return (ULINT) solver->propagations; }
+
   // Config
 
   virtual void set_phase(ULINT var, LINT ph) {
@@ -88,7 +94,7 @@ public:
   // Add/remove clauses or clause sets
 
   virtual void add_clause(ULINT svar, IntVector& litvect) {
-    _add_clause(svar, litvect.begin(), litvect.end());
+    _add_clause(svar, litvect.data(), litvect.data() + litvect.size());
   }
 
   virtual void add_clause(ULINT svar, BasicClause* cl) {
@@ -105,6 +111,16 @@ public:
 
   virtual void unfreeze_var(ULINT var);
 
+  // Simplification (see solver_ll_wrapper.hh)
+
+  virtual bool is_simplifying(void) { return true; }
+
+  virtual void simplify(void) { solver->simplify(); }
+
+  // Interruption (see solver_ll_wrapper.hh)
+
+  virtual void interrupt(void) { solver->interrupt(); }
+
   // Raw access (optional)
 
   virtual void* get_raw_solver_ptr(void) { return solver; }
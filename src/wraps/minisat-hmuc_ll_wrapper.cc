@@ -21,8 +21,7 @@ using namespace MinisatHMUC;
 MinisatHMUCLowLevelWrapper::MinisatHMUCLowLevelWrapper(IDManager& _imgr) :
   SATSolverLowLevelWrapper(_imgr)
 {
-  tool_abort("minisat-hmuc incremental wrapper is broken (assumptions are not supported in the solver)");
-  solver = new SimpSolver();
+  _new_solver();
 }
 
 MinisatHMUCLowLevelWrapper::~MinisatHMUCLowLevelWrapper(void)
@@ -50,16 +49,18 @@ void MinisatHMUCLowLevelWrapper::reset_solver(void)
   DBG(cout << "[minisat-hmuc] reset solver" << endl;);
   if (solver != nullptr) {
     delete solver;
-    solver = new SimpSolver();
+    _new_solver();
     solver->verbosity = (verbosity > 5) ? 5 : 0;
     solver->rnd_pol = (phase == 0);
   }
   assumps.clear(); model.clear(); ucore.clear(); isvalid = false;
 }
 
-SATRes MinisatHMUCLowLevelWrapper::solve(void) //// STOPPED HERE
+SATRes MinisatHMUCLowLevelWrapper::solve(void)
 {
   assert(solver != nullptr && isvalid);
+  if (assumps.size())
+    tool_abort("minisat-hmuc does not support assumptions, use removable clauses instead");
   DBG(cout << "[minisat-hmuc] hitting the SAT solver (#cls = "
            << solver->nClauses() << ", #vars = " << solver->nVars()
            << ", #assum = " << assumps.size() << ")" << endl;);
@@ -68,6 +69,9 @@ SATRes MinisatHMUCLowLevelWrapper::solve(void) //// STOPPED HERE
         cout << (sign(assumps[i]) ? "-" : "") << var(assumps[i]) << " ";
       cout << endl;);
   if (verbosity >= 10) { prt_std_cputime("c ", "Running SAT solver ..."); }
+  start_call();
+  solver->clearInterrupt();
+  solver->setTermCallback(watched() ? this : nullptr, watched() ? terminate_cb : nullptr);
   if (max_confls == -1)
     solver->budgetOff();
   else
@@ -95,20 +99,15 @@ void MinisatHMUCLowLevelWrapper::handle_sat_outcome(void)
 void MinisatHMUCLowLevelWrapper::handle_unsat_outcome(void)
 {
   assert(ucore.size() == 0);
-  for(int i = 0; i < solver->conflict.size(); ++i)
-    ucore.push_back(var(solver->conflict[i]));
-  DBG(cout << "[minisat-hmuc] core assumptions: ";
-      for (ULINT v : ucore) cout << v << " "; cout << endl;);
-}
-
-// Preprocessing
-SATRes MinisatHMUCLowLevelWrapper::preprocess(bool turn_off)
-{
-  tool_warn("preprocessing in minisat-hmuc has not been tested");
-  bool res = true;
-  solver->verbosity = (verbosity > 5) ? 5 : 0; // b/c preprocess can be called before the rest
-  res =solver->eliminate(turn_off);   // true is to turn-off elimination after
-  return (!res) ? SAT_False : SAT_NoRes;
+  // if the final clauses are inconsistent by themselves, the solver has no
+  // (fresh) core to give
+  if (!solver->okay())
+    return;
+  solver->GetUnsatCore(cone);
+  for(int i = 0; i < cone.size(); ++i)
+    ucore.push_back(cone[i]);
+  DBG(cout << "[minisat-hmuc] core clause ids: ";
+      for (LINT cid : ucore) cout << cid << " "; cout << endl;);
 }
 
 void MinisatHMUCLowLevelWrapper::_add_clause(ULINT svar, Literator pbegin, Literator pend)
@@ -118,7 +117,6 @@ void MinisatHMUCLowLevelWrapper::_add_clause(ULINT svar, Literator pbegin, Liter
   if (svar) {
     update_maxvid(svar);
     clits.push(MinisatHMUC::mkLit(svar, true));
-    solver->setFrozen(svar, true);
   }
   for_each(pbegin, pend, [&](LINT lit) {
     update_maxvid(std::llabs(lit));
@@ -133,4 +131,44 @@ void MinisatHMUCLowLevelWrapper::_add_clause(ULINT svar, Literator pbegin, Liter
   clits.clear();
 }
 
+/* Note: the solver adds the clause only if it is neither satisfied nor
+ * falsified at the top-level (the latter would make it inconsistent for
+ * good); the uid counter of the solver tells if the clause got in.
+ */
+LINT MinisatHMUCLowLevelWrapper::add_removable_clause(IntVector& lits)
+{
+  assert(solver != nullptr);
+  assert(clits.size() == 0);
+  bool falsified = true;
+  for (LINT lit : lits) {
+    update_maxvid(std::llabs(lit));
+    Lit l = MinisatHMUC::mkLit(std::llabs(lit), lit<0);
+    if (solver->value(l) != l_False) { falsified = false; }
+    clits.push(l);
+  }
+  LINT cid = cid_False;
+  if (!falsified) {
+    // the clause is original, i.e. not derived from the ones in the last core
+    uint32_t last_uid = solver->GetLastUid();
+    solver->addClause_(clits, true, &no_parents);
+    cid = (solver->GetLastUid() != last_uid) ? (LINT)solver->GetLastUid() : cid_Sat;
+  }
+  DBG(cout << "[minisat-hmuc] added removable clause [cid = " << cid << "] ";
+      for(int i = 0; i < clits.size(); ++i)
+        cout << (sign(clits[i]) ? "-" : "") << var(clits[i]) << " ";
+      cout << "0" << endl;);
+  clits.clear();
+  return cid;
+}
+
+/* Note: the solver never gets to eliminate variables, as this is not sound for
+ * the removable clauses; the clauses are bound back as they were.
+ */
+void MinisatHMUCLowLevelWrapper::_new_solver(void)
+{
+  solver = new SimpSolver();
+  solver->eliminate(true);
+  solver->bind_as_orig = 0;
+}
+
 /*----------------------------------------------------------------------------*/
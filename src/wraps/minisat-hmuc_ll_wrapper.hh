@@ -27,6 +27,13 @@ class SATSolverLLFactory;
  *
  * Purpose: Provides low-level incremental interface to Minisat-HMUC.
  *
+ * Notes:
+ *      1. The solver does not support assumptions; instead, it knows to
+ *         disable and remove "interesting" clauses, together with the clauses
+ *         derived from them, using its resolution graph. Hence, the removable
+ *         clauses should be added with add_removable_clause(), and the group
+ *         wrapper on top of this should be SATSolverWrapperGrpNative.
+ *
  \*----------------------------------------------------------------------------*/
 //jpms:ec
 
@@ -49,6 +56,12 @@ public:
 
   ULINT ncls() { return (ULINT) (solver->nClauses()+solver->nLearnts()); }
 
+  ULINT nconflicts() { return (ULINT) solver->conflicts; }
+
+  ULINT ndecisions() { return (ULINT) solver->decisions; }
+
+  ULINT npropagations() { return (ULINT) solver->propagations; }
+
   // Config
 
   virtual void set_phase(ULINT var, LINT ph) {
@@ -79,22 +92,37 @@ public:
   // Add/remove clauses or clause sets
 
   virtual void add_clause(ULINT svar, IntVector& litvect) {
-    _add_clause(svar, litvect.begin(), litvect.end());
+    _add_clause(svar, litvect.data(), litvect.data() + litvect.size());
   }
 
   virtual void add_clause(ULINT svar, BasicClause* cl) {
     _add_clause(svar, cl->begin(), cl->end());
   }
 
-  // Preprocessing -- please read the comments in solver_ll_wrapper.hh !
+  // Native clause removal -- please read the comments in solver_ll_wrapper.hh !
 
-  virtual bool is_preprocessing(void) { return true; }
+  virtual bool is_deleting(void) { return true; }
 
-  virtual SATRes preprocess(bool turn_off = false);
+  virtual LINT add_removable_clause(IntVector& clits);
 
-  virtual void freeze_var(ULINT var) { solver->setFrozen(var, true); }
+  virtual void unbind_clauses(const IntVector& cids) {
+    _set_cone(cids);
+    solver->UnbindClauses(cone);
+  }
+
+  virtual void bind_clauses(const IntVector& cids) {
+    _set_cone(cids);
+    solver->BindClauses(cone);
+  }
 
-  virtual void unfreeze_var(ULINT var) { solver->setFrozen(var, false); }
+  virtual void remove_clauses(const IntVector& cids) {
+    _set_cone(cids);
+    solver->RemoveClauses(cone);
+  }
+
+  // Interruption (see solver_ll_wrapper.hh)
+
+  virtual void interrupt(void) { solver->interrupt(); }
 
   // Raw access (optional)
 
@@ -127,6 +155,13 @@ protected:
 
   void _add_clause(ULINT svar, Literator pbegin, Literator pend);
 
+  void _set_cone(const IntVector& cids) {
+    cone.clear();
+    for (LINT cid : cids) { cone.push((uint32_t)cid); }
+  }
+
+  void _new_solver(void);
+
 protected:
 
   MinisatHMUC::SimpSolver* solver = nullptr;
@@ -135,6 +170,10 @@ protected:
 
   MinisatHMUC::vec<MinisatHMUC::Lit> assumps;
 
+  MinisatHMUC::vec<uint32_t> cone;  // uids of clauses to (un)bind or remove
+
+  MinisatHMUC::vec<uint32_t> no_parents;  // (always empty)
+
 };
 
 /*----------------------------------------------------------------------------*/
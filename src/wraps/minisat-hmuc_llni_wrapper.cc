@@ -33,8 +33,8 @@ MinisatHMUCLowLevelNonIncrWrapper::~MinisatHMUCLowLevelNonIncrWrapper(void)
 void MinisatHMUCLowLevelNonIncrWrapper::init_solver(void)
 {
   assert(solver == nullptr && !inited);
-  Clause::SetUid(1);
   solver = new SimpSolver();
+  solver->SetUid(1);
   uid2cl.clear();
   inited = true;
   ready = false;
@@ -137,7 +137,7 @@ int MinisatHMUCLowLevelNonIncrWrapper::_add_clause(Literator pbegin, Literator p
     while(var >= (ULINT)solver->nVars()) { solver->newVar((bool)(phase == -1), true); }
     clits.push(MinisatHMUC::mkLit(var, lit<0)); });
   solver->addClause(clits, true);
-  uint32_t uid = Clause::GetLastUid();
+  uint32_t uid = solver->GetLastUid();
   if (!solver->okay()) {
     solver->CreateResolVertex(uid);
     solver->AddConflictingIc(uid);
@@ -74,7 +74,7 @@ public:
 
   virtual void add_clause(BasicClause* cl) { _add_clause(cl); }
 
-  virtual void add_clause(IntVector& clits) { _add_clause(clits.begin(), clits.end()); }
+  virtual void add_clause(IntVector& clits) { _add_clause(clits.data(), clits.data() + clits.size()); }
 
   virtual void add_clauses(BasicClauseSet& rclset) {
     for (BasicClause* cl : rclset) { _add_clause(cl); }
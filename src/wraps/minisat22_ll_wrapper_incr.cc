@@ -81,6 +81,9 @@ SATRes Minisat22LowLevelWrapperTmpl<S>::solve()
 
   // 1. Invoke SAT solver
   if (verbosity >= 20) { prt_std_cputime("c ", "Running SAT solver ..."); }
+  start_call();
+  solver->clearInterrupt();
+  solver->setTermCallback(watched() ? this : nullptr, watched() ? terminate_cb : nullptr);
   if (max_confls == -1)
     solver->budgetOff();
   else
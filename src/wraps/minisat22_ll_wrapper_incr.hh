@@ -57,6 +57,12 @@ public:
 
   ULINT ncls() { return (ULINT) (solver->nClauses()+solver->nLearnts()); }
 
+  ULINT nconflicts() { return (ULINT) solver->conflicts; }
+
+  ULINT ndecisions() { return (ULINT) solver->decisions; }
+
+  ULINT npropagations() { return (ULINT) solver->propagations; }
+
 
   // Config
 
@@ -197,6 +203,12 @@ public:
 
   void get_solver_clauses(BasicClauseSet& cset);
 
+  // Simplification (see solver_ll_wrapper.hh)
+
+  virtual bool is_simplifying(void) { return true; }
+
+  virtual void simplify(void) { static_cast<Minisat::Solver*>(solver)->simplify(); }
+
   // Printing/stats
 
   void print_cnf(const char* fname);
@@ -209,6 +221,10 @@ public:
     return (var < (ULINT)solver->nVars()) ? solver->varActivity(var) : -1;
   }
 
+  // Interruption (see solver_ll_wrapper.hh)
+
+  virtual void interrupt(void) { solver->interrupt(); }
+
   // Direct access (see comments in the parent)
 
   virtual void* get_raw_solver_ptr(void) { return solver; }
@@ -66,8 +66,11 @@ SATRes PicosatLowLevelWrapper::solve(void)
       for (int a : assumps) { cout << " " << a; } cout << endl;);
   for (int a : assumps) { Picosat954::picosat_assume(solver, a); }
   if (verbosity >= 10) { prt_std_cputime("c ", "Running SAT solver ..."); }
+  start_call();
+  Picosat954::picosat_set_interrupt(solver, this, terminate_cb); // interrupt() and the limits
   int status = Picosat954::picosat_sat(solver, -1);    // No limit on decisions
   if (verbosity >= 10) { prt_std_cputime("c ", "Done running SAT solver ... "); }
+  if (status == 0) { return SAT_NoRes; } // stopped (see stop_requested())
   if (status != 10 && status != 20) { return SAT_Abort; }
   if (status == 10 && need_model) { handle_sat_outcome(); }
   else if (status == 20 && need_core) { handle_unsat_outcome(); }
@@ -45,6 +45,10 @@ public:
 
   virtual ULINT ncls(void) { return (ULINT) Picosat954::picosat_added_original_clauses(solver); }
 
+  virtual ULINT ndecisions(void) { return (ULINT) Picosat954::picosat_decisions(solver); }
+
+  virtual ULINT npropagations(void) { return (ULINT) Picosat954::picosat_propagations(solver); }
+
   // Config
 
   void set_phase(ULINT var, LINT ph) {
@@ -76,7 +80,7 @@ public:
   // Add/remove clauses or clause sets
 
   virtual void add_clause(ULINT svar, IntVector& litvect) {
-    _add_clause(svar, litvect.begin(), litvect.end());
+    _add_clause(svar, litvect.data(), litvect.data() + litvect.size());
   }
 
   virtual void add_clause(ULINT svar, BasicClause* cl) {
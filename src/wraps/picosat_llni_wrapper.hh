@@ -76,7 +76,7 @@ public:
     _add_clause(cl, &skip_lit);
   }
 
-  virtual void add_clause(IntVector& clits) { _add_clause(clits.begin(), clits.end()); }
+  virtual void add_clause(IntVector& clits) { _add_clause(clits.data(), clits.data() + clits.size()); }
 
   virtual void add_clauses(BasicClauseSet& rclset) {
     for (BasicClause* cl : rclset) { _add_clause(cl); }
@@ -15,6 +15,8 @@
 
 #include "id_manager.hh"
 
+class SATSolverStop;
+
 //jpms:bc
 /*----------------------------------------------------------------------------*\
  * Typedefs.
@@ -56,6 +58,30 @@ public:
 
   virtual bool get_sls_mode(void) { return false; }
 
+  /** The path to the IPASIR library to load for the "ipasir" solver; NULL
+   * means the one linked in at build time */
+  virtual const char* get_ipasir_lib(void) { return NULL; }
+
+  /** The fraction of groups whose deletion makes the clause database of the
+   * solver due for compaction (0 = never) */
+  virtual float get_compact_ratio(void) { return 0; }
+
+  /** If true, the solver is compacted by rebuilding it from the remaining
+   * groups, even if it can remove the satisfied clauses itself */
+  virtual bool get_compact_rebuild(void) { return false; }
+
+  /** If true, the solver keeps its learnt clauses so that they can be given
+   * to other solvers */
+  virtual bool get_share_learnts(void) { return false; }
+
+  /** The comma-separated list of the solvers to race against each other on
+   * each call (incremental mode only); NULL means a single solver */
+  virtual const char* get_portfolio(void) { return NULL; }
+
+  /** The stop that the solvers should watch (see SATSolverStop); NULL means
+   * that they only stop when interrupted */
+  virtual const SATSolverStop* get_stop(void) { return NULL; }
+
 };
 
 #endif /* _SOLVER_CONFIG_H */
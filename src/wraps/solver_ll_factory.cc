@@ -18,10 +18,7 @@
 #include "minisat-gh_ll_wrapper.hh"
 #include "glucose30_ll_wrapper.hh"
 #include "lingeling_ll_wrapper.hh"
-
-#ifdef IPASIR_LIB // use only if we currently compile against IPASIR
 #include "IPASIR_ll_wrapper.hh"
-#endif
 
 /** Implementation of the factory method */
 SATSolverLowLevelWrapper* SATSolverLLFactory::instance_ptr(SATSolverConfig& config) 
@@ -50,15 +47,15 @@ SATSolverLowLevelWrapper* SATSolverLLFactory::instance_ptr(SATSolverConfig& conf
     solver = (SATSolverLowLevelWrapper*) new Glucose30sLowLevelWrapper(imgr);
   } else if (config.chk_sat_solver("lingeling")) {
     solver = (SATSolverLowLevelWrapper*) new LingelingLowLevelWrapper(imgr);
-#ifdef IPASIR_LIB
   } else if (config.chk_sat_solver("ipasir")) {
-    solver = (SATSolverLowLevelWrapper*) new IPASIRLowLevelWrapper(imgr);
-#endif
+    solver = (SATSolverLowLevelWrapper*)
+      new IPASIRLowLevelWrapper(imgr, IPASIRLib::load(config.get_ipasir_lib()));
   } else {
     tool_abort("Invalid SAT solver selection in factory: unsupported solver");
   }
   assert(solver != NULL);
   solver->set_verbosity(config.get_verbosity());
+  solver->set_stop(config.get_stop());
   return solver;
 }
 
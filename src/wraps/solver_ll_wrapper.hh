@@ -19,6 +19,7 @@
 #include "id_manager.hh"
 #include "basic_clset.hh"
 #include "solver_utils.hh"
+#include "solver_stop.hh"
 
 using namespace SolverUtils;
 
@@ -52,6 +53,14 @@ public:
 
   virtual ULINT ncls() = 0;
 
+  // Statistics (optional; cumulative over all calls, 0 if not supported)
+
+  virtual ULINT nconflicts() { return 0; }
+
+  virtual ULINT ndecisions() { return 0; }
+
+  virtual ULINT npropagations() { return 0; }
+
   // Config
 
   void set_verbosity(int verb) { verbosity = verb; }
@@ -75,6 +84,14 @@ public:
    */
   virtual void set_max_conflicts(LINT mconf) { max_confls = mconf; }
 
+  /** Sets the CPU time limit per call in seconds (might be not supported);
+   * 0 = no limit; note that this affects completeness (SAT_NoRes might be
+   * returned)
+   */
+  virtual void set_timeout(float to) {
+    throw std::logic_error("method is not implemented");
+  }
+
   /** If the solver supports this, sets the output stream to be used for writing
    * out the proof trace in case of UNSAT outcome at the end of solve(); it
    * is up to called to open/close the stream; 0 disables writing
@@ -165,6 +182,28 @@ public:
     add_final_clause(lits);
   }
 
+  // Interruption and wall-clock limits (optional)
+
+  /** Asks the solve() that is running in another thread to stop as soon as
+   * it can, in which case it returns SAT_NoRes (or SAT_Abort); solvers that do
+   * not know how finish the call. A request that comes in after the call is
+   * over is dropped at the start of the next one, so the caller should repeat
+   * it until the call returns.
+   */
+  virtual void interrupt(void) { stop = true; }
+
+  /** Sets the wall-clock time limit per call in seconds (might be not
+   * supported); 0 = no limit; note that this affects completeness (SAT_NoRes
+   * might be returned)
+   */
+  void set_wc_timeout(float to) { wc_timeout = to; }
+
+  /** Makes the solver watch the given stop (might be not supported): once it
+   * is raised, or its deadline has passed, the calls return SAT_NoRes as soon
+   * as they can; NULL = none. Unlike interrupt(), this stays until cleared.
+   */
+  void set_stop(const SATSolverStop* pstop) { gstop = pstop; }
+
   // Preprocessing (optional)
 
   /** Returns true if this solver knows to do preprocessing; if this is overriden,
@@ -204,12 +243,69 @@ public:
 
   // Additional functionality (optional)
 
+  /** Returns true if this solver knows to simplify(); if this is overriden,
+   * then simplify() should be implemented.
+   */
+  virtual bool is_simplifying(void) { return false; }
+
   /** Simplifies the instance, e.g. by removing already satisfied clauses
    */
   virtual void simplify(void) {
     tool_abort("simplify() is not implemented for this solver.");
   }
 
+  /** If implemented, makes the solver keep (some of) the clauses it learns,
+   * so that they can be taken out with get_learnts().
+   */
+  virtual void set_keep_learnts(bool keep) { }
+
+  /** Moves the learnt clauses kept since the last call (see set_keep_learnts())
+   * into lcls; solvers that do not keep them leave lcls alone.
+   */
+  virtual void get_learnts(std::vector<IntVector>& lcls) { }
+
+  // Native clause removal (optional)
+
+  /** Returns values of add_removable_clause() that are not clause ids */
+  enum : LINT { cid_Sat = -1, cid_False = -2 };
+
+  /** Returns true if this solver knows to disable and remove clauses without
+   * selector variables; if this is overriden, then the methods below should
+   * be implemented, and the core after an UNSAT outcome is in terms of the
+   * ids of the removable clauses (not assumption variables).
+   */
+  virtual bool is_deleting(void) { return false; }
+
+  /** Adds a clause that can be disabled or removed later on, and returns its
+   * id (>= 0); cid_Sat means that the clause is satisfied at the top-level and
+   * so was not added, cid_False means that it is falsified at the top-level
+   * and so was not added either -- this is up to the caller to handle.
+   */
+  virtual LINT add_removable_clause(IntVector& clits) {
+    tool_abort("add_removable_clause() is not implemented for this solver.");
+    return cid_Sat;
+  }
+
+  /** Temporarily disables the removable clauses with the given ids (together
+   * with whatever the solver has learnt from them)
+   */
+  virtual void unbind_clauses(const IntVector& cids) {
+    tool_abort("unbind_clauses() is not implemented for this solver.");
+  }
+
+  /** Re-enables the removable clauses disabled by unbind_clauses()
+   */
+  virtual void bind_clauses(const IntVector& cids) {
+    tool_abort("bind_clauses() is not implemented for this solver.");
+  }
+
+  /** Removes the removable clauses with the given ids for good (together with
+   * whatever the solver has learnt from them)
+   */
+  virtual void remove_clauses(const IntVector& cids) {
+    tool_abort("remove_clauses() is not implemented for this solver.");
+  }
+
   /** Adds to cset the clauses that are actually inside the underlying
    * SAT solver -- useful for getting the preprocessed instances back.
    */
@@ -258,6 +354,43 @@ protected:
 
   virtual ~SATSolverLowLevelWrapper() { }
 
+protected:
+
+  // Interruption and wall-clock limits -- for the wrappers that support them
+
+  /** To be called at the start of solve(): drops the interrupts from before,
+   * and works out the deadline of the call */
+  void start_call(void) {
+    stop = false;
+    nchecks = 0;
+    wc_deadline = (wc_timeout != 0.0f) ? SATSolverStop::now() + wc_timeout : 0;
+  }
+
+  /** True if the stop of the call has to be watched for, i.e. there is more
+   * to it than interrupt() */
+  bool watched(void) const { return (wc_deadline != 0) || (gstop != nullptr); }
+
+  /** True if the current call has to stop; the clock is read only every so
+   * often, as the solvers ask a lot, and so once true, this stays true until
+   * the end of the call (the solvers may ask again) */
+  bool stop_requested(void) {
+    if (stop || ((gstop != nullptr) && gstop->raised()))
+      return true;
+    if ((++nchecks & 0xff) || !watched())
+      return false;
+    double now = SATSolverStop::now();
+    if (((wc_deadline != 0) && (now >= wc_deadline))
+        || ((gstop != nullptr) && (gstop->deadline() != 0) && (now >= gstop->deadline())))
+      stop = true;
+    return stop;
+  }
+
+  /** C-style callback (as taken by the solvers) for stop_requested();
+   * state is the wrapper */
+  static int terminate_cb(void* state) {
+    return static_cast<SATSolverLowLevelWrapper*>(state)->stop_requested();
+  }
+
 
 protected:
 
@@ -278,6 +411,16 @@ protected:
   bool need_model;             // if false, do not fetch the model
 
   bool need_core;              // if false, do not fetch the core
+
+  std::atomic<bool> stop { false }; // set by interrupt(), cleared by start_call()
+
+  float wc_timeout = 0.0f;     // wall-clock limit per call (0 = no limit)
+
+  double wc_deadline = 0;      // deadline of the current call (0 = none)
+
+  const SATSolverStop* gstop = nullptr; // the stop to watch (if any)
+
+  unsigned nchecks = 0;        // calls of stop_requested() in the current call
 };
 
 #endif /* _SOLVER_LL_WRAPPER_H */
@@ -0,0 +1,73 @@
+//jpms:bc
+/*----------------------------------------------------------------------------*\
+ * File:        solver_stop.hh
+ *
+ * Description: A cooperative stop request shared by SAT solver wrappers.
+ *
+ * Author:      agent
+ *
+ * Notes:
+ *      1. The flag can be raised from any thread (and from signal handlers);
+ *         the solvers that watch the stop (see
+ *         SATSolverLowLevelWrapper::set_stop()) notice it in the middle of
+ *         their calls, and return SAT_NoRes.
+ *      2. The deadline is wall-clock, and should be set before the solvers
+ *         are started.
+ *
+ *                                                    Copyright (c) 2026, agent
+\*----------------------------------------------------------------------------*/
+//jpms:ec
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+//jpms:bc
+/*----------------------------------------------------------------------------*\
+ * Class: SATSolverStop
+ *
+ * Purpose: A stop flag with an optional wall-clock deadline.
+ *
+\*----------------------------------------------------------------------------*/
+//jpms:ec
+
+class SATSolverStop {
+
+public:
+
+  /* Asks everyone who watches this to stop as soon as they can */
+  void raise(void) { _raised = true; }
+
+  /* True if raise() has been called since the last clear() */
+  bool raised(void) const { return _raised; }
+
+  /* Sets the deadline to secs seconds from now; 0 = no deadline */
+  void set_deadline(double secs) { _deadline = (secs > 0) ? now() + secs : 0; }
+
+  /* The deadline, in terms of now(); 0 = no deadline */
+  double deadline(void) const { return _deadline; }
+
+  /* True if the flag is raised, or the deadline has passed */
+  bool reached(void) const {
+    return _raised || ((_deadline != 0) && (now() >= _deadline));
+  }
+
+  /* Lowers the flag and removes the deadline */
+  void clear(void) { _raised = false; _deadline = 0; }
+
+  /* Wall-clock time in seconds, from some fixed point in the past */
+  static double now(void) {
+    return std::chrono::duration<double>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+protected:
+
+  std::atomic<bool> _raised { false };  // the flag
+
+  double _deadline = 0;                 // the deadline (0 = none)
+
+};
+
+/*----------------------------------------------------------------------------*/
@@ -103,7 +103,7 @@ public: // Manipulate local copy of clause set
    */
   virtual void add_clause(const IntVector& lits, XLINT weight) {
     ensure_state(INITIALIZED);
-    _add_clause(lits.begin(), lits.end(), (weighted) ? weight : 1, 0);
+    _add_clause(lits.data(), lits.data() + lits.size(), (weighted) ? weight : 1, 0);
   }
 
   /** Adds all clauses from the clause set. If the solver is weighted the weight